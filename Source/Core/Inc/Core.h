@@ -86,6 +86,8 @@ class FUnknown;
 class FRepLink;
 class FConfigFile;
 class FConfigCache;
+class FJobManager;
+class FProfiler;
 
 /*----------------------------------------------------------------------------
 	Global variables.
@@ -102,6 +104,15 @@ CORE_API extern FExec*					GExecHook;
 CORE_API extern USystem*				GSys;
 CORE_API extern UProperty*				GProperty;
 CORE_API extern DWORD*					GBoolAddr;
+
+// One property whose script assignments are reported: after UObject::execLet
+// assigns to GLetWatchProperty, it calls GLetWatchHook with the variable's
+// address.  The engine uses this to keep its actor tag index up to date.
+// Native code writing the property isn't reported.  Set the hook before the
+// property, since execLet only compares the property.
+CORE_API extern UProperty*				GLetWatchProperty;
+CORE_API extern void					(*GLetWatchHook)( BYTE* Var );
+
 CORE_API extern char				    GErrorHist[4096];
 CORE_API extern char                    GComputerName[32];
 CORE_API extern	DOUBLE					GSecondsPerCycle;
@@ -123,6 +134,8 @@ CORE_API extern UBOOL					GIsStrict;
 CORE_API extern UBOOL					GScriptEntryTag;
 CORE_API extern UBOOL					GNoAutoReplace;
 CORE_API extern FConfigCache	GConfigCache;
+CORE_API extern FJobManager		GJobs;
+CORE_API extern FProfiler		GProfiler;
 
 // Per module globals.
 #ifdef UNREAL_STATIC
@@ -153,6 +166,8 @@ extern "C" DLL_EXPORT char THIS_PACKAGE[];
 #include "UnCId.h"			// Cache ID's.
 #include "UnConfig.h"		// Config cache.
 #include "UnThread.h"		// Multithreading.
+#include "UnJobs.h"			// Job system.
+#include "UnProfile.h"		// Zone profiler.
 #include "UnStaticExports.h"	// Package exports for static builds.
 
 /*-----------------------------------------------------------------------------
@@ -243,6 +243,11 @@ char* appUnixPath( const char* Path );
 //
 CORE_API DWORD appCycles();
 
+//
+// 64-bit monotonic CPU cycles, related to GSecondsPerCycle.
+//
+CORE_API QWORD appCycles64();
+
 //
 // Seconds, arbitrarily based.
 //
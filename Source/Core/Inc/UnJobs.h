@@ -0,0 +1,123 @@
+/*=============================================================================
+	UnJobs.h: Work-stealing job system.
+	Copyright 1997 Epic MegaGames, Inc. This software is a trade secret.
+=============================================================================*/
+
+/*-----------------------------------------------------------------------------
+	Jobs.
+-----------------------------------------------------------------------------*/
+
+// Job entry points.
+typedef void (*JOB_FUNC)( void* Arg );
+typedef void (*JOB_RANGE_FUNC)( void* Arg, INT Start, INT End );
+
+//
+// Tracks completion of a group of jobs.  Launching a job against a counter
+// increments it, and finishing the job decrements it.  Other jobs may be
+// launched with a counter as their prerequisite, in which case they don't
+// start until it drops to zero.
+//
+class CORE_API FJobCounter
+{
+public:
+	FJobCounter()
+	:	Count		( 0 )
+	,	FirstWaiting( NULL )
+	{}
+	~FJobCounter()
+	{
+		check(Count==0);
+	}
+	UBOOL IsDone() const
+	{
+		return Count==0;
+	}
+private:
+	friend class FJobManager;
+	volatile INT Count;
+	struct FWaitingJob* FirstWaiting;
+};
+
+//
+// A job waiting in a queue.
+//
+struct FJob
+{
+	JOB_FUNC		Func;
+	void*			Arg;
+	FJobCounter*	Counter;
+};
+
+/*-----------------------------------------------------------------------------
+	FJobManager.
+-----------------------------------------------------------------------------*/
+
+//
+// Worker pool with one job queue per thread.  Each thread pushes and pops
+// its own jobs at the back of its queue, and idle threads steal the oldest
+// jobs from the front of other threads' queues.  Threads waiting for jobs
+// to finish run queued jobs in the meantime instead of blocking.
+//
+// With no workers (single CPU machines, or -JOBS=0), jobs run immediately
+// on the calling thread, so callers never need a serial fallback.
+//
+class CORE_API FJobManager
+{
+public:
+	// Constants.
+	enum {MAX_JOB_THREADS=16};
+
+	// Constructor.
+	FJobManager();
+
+	// FJobManager interface.
+	void Init( INT InNumWorkers );
+	void Exit();
+	UBOOL Exec( const char* Cmd, FOutputDevice* Out=GSystem );
+	void Launch( JOB_FUNC Func, void* Arg, FJobCounter* Counter=NULL, FJobCounter* Prerequisite=NULL );
+	void Wait( FJobCounter& Counter );
+	void ParallelFor( INT Num, JOB_RANGE_FUNC Func, void* Arg, INT MinBatch=1 );
+	INT NumWorkers() const {return NumThreads-1;}
+	INT GetThreadIndex() const;
+
+private:
+	// Per-thread job queue, a growable ring buffer.
+	struct FJobQueue
+	{
+		UMUTEX	Mutex;
+		FJob*	Jobs;
+		INT		Head, Num, Max;
+		INT		NumRun, NumStolen;
+		DOUBLE	BusySeconds;
+		BYTE	Pad[CACHE_LINE_SIZE];
+	};
+
+	// Variables.
+	FJobQueue	Queues[MAX_JOB_THREADS];
+	UTHREAD		Threads[MAX_JOB_THREADS];
+	INT			NumThreads;
+	USEMAPHORE	WorkAvailable;
+	UMUTEX		WaitingMutex;
+	volatile INT NumSleeping;
+	volatile INT bShutdown;
+	DOUBLE		StatsStartTime;
+
+	// Internal functions.
+	void Push( INT iThread, const FJob& Job );
+	UBOOL Pop( INT iThread, FJob& Job, UBOOL bLocked=0 );
+	UBOOL Steal( INT iThread, FJob& Job, UBOOL bLocked=0 );
+	UBOOL FindJob( INT iThread, FJob& Job, UBOOL bLocked=0 );
+	void Execute( INT iThread, const FJob& Job );
+	void Finish( FJobCounter* Counter );
+	void ResetStats();
+	void Bench( FOutputDevice* Out );
+	static THREAD_RET
+#ifdef PLATFORM_WIN32
+		__stdcall
+#endif
+		WorkerMain( void* Arg );
+};
+
+/*-----------------------------------------------------------------------------
+	The End.
+-----------------------------------------------------------------------------*/
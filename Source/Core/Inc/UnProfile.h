@@ -0,0 +1,123 @@
+/*=============================================================================
+	UnProfile.h: Scoped zone profiler with trace capture.
+	Copyright 1997 Epic MegaGames, Inc. This software is a trade secret.
+=============================================================================*/
+
+/*-----------------------------------------------------------------------------
+	FProfileEvent.
+-----------------------------------------------------------------------------*/
+
+//
+// One completed zone in a capture.  Times are in appCycles64 units.
+//
+struct FProfileEvent
+{
+	const char*	Name;		// Zone name, a string literal.
+	QWORD		Start;		// Start time.
+	QWORD		Inclusive;	// Duration including nested zones.
+	QWORD		Exclusive;	// Duration excluding nested zones.
+	INT			Thread;		// Capture thread slot.
+	INT			Depth;		// Nesting depth within the thread.
+};
+
+/*-----------------------------------------------------------------------------
+	FProfiler.
+-----------------------------------------------------------------------------*/
+
+//
+// Records nested timing zones from any thread into a fixed event buffer
+// while a capture is running, and writes the capture out in the Chrome
+// trace event format (chrome://tracing, Perfetto).
+//
+// Captures start and stop on frame boundaries, which the game marks by
+// calling Tick() at the top of each frame.  Outside of a capture, a zone
+// costs one test of a global flag.
+//
+class CORE_API FProfiler
+{
+public:
+	// Constants.
+	enum {MAX_PROFILE_THREADS = 32     };
+	enum {MAX_PROFILE_DEPTH   = 32     };
+	enum {DEFAULT_EVENTS      = 65536  };
+
+	// Constructor.
+	FProfiler();
+
+	// FProfiler interface.
+	UBOOL Exec( const char* Cmd, FOutputDevice* Out=GSystem );
+	void Tick();
+	void Exit();
+	void StartCapture( INT InFrames=0, const char* InFilename=NULL, INT InMaxEvents=DEFAULT_EVENTS );
+	void StopCapture();
+	UBOOL IsCapturing() const {return bCapturing;}
+
+	// Zone recording, used by FProfileZone.
+	INT BeginZone( QWORD& Start );
+	void EndZone( const char* Name, QWORD Start, INT Depth );
+
+	// Variables.
+	volatile INT bCapturing;
+
+private:
+	// Variables.
+	FProfileEvent*	Events;
+	INT				MaxEvents;
+	volatile INT	NumEvents;
+	volatile INT	NumThreads;
+	INT				CaptureId;
+	INT				Frames;
+	INT				NumFrames;
+	QWORD			CaptureStart;
+	UBOOL			bPendingStart;
+	UBOOL			bPendingStop;
+	INT				PendingFrames;
+	INT				PendingEvents;
+	char			Filename[256];
+	char			ThreadNames[MAX_PROFILE_THREADS][32];
+
+	// Internal functions.
+	void Begin();
+	void End();
+	INT RegisterThread();
+	void Export( FOutputDevice* Out );
+	void Summarize( FOutputDevice* Out );
+};
+
+/*-----------------------------------------------------------------------------
+	FProfileZone.
+-----------------------------------------------------------------------------*/
+
+//
+// Times the scope it is declared in.  Name must be a string literal, or
+// otherwise outlive the capture.
+//
+class FProfileZone
+{
+public:
+	FProfileZone( const char* InName )
+	:	Name	( InName )
+	,	Depth	( INDEX_NONE )
+	{
+		if( GProfiler.bCapturing )
+			Depth = GProfiler.BeginZone( Start );
+	}
+	~FProfileZone()
+	{
+		if( Depth!=INDEX_NONE )
+			GProfiler.EndZone( Name, Start, Depth );
+	}
+private:
+	const char*	Name;
+	QWORD		Start;
+	INT			Depth;
+};
+
+//
+// Profile the enclosing scope.
+//
+#define profileZone(Name) FProfileZone ProfileZone(Name)
+
+/*-----------------------------------------------------------------------------
+	The End.
+-----------------------------------------------------------------------------*/
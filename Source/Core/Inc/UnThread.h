@@ -22,12 +22,72 @@ typedef THREAD_RET ( *THREAD_FUNC )( void* Arg );
 CORE_API UTHREAD appThreadSpawn( THREAD_FUNC Func, void* Arg, const char* Name, UBOOL bDetach, DWORD* OutThreadId );
 CORE_API THREAD_RET appThreadJoin( UTHREAD Thread );
 
+// Yield the rest of the calling thread's time slice.
+CORE_API void appThreadYield();
+
 // Recursive mutex operations.
 CORE_API UMUTEX appMutexCreate( const char* Name );
 CORE_API UBOOL appMutexLock( UMUTEX Mutex );
 CORE_API UBOOL appMutexUnlock( UMUTEX Mutex );
 CORE_API void appMutexFree( UMUTEX Mutex );
 
+// Counting semaphore operations.
+typedef void* USEMAPHORE;
+CORE_API USEMAPHORE appSemaphoreCreate( INT InitialCount, const char* Name );
+CORE_API void appSemaphoreWait( USEMAPHORE Semaphore );
+CORE_API void appSemaphorePost( USEMAPHORE Semaphore, INT Count );
+CORE_API void appSemaphoreFree( USEMAPHORE Semaphore );
+
+/*-----------------------------------------------------------------------------
+	Atomic operations.
+-----------------------------------------------------------------------------*/
+
+#if defined(PLATFORM_PSP)
+// Single core and no worker threads, so plain memory operations will do.
+inline INT appInterlockedAdd( volatile INT* Value, INT Amount )
+{
+	return *Value += Amount;
+}
+inline INT appInterlockedCompareExchange( volatile INT* Dest, INT Exchange, INT Comparand )
+{
+	INT Old = *Dest;
+	if( Old == Comparand )
+		*Dest = Exchange;
+	return Old;
+}
+#elif _MSC_VER
+extern "C" long __cdecl _InterlockedExchangeAdd( long volatile* Addend, long Value );
+extern "C" long __cdecl _InterlockedCompareExchange( long volatile* Dest, long Exchange, long Comparand );
+#pragma intrinsic(_InterlockedExchangeAdd)
+#pragma intrinsic(_InterlockedCompareExchange)
+inline INT appInterlockedAdd( volatile INT* Value, INT Amount )
+{
+	return _InterlockedExchangeAdd( (long volatile*)Value, Amount ) + Amount;
+}
+inline INT appInterlockedCompareExchange( volatile INT* Dest, INT Exchange, INT Comparand )
+{
+	return _InterlockedCompareExchange( (long volatile*)Dest, Exchange, Comparand );
+}
+#else
+inline INT appInterlockedAdd( volatile INT* Value, INT Amount )
+{
+	return __atomic_add_fetch( Value, Amount, __ATOMIC_SEQ_CST );
+}
+inline INT appInterlockedCompareExchange( volatile INT* Dest, INT Exchange, INT Comparand )
+{
+	__atomic_compare_exchange_n( Dest, &Comparand, Exchange, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST );
+	return Comparand;
+}
+#endif
+
+// Return the new value.
+inline INT appInterlockedIncrement( volatile INT* Value ) {return appInterlockedAdd( Value, 1 );}
+inline INT appInterlockedDecrement( volatile INT* Value ) {return appInterlockedAdd( Value, -1 );}
+
+/*-----------------------------------------------------------------------------
+	Synchronization objects.
+-----------------------------------------------------------------------------*/
+
 // Mutex object.
 class CORE_API FMutex
 {
@@ -176,6 +176,11 @@ typedef struct _iobuf FILE;
 //
 CORE_API DWORD appCycles();
 
+//
+// 64-bit monotonic CPU cycles, related to GSecondsPerCycle.
+//
+CORE_API QWORD appCycles64();
+
 //
 // Seconds, arbitrarily based.
 //
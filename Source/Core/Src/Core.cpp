@@ -13,6 +13,8 @@
 CORE_API FObjectManager GObj;
 CORE_API FMemCache GCache;
 CORE_API FMemStack GMem;
+CORE_API FJobManager GJobs;
+CORE_API FProfiler GProfiler;
 
 // Global subsystems outside the core.
 CORE_API USystem* GSys=NULL;
@@ -22,6 +24,8 @@ CORE_API FOutputDevice* GLogHook=NULL;
 CORE_API FExec* GExecHook=NULL;
 CORE_API UProperty* GProperty;
 CORE_API DWORD* GBoolAddr;
+CORE_API UProperty* GLetWatchProperty=NULL;
+CORE_API void (*GLetWatchHook)( BYTE* Var )=NULL;
 CORE_API DOUBLE GSecondsPerCycle=1.0;
 CORE_API SQWORD GTicks=1;
 CORE_API char GErrorHist[4096]="";
@@ -488,7 +488,12 @@ void UObject::execLet( FFrame& Stack, BYTE*& Result )
 	// Get variable address.
 	BYTE* Var=NULL;
 	Stack.Step( Stack.Object, Var );
-	GProperty->ExecLet( Var, Stack );
+	UProperty* Property = GProperty;
+	Property->ExecLet( Var, Stack );
+
+	// Let the engine know about assignments to the property it is watching.
+	if( Property==GLetWatchProperty )
+		GLetWatchHook( Var );
 
 	unguardexecSlow;
 }
@@ -0,0 +1,553 @@
+/*=============================================================================
+	UnJobs.cpp: Work-stealing job system.
+	Copyright 1997 Epic MegaGames, Inc. This software is a trade secret.
+=============================================================================*/
+
+#include "CorePrivate.h"
+
+/*-----------------------------------------------------------------------------
+	Globals.
+-----------------------------------------------------------------------------*/
+
+// Index of the calling thread's queue: 0 for the main thread and any other
+// non-worker thread, 1..NumWorkers for the workers.
+static thread_local INT GJobThreadIndex = 0;
+
+//
+// A job held back until its prerequisite counter drops to zero.
+//
+struct FWaitingJob
+{
+	FJob			Job;
+	FWaitingJob*	Next;
+};
+
+/*-----------------------------------------------------------------------------
+	Init & Exit.
+-----------------------------------------------------------------------------*/
+
+FJobManager::FJobManager()
+:	NumThreads		( 1 )
+,	WorkAvailable	( NULL )
+,	WaitingMutex	( NULL )
+,	NumSleeping		( 0 )
+,	bShutdown		( 0 )
+,	StatsStartTime	( 0.0 )
+{
+	appMemset( Queues, 0, sizeof(Queues) );
+	appMemset( Threads, 0, sizeof(Threads) );
+}
+
+//
+// Start the worker threads.
+//
+void FJobManager::Init( INT InNumWorkers )
+{
+	guard(FJobManager::Init);
+	check(WaitingMutex==NULL);
+
+	NumThreads    = Clamp( InNumWorkers, 0, MAX_JOB_THREADS-1 ) + 1;
+	bShutdown     = 0;
+	NumSleeping   = 0;
+	WaitingMutex  = appMutexCreate( "JobWaiting" );
+	WorkAvailable = appSemaphoreCreate( 0, "JobSemaphore" );
+	for( INT i=0; i<NumThreads; i++ )
+		Queues[i].Mutex = appMutexCreate( "JobQueue" );
+	for( INT i=1; i<NumThreads; i++ )
+	{
+		char Name[32];
+		appSprintf( Name, "JobWorker%i", i );
+		Threads[i] = appThreadSpawn( WorkerMain, (void*)(size_t)i, Name, 0, NULL );
+		if( !Threads[i] )
+		{
+			debugf( NAME_Warning, "Failed to spawn job worker %i", i );
+			for( INT j=i; j<NumThreads; j++ )
+			{
+				appMutexFree( Queues[j].Mutex );
+				Queues[j].Mutex = NULL;
+			}
+			NumThreads = i;
+			break;
+		}
+	}
+	ResetStats();
+	debugf( NAME_Init, "Job system initialized with %i worker threads", NumThreads-1 );
+	unguard;
+}
+
+//
+// Stop the worker threads, after finishing all queued jobs.
+//
+void FJobManager::Exit()
+{
+	guard(FJobManager::Exit);
+	if( !WaitingMutex )
+		return;
+
+	// Help out until the queues are empty.
+	FJob Job;
+	while( FindJob( 0, Job ) )
+		Execute( 0, Job );
+
+	bShutdown = 1;
+	appSemaphorePost( WorkAvailable, NumThreads );
+	for( INT i=1; i<NumThreads; i++ )
+		appThreadJoin( Threads[i] );
+	for( INT i=0; i<NumThreads; i++ )
+	{
+		check(Queues[i].Num==0);
+		appMutexFree( Queues[i].Mutex );
+		if( Queues[i].Jobs )
+			appFree( Queues[i].Jobs );
+	}
+	appSemaphoreFree( WorkAvailable );
+	appMutexFree( WaitingMutex );
+	appMemset( Queues, 0, sizeof(Queues) );
+	appMemset( Threads, 0, sizeof(Threads) );
+	WorkAvailable = NULL;
+	WaitingMutex  = NULL;
+	NumThreads    = 1;
+	debugf( NAME_Exit, "Job system shut down" );
+	unguard;
+}
+
+//
+// Worker thread entry point.
+//
+THREAD_RET
+#ifdef PLATFORM_WIN32
+	__stdcall
+#endif
+	FJobManager::WorkerMain( void* Arg )
+{
+	INT iThread = (INT)(size_t)Arg;
+	GJobThreadIndex = iThread;
+	while( !GJobs.bShutdown )
+	{
+		FJob Job;
+		if( GJobs.FindJob( iThread, Job ) )
+		{
+			GJobs.Execute( iThread, Job );
+		}
+		else
+		{
+			// Announce that we're going to sleep before looking one last time,
+			// so that a job pushed in between is sure to post the semaphore.
+			// The last look takes every queue's lock, which Push holds while
+			// it checks for sleepers, so one of the two always sees the other.
+			appInterlockedIncrement( &GJobs.NumSleeping );
+			UBOOL bFound = GJobs.FindJob( iThread, Job, 1 );
+			if( !bFound )
+				appSemaphoreWait( GJobs.WorkAvailable );
+			appInterlockedDecrement( &GJobs.NumSleeping );
+			if( bFound )
+				GJobs.Execute( iThread, Job );
+		}
+	}
+	return (THREAD_RET)0;
+}
+
+/*-----------------------------------------------------------------------------
+	Queues.
+-----------------------------------------------------------------------------*/
+
+//
+// Push a job onto the back of a thread's queue.
+//
+void FJobManager::Push( INT iThread, const FJob& Job )
+{
+	FJobQueue& Queue = Queues[iThread];
+	appMutexLock( Queue.Mutex );
+	if( Queue.Num == Queue.Max )
+	{
+		// Grow and unwrap the ring.
+		INT   NewMax  = Queue.Max ? Queue.Max*2 : 256;
+		FJob* NewJobs = (FJob*)appMalloc( NewMax*sizeof(FJob), "JobQueue" );
+		for( INT i=0; i<Queue.Num; i++ )
+			NewJobs[i] = Queue.Jobs[(Queue.Head+i) & (Queue.Max-1)];
+		if( Queue.Jobs )
+			appFree( Queue.Jobs );
+		Queue.Jobs = NewJobs;
+		Queue.Head = 0;
+		Queue.Max  = NewMax;
+	}
+	Queue.Jobs[(Queue.Head+Queue.Num++) & (Queue.Max-1)] = Job;
+	UBOOL bWake = NumSleeping > 0;
+	appMutexUnlock( Queue.Mutex );
+
+	// Wake a sleeping worker.  Checked under the lock, so that a worker which
+	// announced it was going to sleep either sees this job or gets woken.
+	if( bWake )
+		appSemaphorePost( WorkAvailable, 1 );
+}
+
+//
+// Pop the newest job from the back of a thread's own queue.  Unless bLocked,
+// an empty looking queue is skipped without taking its lock.
+//
+UBOOL FJobManager::Pop( INT iThread, FJob& Job, UBOOL bLocked )
+{
+	FJobQueue& Queue = Queues[iThread];
+	if( Queue.Num==0 && !bLocked )
+		return 0;
+	UBOOL Result = 0;
+	appMutexLock( Queue.Mutex );
+	if( Queue.Num > 0 )
+	{
+		Job    = Queue.Jobs[(Queue.Head + --Queue.Num) & (Queue.Max-1)];
+		Result = 1;
+	}
+	appMutexUnlock( Queue.Mutex );
+	return Result;
+}
+
+//
+// Steal the oldest job from the front of another thread's queue.  Unless
+// bLocked, empty looking queues are skipped without taking their locks.
+//
+UBOOL FJobManager::Steal( INT iThread, FJob& Job, UBOOL bLocked )
+{
+	for( INT i=1; i<NumThreads; i++ )
+	{
+		FJobQueue& Queue = Queues[(iThread+i) % NumThreads];
+		if( Queue.Num==0 && !bLocked )
+			continue;
+		UBOOL Result = 0;
+		appMutexLock( Queue.Mutex );
+		if( Queue.Num > 0 )
+		{
+			Job        = Queue.Jobs[Queue.Head];
+			Queue.Head = (Queue.Head+1) & (Queue.Max-1);
+			Queue.Num--;
+			Result     = 1;
+		}
+		appMutexUnlock( Queue.Mutex );
+		if( Result )
+		{
+			Queues[iThread].NumStolen++;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+UBOOL FJobManager::FindJob( INT iThread, FJob& Job, UBOOL bLocked )
+{
+	return Pop( iThread, Job, bLocked ) || Steal( iThread, Job, bLocked );
+}
+
+/*-----------------------------------------------------------------------------
+	Execution.
+-----------------------------------------------------------------------------*/
+
+//
+// Run a job and retire it.
+//
+void FJobManager::Execute( INT iThread, const FJob& Job )
+{
+	DOUBLE StartTime = appSeconds();
+	{
+		profileZone("Job");
+		Job.Func( Job.Arg );
+	}
+	Queues[iThread].BusySeconds += appSeconds() - StartTime;
+	Queues[iThread].NumRun++;
+	Finish( Job.Counter );
+}
+
+//
+// Count a job as finished, releasing the jobs which were waiting on its counter.
+//
+void FJobManager::Finish( FJobCounter* Counter )
+{
+	if( !Counter )
+		return;
+	if( !WaitingMutex )
+	{
+		// Not initialized, so everything runs inline.
+		appInterlockedDecrement( &Counter->Count );
+		return;
+	}
+
+	// Only the last job takes the lock.  The count reaches zero inside it,
+	// so waiting jobs are never missed, and Wait can use the lock to know
+	// that we're done with the counter.
+	for( ;; )
+	{
+		INT Old = Counter->Count;
+		if( Old<=1 )
+			break;
+		if( appInterlockedCompareExchange( &Counter->Count, Old-1, Old )==Old )
+			return;
+	}
+	FWaitingJob* Waiting = NULL;
+	appMutexLock( WaitingMutex );
+	if( appInterlockedDecrement( &Counter->Count )==0 )
+	{
+		Waiting               = Counter->FirstWaiting;
+		Counter->FirstWaiting = NULL;
+	}
+	appMutexUnlock( WaitingMutex );
+	while( Waiting )
+	{
+		FWaitingJob* Next = Waiting->Next;
+		Push( GJobThreadIndex, Waiting->Job );
+		appFree( Waiting );
+		Waiting = Next;
+	}
+}
+
+//
+// Queue a job.  If Counter is given, it counts the job until it finishes.
+// If Prerequisite is given, the job doesn't start until it is done.
+//
+void FJobManager::Launch( JOB_FUNC Func, void* Arg, FJobCounter* Counter, FJobCounter* Prerequisite )
+{
+	check(Func);
+	FJob Job;
+	Job.Func    = Func;
+	Job.Arg     = Arg;
+	Job.Counter = Counter;
+	if( Counter )
+		appInterlockedIncrement( &Counter->Count );
+
+	// Hold the job back if its prerequisite hasn't finished.
+	if( Prerequisite && Prerequisite->Count>0 && WaitingMutex )
+	{
+		appMutexLock( WaitingMutex );
+		if( Prerequisite->Count>0 )
+		{
+			FWaitingJob* Waiting = (FWaitingJob*)appMalloc( sizeof(FWaitingJob), "WaitingJob" );
+			Waiting->Job  = Job;
+			Waiting->Next = Prerequisite->FirstWaiting;
+			Prerequisite->FirstWaiting = Waiting;
+			appMutexUnlock( WaitingMutex );
+			return;
+		}
+		appMutexUnlock( WaitingMutex );
+	}
+
+	if( NumThreads>1 )
+		Push( GJobThreadIndex, Job );
+	else
+		Execute( 0, Job );
+}
+
+//
+// Wait for all jobs counted by Counter to finish, running queued jobs
+// on the calling thread while waiting.
+//
+void FJobManager::Wait( FJobCounter& Counter )
+{
+	INT iThread = GJobThreadIndex;
+	while( Counter.Count > 0 )
+	{
+		FJob Job;
+		if( FindJob( iThread, Job ) )
+			Execute( iThread, Job );
+		else
+			appThreadYield();
+	}
+
+	// Make sure the last job has let go of the counter.
+	if( WaitingMutex )
+	{
+		appMutexLock( WaitingMutex );
+		appMutexUnlock( WaitingMutex );
+	}
+}
+
+//
+// Call Func over [0,Num) split into batches of at least MinBatch indices,
+// in parallel, and wait for it to finish.
+//
+struct FParallelForBatch
+{
+	JOB_RANGE_FUNC	Func;
+	void*			Arg;
+	INT				Start, End;
+};
+static void ParallelForJob( void* Arg )
+{
+	FParallelForBatch* Batch = (FParallelForBatch*)Arg;
+	Batch->Func( Batch->Arg, Batch->Start, Batch->End );
+}
+void FJobManager::ParallelFor( INT Num, JOB_RANGE_FUNC Func, void* Arg, INT MinBatch )
+{
+	// Split into a few batches per thread so that stealing can even out the load.
+	enum {MAX_BATCHES=4*MAX_JOB_THREADS};
+	INT NumBatches = Min( Min( Num / Max(MinBatch,1), 4*NumThreads ), (INT)MAX_BATCHES );
+	if( NumThreads<=1 || NumBatches<=1 )
+	{
+		if( Num > 0 )
+			Func( Arg, 0, Num );
+		return;
+	}
+
+	// Launch all batches but the first, which the caller runs itself.
+	FParallelForBatch Batches[MAX_BATCHES];
+	FJobCounter Counter;
+	for( INT i=0; i<NumBatches; i++ )
+	{
+		Batches[i].Func  = Func;
+		Batches[i].Arg   = Arg;
+		Batches[i].Start = (SQWORD)Num *  i    / NumBatches;
+		Batches[i].End   = (SQWORD)Num * (i+1) / NumBatches;
+		if( i > 0 )
+			Launch( ParallelForJob, &Batches[i], &Counter );
+	}
+	ParallelForJob( &Batches[0] );
+	Wait( Counter );
+}
+
+INT FJobManager::GetThreadIndex() const
+{
+	return GJobThreadIndex;
+}
+
+/*-----------------------------------------------------------------------------
+	Stats and benchmarks.
+-----------------------------------------------------------------------------*/
+
+void FJobManager::ResetStats()
+{
+	for( INT i=0; i<NumThreads; i++ )
+	{
+		Queues[i].NumRun      = 0;
+		Queues[i].NumStolen   = 0;
+		Queues[i].BusySeconds = 0.0;
+	}
+	StatsStartTime = appSeconds();
+}
+
+// Benchmark jobs.
+static void EmptyJob( void* Arg )
+{}
+static void SqrtRangeJob( void* Arg, INT Start, INT End )
+{
+	FLOAT* Data = (FLOAT*)Arg;
+	for( INT i=Start; i<End; i++ )
+		Data[i] = appSqrt( Data[i] * 1.0001f + 1.f );
+}
+struct FBenchChain
+{
+	FLOAT* Data;
+	INT    Start, End;
+};
+static void ChainJob( void* Arg )
+{
+	FBenchChain* Chain = (FBenchChain*)Arg;
+	SqrtRangeJob( Chain->Data, Chain->Start, Chain->End );
+}
+
+//
+// Microbenchmarks: job overhead, parallel-for throughput, and dependent stages.
+//
+void FJobManager::Bench( FOutputDevice* Out )
+{
+	guard(FJobManager::Bench);
+	enum {NUM_EMPTY=20000, NUM_DATA=1<<20, NUM_PASSES=8, NUM_STAGES=8, STAGE_JOBS=32};
+	Out->Logf( "JOBS BENCH: %i worker threads", NumWorkers() );
+
+	// Launch and retire empty jobs.
+	{
+		FJobCounter Counter;
+		DOUBLE StartTime = appSeconds();
+		for( INT i=0; i<NUM_EMPTY; i++ )
+			Launch( EmptyJob, NULL, &Counter );
+		Wait( Counter );
+		DOUBLE Time = appSeconds() - StartTime;
+		Out->Logf( "  empty jobs:   %i in %.3f ms (%.3f us/job)", (INT)NUM_EMPTY, 1000.0*Time, 1000000.0*Time/NUM_EMPTY );
+	}
+
+	// Serial versus parallel loop.
+	FLOAT* Data = (FLOAT*)appMalloc( NUM_DATA*sizeof(FLOAT), "JobBench" );
+	for( INT i=0; i<NUM_DATA; i++ )
+		Data[i] = (FLOAT)i;
+	{
+		DOUBLE StartTime = appSeconds();
+		for( INT Pass=0; Pass<NUM_PASSES; Pass++ )
+			SqrtRangeJob( Data, 0, NUM_DATA );
+		DOUBLE SerialTime = appSeconds() - StartTime;
+
+		StartTime = appSeconds();
+		for( INT Pass=0; Pass<NUM_PASSES; Pass++ )
+			ParallelFor( NUM_DATA, SqrtRangeJob, Data, 4096 );
+		DOUBLE ParallelTime = appSeconds() - StartTime;
+
+		Out->Logf
+		(
+			"  parallel-for: %i x %i elements: serial %.3f ms, parallel %.3f ms (%.2fx)",
+			(INT)NUM_PASSES, (INT)NUM_DATA,
+			1000.0*SerialTime, 1000.0*ParallelTime,
+			ParallelTime>0.0 ? SerialTime/ParallelTime : 0.0
+		);
+	}
+
+	// A pipeline of stages, each waiting on the previous one.
+	{
+		FJobCounter   Counters[NUM_STAGES];
+		FBenchChain   Chains[NUM_STAGES][STAGE_JOBS];
+		DOUBLE StartTime = appSeconds();
+		for( INT Stage=0; Stage<NUM_STAGES; Stage++ )
+		{
+			for( INT i=0; i<STAGE_JOBS; i++ )
+			{
+				FBenchChain& Chain = Chains[Stage][i];
+				Chain.Data  = Data;
+				Chain.Start = NUM_DATA *  i    / STAGE_JOBS;
+				Chain.End   = NUM_DATA * (i+1) / STAGE_JOBS;
+				Launch( ChainJob, &Chain, &Counters[Stage], Stage ? &Counters[Stage-1] : NULL );
+			}
+		}
+		Wait( Counters[NUM_STAGES-1] );
+		DOUBLE Time = appSeconds() - StartTime;
+		for( INT Stage=0; Stage<NUM_STAGES; Stage++ )
+			check(Counters[Stage].IsDone());
+		Out->Logf( "  dependencies: %i stages of %i jobs in %.3f ms", (INT)NUM_STAGES, (INT)STAGE_JOBS, 1000.0*Time );
+	}
+	appFree( Data );
+	unguard;
+}
+
+//
+// Exec.
+//
+UBOOL FJobManager::Exec( const char* Cmd, FOutputDevice* Out )
+{
+	guard(FJobManager::Exec);
+	const char* Str = Cmd;
+	if( !ParseCommand(&Str,"JOBS") )
+		return 0;
+	if( ParseCommand(&Str,"STATS") )
+	{
+		DOUBLE Elapsed = appSeconds() - StatsStartTime;
+		Out->Logf( "Jobs: %i worker threads, %.2f seconds since reset", NumWorkers(), Elapsed );
+		for( INT i=0; i<NumThreads; i++ )
+			Out->Logf
+			(
+				"  %-8s run=%-8i stolen=%-8i busy=%5.1f%%",
+				i ? "worker" : "main",
+				Queues[i].NumRun,
+				Queues[i].NumStolen,
+				Elapsed>0.0 ? 100.0 * Queues[i].BusySeconds / Elapsed : 0.0
+			);
+		return 1;
+	}
+	else if( ParseCommand(&Str,"RESET") )
+	{
+		ResetStats();
+		return 1;
+	}
+	else if( ParseCommand(&Str,"BENCH") )
+	{
+		Bench( Out );
+		return 1;
+	}
+	return 0;
+	unguard;
+}
+
+/*-----------------------------------------------------------------------------
+	The End.
+-----------------------------------------------------------------------------*/
@@ -1827,6 +1827,7 @@ UClass* FObjectManager::LoadClass( UClass* BaseClass, UObject* InParent, const c
 UObject* FObjectManager::LoadPackage( UObject* InParent, const char* Filename, DWORD LoadFlags )
 {
 	guard(FObjectManager::LoadPackage);
+	profileZone("FObjectManager::LoadPackage");
 	//DWORD Time=0; uclock(Time);
 	UObject* Result;
 
@@ -1874,6 +1875,7 @@ void FObjectManager::BeginLoad()
 void FObjectManager::EndLoad()
 {
 	guard(FObjectManager::EndLoad);
+	profileZone("FObjectManager::EndLoad");
 	check(BeginLoadCount>0);
 	if( --BeginLoadCount == 0 )
 	{
@@ -2800,6 +2802,7 @@ void FObjectManager::PurgeGarbage( FOutputDevice* Out )
 void FObjectManager::CollectGarbage( FOutputDevice* Out, DWORD KeepFlags )
 {
 	guard(FObjectManager::CollectGarbage);
+	profileZone("FObjectManager::CollectGarbage");
 	debugf( NAME_Log, "Collecting garbage" );
 
 	// Tag and purge garbage.
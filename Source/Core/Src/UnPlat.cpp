@@ -503,8 +503,18 @@ void appInit()
 	// PSP is a single-core MIPS with a 4K page size.
 	GPageSize = 4096;
 	GProcessorCount = 1;
+#else
+	// POSIX monotonic clock in nanoseconds.
+	GSecondsPerCycle = 1.0 / 1000000000.0;
+	GPageSize = sysconf( _SC_PAGESIZE );
+	GProcessorCount = sysconf( _SC_NPROCESSORS_ONLN );
 #endif // PLATFORM_
 
+	// Start the job system with one worker per additional processor.
+	INT NumWorkers = (INT)GProcessorCount - 1;
+	Parse( appCmdLine(), "JOBS=", NumWorkers );
+	GJobs.Init( NumWorkers );
+
 #if __INTEL__
 	// Check processor version with CPUID.
 	DWORD A=0, B=0, C=0, D=0;
@@ -595,6 +605,8 @@ void appEnableFastMath( UBOOL Enable )
 void appExit()
 {
 	debugf( NAME_Exit, "appExit" );
+	GJobs.Exit();
+	GProfiler.Exit();
 	appDumpAllocs( GSystem );
 	appCloseLog();
 }
@@ -765,35 +777,43 @@ void appDebugBreak()
 -----------------------------------------------------------------------------*/
 
 //
-// Get time in seconds.
+// Get 64-bit monotonic time in cycles.
 //
-CORE_API DOUBLE appSeconds()
+CORE_API QWORD appCycles64()
 {
 #ifdef PLATFORM_MSVC
-	static LARGE_INTEGER ret;
-	QueryPerformanceCounter(&ret);
-	return (DOUBLE)ret.QuadPart * GSecondsPerCycle;
+	LARGE_INTEGER Ret;
+	QueryPerformanceCounter(&Ret);
+	return Ret.QuadPart;
 #elif defined(PLATFORM_SDL)
-	return (DOUBLE)SDL_GetPerformanceCounter() * GSecondsPerCycle;
+	return SDL_GetPerformanceCounter();
 #elif defined(PLATFORM_PSP)
-	return (DOUBLE)sceKernelGetSystemTimeWide() * GSecondsPerCycle;
+	return sceKernelGetSystemTimeWide();
 #else
-	return 0;
+	// Nanoseconds; appInit sets GSecondsPerCycle to match.
+	timespec Ts;
+	clock_gettime( CLOCK_MONOTONIC, &Ts );
+	return (QWORD)Ts.tv_sec * 1000000000 + Ts.tv_nsec;
 #endif
 }
 
+//
+// Get time in seconds.
+//
+CORE_API DOUBLE appSeconds()
+{
+	return (DOUBLE)appCycles64() * GSecondsPerCycle;
+}
+
+//
+// Get the low 32 bits of the cycle counter, for short intervals.
+//
 CORE_API DWORD appCycles()
 {
-#ifdef PLATFORM_MSVC
-	static LARGE_INTEGER ret;
-	QueryPerformanceCounter(&ret);
-	return ret.LowPart;
-#elif defined(PLATFORM_SDL)
-	return SDL_GetPerformanceCounter();
-#elif defined(PLATFORM_PSP)
+#ifdef PLATFORM_PSP
 	return (DWORD)sceKernelGetSystemTimeLow();
 #else
-	return 0;
+	return (DWORD)appCycles64();
 #endif
 }
 
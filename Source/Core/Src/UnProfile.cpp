@@ -0,0 +1,410 @@
+/*=============================================================================
+	UnProfile.cpp: Scoped zone profiler with trace capture.
+	Copyright 1997 Epic MegaGames, Inc. This software is a trade secret.
+=============================================================================*/
+
+#include "CorePrivate.h"
+
+/*-----------------------------------------------------------------------------
+	Globals.
+-----------------------------------------------------------------------------*/
+
+//
+// Per-thread zone nesting state.  A thread joins a capture the first time
+// it enters a zone while the capture is running.
+//
+struct FProfileThreadState
+{
+	INT		CaptureId;
+	INT		Slot;
+	INT		Depth;
+	QWORD	Child[FProfiler::MAX_PROFILE_DEPTH];
+};
+static thread_local FProfileThreadState GProfileThread = {0};
+
+/*-----------------------------------------------------------------------------
+	Init & Exit.
+-----------------------------------------------------------------------------*/
+
+FProfiler::FProfiler()
+:	bCapturing		( 0 )
+,	Events			( NULL )
+,	MaxEvents		( 0 )
+,	NumEvents		( 0 )
+,	NumThreads		( 0 )
+,	CaptureId		( 0 )
+,	Frames			( 0 )
+,	NumFrames		( 0 )
+,	CaptureStart	( 0 )
+,	bPendingStart	( 0 )
+,	bPendingStop	( 0 )
+,	PendingFrames	( 0 )
+,	PendingEvents	( DEFAULT_EVENTS )
+{
+	Filename[0] = 0;
+	appMemset( ThreadNames, 0, sizeof(ThreadNames) );
+}
+
+//
+// Free the capture buffer.
+//
+void FProfiler::Exit()
+{
+	guard(FProfiler::Exit);
+	bCapturing = 0;
+	if( Events )
+		appFree( Events );
+	Events    = NULL;
+	MaxEvents = 0;
+	NumEvents = 0;
+	unguard;
+}
+
+/*-----------------------------------------------------------------------------
+	Capture control.
+-----------------------------------------------------------------------------*/
+
+//
+// Request a capture of InFrames frames, or until StopCapture if zero,
+// starting at the next frame boundary.
+//
+void FProfiler::StartCapture( INT InFrames, const char* InFilename, INT InMaxEvents )
+{
+	guard(FProfiler::StartCapture);
+	appStrncpy( Filename, InFilename && *InFilename ? InFilename : "Profile.json", ARRAY_COUNT(Filename) );
+	PendingFrames = Max( InFrames, 0 );
+	PendingEvents = Max( InMaxEvents, 1024 );
+	bPendingStart = 1;
+	bPendingStop  = 0;
+	unguard;
+}
+
+//
+// Stop the running capture at the next frame boundary.
+//
+void FProfiler::StopCapture()
+{
+	guard(FProfiler::StopCapture);
+	bPendingStart = 0;
+	if( bCapturing )
+		bPendingStop = 1;
+	unguard;
+}
+
+//
+// Mark a frame boundary.  Called on the main thread outside of any zone.
+//
+void FProfiler::Tick()
+{
+	guard(FProfiler::Tick);
+	if( bCapturing )
+	{
+		NumFrames++;
+		if( bPendingStop || (Frames>0 && NumFrames>=Frames) )
+			End();
+	}
+	if( bPendingStart )
+		Begin();
+	unguard;
+}
+
+//
+// Start a capture.
+//
+void FProfiler::Begin()
+{
+	guard(FProfiler::Begin);
+	check(!bCapturing);
+	bPendingStart = 0;
+	if( PendingEvents!=MaxEvents )
+	{
+		if( Events )
+			appFree( Events );
+		MaxEvents = PendingEvents;
+		Events    = (FProfileEvent*)appMalloc( MaxEvents * sizeof(FProfileEvent), "ProfileEvents" );
+	}
+	appMemset( Events, 0, MaxEvents * sizeof(FProfileEvent) );
+	NumEvents    = 0;
+	NumThreads   = 0;
+	NumFrames    = 0;
+	Frames       = PendingFrames;
+	CaptureId++;
+
+	// The main thread always gets the first slot.
+	GProfileThread.CaptureId = CaptureId;
+	GProfileThread.Depth     = 0;
+	GProfileThread.Slot      = RegisterThread();
+
+	CaptureStart = appCycles64();
+	bCapturing   = 1;
+	if( Frames )
+		debugf( NAME_Log, "Profile: capturing %i frames", Frames );
+	else
+		debugf( NAME_Log, "Profile: capturing until PROFILE STOP" );
+	unguard;
+}
+
+//
+// Finish a capture and write it out.
+//
+void FProfiler::End()
+{
+	guard(FProfiler::End);
+	bCapturing   = 0;
+	bPendingStop = 0;
+	Export( GSystem );
+	Summarize( GSystem );
+	unguard;
+}
+
+/*-----------------------------------------------------------------------------
+	Zones.
+-----------------------------------------------------------------------------*/
+
+//
+// Give the calling thread a slot in the current capture.
+//
+INT FProfiler::RegisterThread()
+{
+	INT Slot = appInterlockedIncrement( &NumThreads ) - 1;
+	if( Slot >= MAX_PROFILE_THREADS )
+		return INDEX_NONE;
+	INT iJobThread = GJobs.GetThreadIndex();
+	if( Slot==0 )
+		appSprintf( ThreadNames[Slot], "Main" );
+	else if( iJobThread>0 )
+		appSprintf( ThreadNames[Slot], "Job worker %i", iJobThread );
+	else
+		appSprintf( ThreadNames[Slot], "Thread %i", Slot );
+	return Slot;
+}
+
+//
+// Enter a zone.  Returns its depth, or INDEX_NONE if it won't be recorded.
+//
+INT FProfiler::BeginZone( QWORD& Start )
+{
+	FProfileThreadState& T = GProfileThread;
+	if( T.CaptureId!=CaptureId )
+	{
+		T.CaptureId = CaptureId;
+		T.Depth     = 0;
+		T.Slot      = RegisterThread();
+	}
+	if( T.Slot==INDEX_NONE || T.Depth>=MAX_PROFILE_DEPTH )
+		return INDEX_NONE;
+	INT Depth = T.Depth++;
+	T.Child[Depth] = 0;
+	Start = appCycles64();
+	return Depth;
+}
+
+//
+// Leave a zone and record it.
+//
+void FProfiler::EndZone( const char* Name, QWORD Start, INT Depth )
+{
+	QWORD End = appCycles64();
+	FProfileThreadState& T = GProfileThread;
+	QWORD Inclusive = End - Start;
+	QWORD Exclusive = Inclusive > T.Child[Depth] ? Inclusive - T.Child[Depth] : 0;
+	T.Depth = Depth;
+	if( Depth>0 )
+		T.Child[Depth-1] += Inclusive;
+	if( bCapturing && T.CaptureId==CaptureId )
+	{
+		INT i = appInterlockedIncrement( &NumEvents ) - 1;
+		if( i < MaxEvents )
+		{
+			FProfileEvent& Event = Events[i];
+			Event.Start     = Start;
+			Event.Inclusive = Inclusive;
+			Event.Exclusive = Exclusive;
+			Event.Thread    = T.Slot;
+			Event.Depth     = Depth;
+			Event.Name      = Name;
+		}
+	}
+}
+
+/*-----------------------------------------------------------------------------
+	Output.
+-----------------------------------------------------------------------------*/
+
+//
+// Write the capture in Chrome trace event format.
+//
+void FProfiler::Export( FOutputDevice* Out )
+{
+	guard(FProfiler::Export);
+	FILE* F = appFopen( Filename, "wb" );
+	if( !F )
+	{
+		Out->Logf( NAME_Warning, "Profile: can't open %s", Filename );
+		return;
+	}
+	INT Num        = Min( (INT)NumEvents, MaxEvents );
+	INT Threads    = Min( (INT)NumThreads, (INT)MAX_PROFILE_THREADS );
+	DOUBLE ToMicro = GSecondsPerCycle * 1000000.0;
+	appFprintf( F, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n" );
+	appFprintf( F, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"%s\"}}", appPackage() );
+	for( INT i=0; i<Threads; i++ )
+	{
+		appFprintf( F, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%i,\"args\":{\"name\":\"%s\"}}", i, ThreadNames[i] );
+		appFprintf( F, ",\n{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":1,\"tid\":%i,\"args\":{\"sort_index\":%i}}", i, i );
+	}
+	for( INT i=0; i<Num; i++ )
+	{
+		// Skip slots claimed by a zone that hadn't finished writing at the end of the capture.
+		FProfileEvent& Event = Events[i];
+		if( !Event.Name || Event.Start<CaptureStart )
+			continue;
+		appFprintf
+		(
+			F,
+			",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%i,\"ts\":%.3f,\"dur\":%.3f}",
+			Event.Name,
+			Event.Thread,
+			(DOUBLE)(Event.Start - CaptureStart) * ToMicro,
+			(DOUBLE)Event.Inclusive * ToMicro
+		);
+	}
+	appFprintf( F, "\n]}\n" );
+	appFclose( F );
+	Out->Logf
+	(
+		"Profile: wrote %i zones over %i frames on %i threads to %s",
+		Num, NumFrames, Threads, Filename
+	);
+	if( NumEvents > MaxEvents )
+		Out->Logf( NAME_Warning, "Profile: dropped %i zones, capture with a larger EVENTS=", NumEvents - MaxEvents );
+	unguard;
+}
+
+//
+// Per-zone totals of a capture.
+//
+struct FProfileZoneStat
+{
+	const char*	Name;
+	INT			Calls;
+	INT			Depth;
+	QWORD		Inclusive;
+	QWORD		Exclusive;
+	QWORD		Max;
+};
+static int CDECL ZoneStatCompare( const void* A, const void* B )
+{
+	QWORD IA = ((FProfileZoneStat*)A)->Inclusive, IB = ((FProfileZoneStat*)B)->Inclusive;
+	return IA>IB ? -1 : IA<IB ? 1 : 0;
+}
+
+//
+// Log per-zone totals, most expensive first, indented by nesting depth.
+//
+void FProfiler::Summarize( FOutputDevice* Out )
+{
+	guard(FProfiler::Summarize);
+	TArray<FProfileZoneStat> Stats;
+	INT Num = Min( (INT)NumEvents, MaxEvents );
+	for( INT i=0; i<Num; i++ )
+	{
+		FProfileEvent& Event = Events[i];
+		if( !Event.Name )
+			continue;
+		INT j;
+		for( j=0; j<Stats.Num(); j++ )
+			if( Stats(j).Name==Event.Name || appStrcmp(Stats(j).Name,Event.Name)==0 )
+				break;
+		if( j==Stats.Num() )
+		{
+			j = Stats.AddZeroed();
+			Stats(j).Name  = Event.Name;
+			Stats(j).Depth = Event.Depth;
+		}
+		FProfileZoneStat& Stat = Stats(j);
+		Stat.Calls++;
+		Stat.Depth      = Min( Stat.Depth, Event.Depth );
+		Stat.Inclusive += Event.Inclusive;
+		Stat.Exclusive += Event.Exclusive;
+		Stat.Max        = ::Max( Stat.Max, Event.Inclusive );
+	}
+	if( Stats.Num() )
+		appQsort( &Stats(0), Stats.Num(), sizeof(FProfileZoneStat), ZoneStatCompare );
+
+	DOUBLE ToMsec = GSecondsPerCycle * 1000.0 / ::Max( NumFrames, 1 );
+	Out->Logf( "Profile: %i frames, times in msec per frame", NumFrames );
+	Out->Logf( "  %-32s %8s %9s %9s %9s", "Zone", "Calls", "Incl", "Excl", "Max" );
+	for( INT i=0; i<Stats.Num(); i++ )
+	{
+		FProfileZoneStat& Stat = Stats(i);
+		char Name[64];
+		INT Indent = Min( Stat.Depth, 8 ) * 2;
+		appSprintf( Name, "%*s%s", Indent, "", Stat.Name );
+		Out->Logf
+		(
+			"  %-32s %8i %9.3f %9.3f %9.3f",
+			Name,
+			Stat.Calls,
+			Stat.Inclusive * ToMsec,
+			Stat.Exclusive * ToMsec,
+			Stat.Max * GSecondsPerCycle * 1000.0
+		);
+	}
+	unguard;
+}
+
+/*-----------------------------------------------------------------------------
+	Exec.
+-----------------------------------------------------------------------------*/
+
+//
+// PROFILE START [FRAMES=n] [EVENTS=n] [FILE=name], PROFILE STOP, PROFILE STATS.
+//
+UBOOL FProfiler::Exec( const char* Cmd, FOutputDevice* Out )
+{
+	guard(FProfiler::Exec);
+	const char* Str = Cmd;
+	if( !ParseCommand(&Str,"PROFILE") )
+		return 0;
+	if( ParseCommand(&Str,"START") )
+	{
+		INT  NewFrames=0, NewEvents=DEFAULT_EVENTS;
+		char NewFilename[256]="";
+		Parse( Str, "FRAMES=", NewFrames );
+		Parse( Str, "EVENTS=", NewEvents );
+		Parse( Str, "FILE=", NewFilename, ARRAY_COUNT(NewFilename) );
+		if( bCapturing )
+			Out->Logf( "Profile: capture already running" );
+		else
+			StartCapture( NewFrames, NewFilename, NewEvents );
+		return 1;
+	}
+	else if( ParseCommand(&Str,"STOP") )
+	{
+		if( !bCapturing )
+			Out->Logf( "Profile: no capture running" );
+		StopCapture();
+		return 1;
+	}
+	else if( ParseCommand(&Str,"STATS") )
+	{
+		if( bCapturing )
+			Out->Logf( "Profile: capture still running" );
+		else if( !Events )
+			Out->Logf( "Profile: nothing captured yet" );
+		else
+			Summarize( Out );
+		return 1;
+	}
+	else
+	{
+		Out->Logf( "Profile: %s, %i zones, %i frames", bCapturing ? "capturing" : "idle", (INT)NumEvents, NumFrames );
+		return 1;
+	}
+	unguard;
+}
+
+/*-----------------------------------------------------------------------------
+	The End.
+-----------------------------------------------------------------------------*/
@@ -10,6 +10,7 @@
 #include <windows.h>
 #else
 #include <pthread.h>
+#include <sched.h>
 #endif
 
 #include "CorePrivate.h"
@@ -74,6 +75,15 @@ CORE_API THREAD_RET appThreadJoin( UTHREAD Thread )
 	unguard;
 }
 
+CORE_API void appThreadYield()
+{
+#ifdef PLATFORM_WIN32
+	SwitchToThread();
+#else
+	sched_yield();
+#endif
+}
+
 CORE_API UMUTEX appMutexCreate( const char* Name )
 {
 	guard(appMutexCreate);
@@ -141,3 +151,92 @@ CORE_API void appMutexFree( UMUTEX Mutex )
 
 	unguard;
 }
+
+#ifndef PLATFORM_WIN32
+// POSIX semaphores are missing or deprecated on some of our targets, so build one.
+struct FPosixSemaphore
+{
+	pthread_mutex_t Mutex;
+	pthread_cond_t  Cond;
+	INT             Count;
+};
+#endif
+
+CORE_API USEMAPHORE appSemaphoreCreate( INT InitialCount, const char* Name )
+{
+	guard(appSemaphoreCreate);
+
+#ifdef PLATFORM_WIN32
+	return (USEMAPHORE)CreateSemaphoreA( NULL, InitialCount, 0x7fffffff, NULL );
+#else
+	FPosixSemaphore* Sem = (FPosixSemaphore*)appMalloc( sizeof(FPosixSemaphore), Name );
+	check(Sem);
+	appMemset( (void*)Sem, 0, sizeof(*Sem) );
+	if( pthread_mutex_init( &Sem->Mutex, NULL ) != 0 )
+	{
+		appFree( (void*)Sem );
+		return nullptr;
+	}
+	if( pthread_cond_init( &Sem->Cond, NULL ) != 0 )
+	{
+		pthread_mutex_destroy( &Sem->Mutex );
+		appFree( (void*)Sem );
+		return nullptr;
+	}
+	Sem->Count = InitialCount;
+	return (USEMAPHORE)Sem;
+#endif
+
+	unguard;
+}
+
+CORE_API void appSemaphoreWait( USEMAPHORE Semaphore )
+{
+	check(Semaphore);
+
+#ifdef PLATFORM_WIN32
+	WaitForSingleObject( (HANDLE)Semaphore, INFINITE );
+#else
+	FPosixSemaphore* Sem = (FPosixSemaphore*)Semaphore;
+	pthread_mutex_lock( &Sem->Mutex );
+	while( Sem->Count <= 0 )
+		pthread_cond_wait( &Sem->Cond, &Sem->Mutex );
+	Sem->Count--;
+	pthread_mutex_unlock( &Sem->Mutex );
+#endif
+}
+
+CORE_API void appSemaphorePost( USEMAPHORE Semaphore, INT Count )
+{
+	check(Semaphore);
+
+#ifdef PLATFORM_WIN32
+	ReleaseSemaphore( (HANDLE)Semaphore, Count, NULL );
+#else
+	FPosixSemaphore* Sem = (FPosixSemaphore*)Semaphore;
+	pthread_mutex_lock( &Sem->Mutex );
+	Sem->Count += Count;
+	if( Count > 1 )
+		pthread_cond_broadcast( &Sem->Cond );
+	else
+		pthread_cond_signal( &Sem->Cond );
+	pthread_mutex_unlock( &Sem->Mutex );
+#endif
+}
+
+CORE_API void appSemaphoreFree( USEMAPHORE Semaphore )
+{
+	guard(appSemaphoreFree);
+	check(Semaphore);
+
+#ifdef PLATFORM_WIN32
+	CloseHandle( (HANDLE)Semaphore );
+#else
+	FPosixSemaphore* Sem = (FPosixSemaphore*)Semaphore;
+	pthread_cond_destroy( &Sem->Cond );
+	pthread_mutex_destroy( &Sem->Mutex );
+	appFree( (void*)Sem );
+#endif
+
+	unguard;
+}
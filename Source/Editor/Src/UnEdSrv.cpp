@@ -757,8 +757,9 @@ UBOOL UEditorEngine::Exec( const char* Stream, FOutputDevice* Out )
 			Out->Logf("Removed %d Paths", numpaths);
 			Processed=1;
 		}
-		else if (ParseCommand(&Str,"DEFINE"))
+		else if (ParseCommand(&Str,"DEFINE")) // PATHS DEFINE [CHECK]
 		{
+			UBOOL bCheck = ParseCommand(&Str,"CHECK");
 			FPathBuilder builder;
 			Trans->Begin			(Level,"UnDefine old Paths");
 			Level->Modify();
@@ -767,7 +768,7 @@ UBOOL UEditorEngine::Exec( const char* Stream, FOutputDevice* Out )
 
 			Trans->Begin			(Level,"Define Paths");
 			Level->Modify();
-			builder.definePaths		(Level);
+			builder.definePaths		(Level, bCheck);
 			Trans->End				();
 
 			RedrawLevel(Level);
@@ -261,6 +261,8 @@ void UEditorEngine::ResetSound()
 void UEditorEngine::Tick( float DeltaSeconds )
 {
 	guard(UEditorEngine::Tick);
+	GProfiler.Tick();
+	profileZone("UEditorEngine::Tick");
 
 	// Update subsystems.
 	GObj.Tick();				
@@ -8,6 +8,8 @@
 	// UObject interface.
 	void ProcessEvent( UFunction* Function, void* Parms );
 	void ProcessState( FLOAT DeltaSeconds );
+	EGotoState GotoState( FName State );
+	void CallFunction( FFrame& Stack, BYTE*& Result, UFunction* Function );
 	UBOOL ProcessRemoteFunction( UFunction* Function, void* Parms, FFrame* Stack );
 	void Serialize( FArchive& Ar );
 	void InitExecution();
@@ -25,6 +27,7 @@
 	inline UBOOL IsInZone( const AZoneInfo* Other ) const;
 	inline UBOOL IsBasedOn( const AActor *Other ) const;
 	virtual UBOOL Tick( FLOAT DeltaTime, enum ELevelTick TickType );
+	virtual UBOOL IsIdle( FLOAT& WakeDelay );
 	virtual void PostEditMove() {}
 	virtual void PreRaytrace() {}
 	virtual void PostRaytrace() {}
@@ -63,6 +66,7 @@
 	void SetCollisionSize( FLOAT NewRadius, FLOAT NewHeight );
 	void SetBase(AActor *NewBase, int bNotifyActor=1);
 	inline FRotator GetViewRotation();
+	inline void Unpark();
 
 	// AActor audio.
 	void MakeSound( USound *Sound, FLOAT Radius=0.f, FLOAT Volume=1.f, FLOAT Pitch=1.f );
@@ -15,7 +15,9 @@
 	void ShowSelf();
 	int CanHear(FVector NoiseLoc, FLOAT Loudness); 
 	DWORD LineOfSightTo(AActor *Other, int bShowSelf = 0);
+	int traceSightTo(AActor *Other, FLOAT distSq, int bShowSelf);
 	void CheckEnemyVisible();
+	void TickSight(FLOAT DeltaSeconds);
 
 	inline int walkToward(const FVector &Destination, FLOAT Movesize);
 
@@ -42,6 +42,7 @@ ENGINE_API extern class FGlobalMath	GMath;
 #include "EngineClasses.h"	// All actor classes.
 #include "UnReach.h"		// Reach specs.
 #include "UnURL.h"			// Uniform resource locators.
+#include "UnTimer.h"		// Timer wheel.
 #include "UnLevel.h"		// Level object.
 #include "UnIn.h"			// Input system.
 #include "UnPlayer.h"		// Player class.
@@ -165,6 +165,15 @@ inline FRotator AActor::GetViewRotation()
 	unguardSlow;
 }
 
+//
+// Make sure the level is ticking the actor, if it was parked as idle.
+//
+inline void AActor::Unpark()
+{
+	if( XLevel && XLevel->IsParked(this) )
+		XLevel->UnparkActor( this );
+}
+
 /*-----------------------------------------------------------------------------
 	AActor audio.
 -----------------------------------------------------------------------------*/
@@ -162,6 +162,12 @@ class ENGINE_API FActorChannel : public FChannel
 	BYTE*	Recent;			// Most recently sent values.
 	DOUBLE	RelevantTime;	// Last time this actor was relevant to client.
 	DOUBLE	LastUpdateTime;	// Last time this actor was replicated.
+	BYTE*	RecentPending;	// Replicated properties Recent didn't match afterwards, in FRepLink order.
+	INT		NumPending;		// Nonzero entries in RecentPending.
+	INT		RepSerial;		// Level RepSerial when this actor was last replicated.
+	BYTE	LastRemoteRole;	// RemoteRole it was last replicated with.
+	BYTE	bLastNetOwner;	// bNetOwner it was last replicated with.
+	BYTE	bRecentClean;	// Whether RecentPending is up to date.
 
 	// Constructor.
 	FActorChannel( UNetConnection* InConnection, INT InChannelIndex, INT InOpenedLocally );
@@ -24,6 +24,9 @@ public:
 	virtual void Flush( AActor *Actor ) = 0;
 	virtual int SurfIsDynamic( INT iSurf ) = 0;
 	virtual void Exit() = 0;
+	virtual UBOOL Exec( const char* Cmd, FOutputDevice* Out ) = 0;
+	virtual void InitStats() = 0;
+	virtual void GetStats( char* Result ) = 0;
 };
 ENGINE_API FMovingBrushTrackerBase* GNewBrushTracker( ULevel* Level );
 
@@ -24,6 +24,12 @@ class ENGINE_API UGameEngine : public UEngine
 	FURL			LastURL;
 	char			ServerActors[16][96];
 	char			ServerPackages[16][96];
+	FLOAT			HibernateDelay;		// Seconds a dedicated server waits with no connections before hibernating, 0=never.
+	INT				HibernateTickRate;	// Tick rate while hibernating.
+	UBOOL			bHibernating;
+	FLOAT			IdleTime;
+	DOUBLE			HibernateTime;
+	DOUBLE			HibernateWorkTime;
 
 	// Constructors.
 	static void InternalClassInitializer( UClass* Class );
@@ -52,6 +58,7 @@ class ENGINE_API UGameEngine : public UEngine
 	virtual void SaveGame( INT Position );
 	virtual void CancelPending();
 	virtual void PaintProgress();
+	virtual void UpdateHibernation( FLOAT DeltaSeconds, DOUBLE WorkTime );
 };
 
 /*-----------------------------------------------------------------------------
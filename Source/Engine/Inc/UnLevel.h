@@ -56,6 +56,7 @@ public:
 };
 
 ENGINE_API FCollisionHashBase* GNewCollisionHash();
+ENGINE_API FCollisionHashBase* GNewCollisionGrid();
 
 /*-----------------------------------------------------------------------------
 	ULevel base.
@@ -110,6 +111,34 @@ enum ETraceActorFlags
 	TRACE_ProjTargets	= TRACE_OnlyProjActor | TRACE_AllColliding,
 };
 
+//
+// One line check in a batch passed to ULevel::BatchLineCheck.
+//
+struct FTraceRequest
+{
+	FVector		End;			// End of the trace.
+	FVector		Start;			// Start of the trace.
+	FVector		Extent;			// Box extent, or zero for a line.
+	AActor*		SourceActor;	// Actor whose owners are ignored, or NULL.
+	DWORD		TraceFlags;		// ETraceActorFlags.
+	BYTE		NodeFlags;		// Extra Bsp node flags, e.g. NF_NotVisBlocking.
+	UBOOL		bCheckActors;	// Whether to check actors as well as the level.
+
+	// Constructors.  Actors are checked as SingleLineCheck would check them,
+	// unless InCheckActors is false, for traces against the level alone.
+	FTraceRequest()
+	{}
+	FTraceRequest( const FVector& InEnd, const FVector& InStart, DWORD InTraceFlags, AActor* InSourceActor=NULL, FVector InExtent=FVector(0,0,0), BYTE InNodeFlags=0, UBOOL InCheckActors=1 )
+	:	End				( InEnd )
+	,	Start			( InStart )
+	,	Extent			( InExtent )
+	,	SourceActor		( InSourceActor )
+	,	TraceFlags		( InTraceFlags )
+	,	NodeFlags		( InNodeFlags )
+	,	bCheckActors	( InCheckActors && (InTraceFlags & TRACE_AllColliding) )
+	{}
+};
+
 //
 // Level updating.
 //
@@ -120,6 +149,242 @@ enum ELevelTick : int
 	LEVELTICK_All			= 2,	// Update all.
 };
 
+//
+// Per-actor scheduling state kept by the level, indexed by object index.
+//
+struct FActorSchedule
+{
+	FLOAT	ParkTime;	// Level schedule time when the actor was parked.
+	INT		iTimer;		// Timer wheel node, or 0 if none.
+	INT		iTick;		// Index in the level's TickList plus one, or 0 if not listed.
+	UBOOL	bParked;	// Whether the actor is being skipped by ULevel::Tick.
+	FLOAT	AIInterval;	// Seconds between the AI scheduler's ticks of a pawn, or 0 for every frame.
+	FLOAT	AINextTime;	// Level schedule time when the pawn is next due a tick.
+	FLOAT	AIDelta;	// Seconds the pawn has gone unticked.
+	UBOOL	bSenseQueued;// Whether the pawn is waiting in the level's SenseQueue.
+};
+
+//
+// Per-actor bookkeeping for the level's actor list, indexed by object index.
+//
+struct FActorSlot
+{
+	INT		iActor;		// Index in the actor list plus one, or 0 if not known.  May be stale.
+	INT		iLive;		// Index in ULevel::LiveActors plus one, or 0 if not in it.
+	INT		NumOwned;	// Listed actors this one owns, while ULevel::bOwnedCountsValid.
+	UBOOL	bOneWayTouch;// Whether another actor may be touching this one without it touching back.
+	DWORD	Seq;		// Where it comes in ULevel::ActorOrder, or 0 if not numbered.
+};
+
+//
+// Destroyed actors of one class kept by the level for reuse by SpawnActor.
+// An actor is only pooled once CleanupDestroyed has cleared every reference
+// to it, and is reset to its class defaults on the way in.  Pooled actors
+// are chained through Deleted.
+//
+struct FActorPool
+{
+	FName	ClassName;	// Class to pool, matched by name until it is first seen.
+	UClass*	Class;		// Class to pool, or NULL if not seen yet.
+	AActor*	First;		// First pooled actor.
+	INT		Num, Max;	// Pooled actors, and the most to keep.
+	INT		Hits;		// Spawns which reused a pooled actor.
+	INT		Misses;		// Spawns which found the pool empty.
+	INT		Recycled;	// Destroyed actors taken into the pool.
+	DOUBLE	HitSeconds;	// Time spent constructing reused actors.
+	DOUBLE	MissSeconds;// Time spent constructing new actors.
+};
+
+//
+// Per-actor cache of the regions found by ULevel::CachedPointRegion, indexed
+// by object index.  Each slot remembers the point last looked up, and how
+// far it can move before it might leave the Bsp leaf it was in.
+//
+enum ERegionSlot
+{
+	REGION_Actor	= 0,	// The actor's Region.
+	REGION_Foot		= 1,	// A pawn's FootRegion.
+	REGION_Head		= 2,	// A pawn's HeadRegion.
+	REGION_MAX		= 3,
+};
+struct FRegionCacheSlot
+{
+	FVector	Location;	// Point last looked up.
+	FLOAT	SafeRadius;	// Distance it can move without leaving its leaf, or 0 if unknown.
+	INT		iLeaf;		// Leaf it was in.
+	INT		ZoneNumber;	// Zone it was in.
+};
+struct FActorRegionCache
+{
+	FRegionCacheSlot Slots[REGION_MAX];
+};
+
+//
+// Per-pawn cache of the line of sight traces made by APawn::LineOfSightTo,
+// indexed by object index.  Each slot remembers what the traces to one
+// target found, from where and when, and is reused while neither end has
+// moved further than SightTolerance, for up to SightLifetime seconds.
+//
+enum ESightResult
+{
+	SIGHT_Hidden	= 0,	// No trace got through.
+	SIGHT_Seen		= 1,	// A trace got through.
+	SIGHT_Enemy		= 2,	// A trace straight to the pawn's enemy got through.
+};
+enum {SIGHT_SLOTS=4};
+struct FSightCacheSlot
+{
+	AActor*	Target;			// Actor looked at, or NULL if unused.
+	FVector	ViewerLocation;	// Where the pawn was.
+	FVector	TargetLocation;	// Where the target was.
+	FLOAT	Time;			// Level time of the traces.
+	BYTE	Variant;		// Which traces LineOfSightTo chose to make.
+	BYTE	Result;			// ESightResult.
+};
+struct FActorSightCache
+{
+	FSightCacheSlot Slots[SIGHT_SLOTS];
+	INT iNext;				// Slot to replace next.
+};
+
+//
+// Per-actor record of what ULevel::GetRelevantActors found when it traced
+// to the actor, indexed by object index, with one bit for each network
+// viewer.  A viewer's bits are reused while it hasn't moved further than
+// RelevancyTolerance, for up to RelevancyLifetime seconds; an actor's bits
+// are all forgotten when it moves further than RelevancyTolerance.
+//
+enum {MAX_RELEVANCY_VIEWERS=64};
+struct FActorRelevancy
+{
+	FVector	Location;	// Where the actor was when it was traced to.
+	QWORD	Checked;	// Viewers which have traced to it.
+	QWORD	Visible;	// Viewers which saw it.
+};
+struct FRelevancyViewer
+{
+	AActor*	Viewer;		// Player pawn using the bit, or NULL if free.
+	FVector	Location;	// Where it was viewing from when its bits were set.
+	FLOAT	Time;		// Level time its bits were set.
+};
+
+//
+// Per-actor record of when its replicated properties last changed, kept by
+// ULevel::UpdateRepState and indexed by object index.  Changes are found by
+// comparing with Shadow once per net tick rather than once per connection,
+// and stamped with the level's RepSerial, so an actor channel only has to
+// look at properties changed since it last replicated the actor.
+//
+struct FActorRepState
+{
+	UClass*	Class;			// Class Shadow and Changed were laid out for, or NULL if unused.
+	BYTE*	Shadow;			// Replicated property values as of the last check.
+	INT*	Changed;		// RepSerial each replicated property last changed, in FRepLink order.
+	INT		NumLinks;		// Entries in Changed.
+	INT		NumElements;	// Replicated property elements, counting arrays.
+	INT		CheckedSerial;	// RepSerial of the last check.
+	INT		LastChange;		// Latest entry in Changed.
+	UBOOL	bNetAlways;		// Whether any property is CPF_NetAlways.
+};
+
+//
+// A projectile's sweep through world geometry for this tick, traced ahead
+// of time by ULevel::BatchProjectileSweeps.  MoveActor uses it in place of
+// its own world trace if the move turns out to be the one predicted.
+//
+struct FProjectileSweep
+{
+	AActor*			Actor;		// The projectile.
+	FVector			End;		// End of the trace MoveActor is expected to make.
+	FVector			Start;		// Start of the trace.
+	FVector			Extent;		// Collision extent.
+	UBOOL			bHitWorld;	// Whether the trace hit world geometry.
+	FCheckResult	WorldHit;	// The world hit, if any.
+};
+
+//
+// A list of the actors of one class (and its subclasses) or with one tag,
+// kept by the level for AllActors.  Entries are in spawn order, by sequence
+// number; destroyed actors leave a NULL entry until the list is purged.
+//
+struct FActorIndexEntry
+{
+	AActor*	Actor;		// The actor, or NULL if it has left the list.
+	DWORD	Seq;		// The actor's sequence number.
+};
+struct FActorIndex
+{
+	UClass*	Class;		// Class listed, or NULL for a tag list.
+	FName	Tag;		// Tag listed, or NAME_None for a class list.
+	INT		NumHoles;	// Number of NULL entries.
+	TArray<FActorIndexEntry> Entries;
+};
+struct FActorIndexInfo
+{
+	DWORD	Seq;		// Sequence number, or 0 if not indexed.
+	FName	Tag;		// Tag the actor is listed under.
+};
+
+//
+// Every actor in a level filed by the grid cell its location is in, for
+// RadiusActors and VisibleActors, which unlike the collision hash have to
+// see actors that don't collide.  Actors bigger than a cell are kept in
+// a list of their own which every query looks at.
+//
+class ENGINE_API FActorLocationGrid
+{
+public:
+	// Constants.
+	enum { NUM_CELLS = 4096              };
+	enum { CELL_BITS = 8                 };
+	enum { CELL_MASK = (1<<CELL_BITS)-1  };
+	enum { GRAN      = 512               };
+	enum { WORLD_OFS = 65536             };
+
+	// One actor's entry in a cell.
+	struct FGridRecord
+	{
+		AActor*	Actor;		// The actor.
+		INT		iCell;		// Packed coordinates of its cell, or INDEX_NONE if oversize.
+		DWORD	Seq;		// Where it comes in the level's actor list, from ULevel::GetActorSeq.
+	};
+
+	// Constructor.
+	FActorLocationGrid( class ULevel* Level );
+	~FActorLocationGrid();
+
+	// FActorLocationGrid interface.
+	void AddActor( AActor* Actor, DWORD Seq );
+	void RemoveActor( AActor* Actor );
+	void RefileActor( AActor* Actor );
+	INT GatherActors( FMemStack& Mem, FVector Location, FLOAT Radius, UBOOL bAddCollisionRadius, FGridRecord*& Result );
+
+	// Bumped whenever an actor is added, moved or resized.
+	DWORD Changes;
+
+private:
+	// A cell's records, and the oversize list after the last cell.  Never
+	// shrinks, so actors moving in and out of a cell don't churn the allocator.
+	struct FGridCell
+	{
+		FGridRecord*	Records;
+		INT				Num;
+		INT				Max;
+	} Cells[NUM_CELLS+1];
+
+	// Where each actor is filed, by object index.  Seq is 0 if it isn't.
+	TArray<FGridRecord> Filed;
+
+	// Implementation.
+	INT GetActorCell( AActor* Actor );
+	FGridCell& GetCell( INT iCell )
+	{
+		return iCell==INDEX_NONE ? Cells[NUM_CELLS] : Cells[ ((DWORD)iCell*2654435761u >> 20) & (NUM_CELLS-1) ];
+	}
+	void FileRecord( const FGridRecord& Rec );
+	void UnfileRecord( const FGridRecord& Rec );
+};
+
 //
 // The level object.  Contains the level's actor list, Bsp information, and brush list.
 //
@@ -149,7 +414,93 @@ class ENGINE_API ULevel : public ULevelBase
 	INT iFirstDynamicActor, NetTag;
 	BYTE ZoneDist[64][64];
 
+	// Actor scheduling, only valid in memory.
+	FTimerWheel* TimerWheel;
+	TArray<FActorSchedule> ActorSchedule;
+	FLOAT ScheduleTime, ScheduleDelta, NextParkCheck;
+	INT NumParked;
+	UBOOL bNoParking;
+	TArray<AActor*> TickList;
+	INT NumTickHoles, NumLiveActors;
+	UBOOL bTickListValid;
+
+	// Actor region cache, only valid in memory.
+	TArray<FActorRegionCache> ActorRegions;
+	UBOOL bNoRegionCache;
+	INT TotalRegionHits, TotalRegionLookups;
+
+	// Line of sight cache, only valid in memory.
+	TArray<FActorSightCache> ActorSights;
+	UBOOL bNoSightCache;
+	FLOAT SightTolerance, SightLifetime;	// Zero for the defaults.
+	INT TotalSightHits, TotalSightLookups, TotalSightTraces;
+
+	// Network relevancy cache, only valid in memory.
+	TArray<FActorRelevancy> ActorRelevancy;
+	FRelevancyViewer RelevancyViewers[MAX_RELEVANCY_VIEWERS];
+	UBOOL bNoRelevancyCache;
+	UBOOL bRelevancyCull;							// Cull by zone and distance before tracing.
+	FLOAT RelevancyTolerance, RelevancyLifetime;	// Zero for the defaults.
+	FLOAT RelevancyDistance;						// Zero for no limit.
+	INT TotalRelevancyHits, TotalRelevancyLookups, TotalRelevancyCulled, TotalRelevancyTraces;
+
+	// Replicated property change tracking, only valid in memory.
+	TArray<FActorRepState> ActorRepStates;
+	INT RepSerial;
+	UBOOL bNoRepTracking;
+	INT TotalRepSkipped, TotalRepPartial, TotalRepFull;
+
+	// Batched projectile sweeps, only valid during the actor tick.
+	FProjectileSweep* ProjectileSweeps;
+	INT NumProjectileSweeps;
+	UBOOL bNoProjectileBatch;
+
+	// Actor indices for AllActors, only valid in memory.
+	TArray<FActorIndex> ActorIndices;
+	TArray<INT> ClassIndexSlots, TagIndexSlots;
+	TArray<FActorIndexInfo> ActorIndexInfo;
+	UBOOL bActorIndexValid, bNoActorIndex;
+
+	// Actor location grid for the radius iterators, only valid in memory.
+	FActorLocationGrid* ActorGrid;
+	UBOOL bNoActorGrid;
+
+	// AI route planner, only valid in memory.
+	class FRoutePlanner* RoutePlanner;
+	UBOOL bNoRoutePlanner;
+	UBOOL bNoRouteTable;
+
+	// AI update scheduler, only valid in memory.
+	TArray<FVector> AIViewers;
+	TArray<APawn*> SenseQueue;
+	UBOOL bNoAISchedule;
+	FLOAT AINearDist, AIFarDist, AIMidInterval, AIFarInterval, AISenseBudget;	// Zero for the defaults.
+
+	// Actor list bookkeeping, only valid in memory.
+	TArray<FActorSlot> ActorSlots;
+	TArray<INT> FreeActorSlots;
+	TArray<AActor*> LiveActors;
+	INT NumActorHoles;
+	UBOOL bOwnedCountsValid, bLiveActorsValid, bNoActorSlots;
+
+	// The listed actors in the order they were listed, which a spawned
+	// actor filling a free slot doesn't change.  Only kept during play.
+	FActorIndex ActorOrder;
+	DWORD NextListSeq;
+	UBOOL bActorOrderValid;
+
+	// Classes of the server support actors, which keep ticking while a
+	// dedicated server hibernates.
+	TArray<UClass*> ServerActorClasses;
+	UBOOL bHibernating;
+
+	// Actor recycling pools, only valid in memory.
+	TArray<FActorPool> ActorPools;
+	UBOOL bActorPoolsConfigured, bNoActorPool;
+
 	// Temporary stats.
+	INT NumWoken, NumTicked, NumRegionHits, NumRegionLookups, NumSweepsBatched, NumSweepsUsed, NumSightHits, NumSightLookups, NumSightTraces;
+	INT NumAISkipped, NumAISensed, AITickCycles, NumPoolHits, NumPoolSpawns, NumRelevancyHits, NumRelevancyCulled, NumRelevancyTraces;
 	INT NetTickCycles, ActorTickCycles, AudioTickCycles, FindPathCycles, MoveCycles, NumMoves, NumReps, NumPV, GetRelevantCycles, NumRPC, SeePlayer, Spawning, Unused;
 
 	// Constructor.
@@ -181,11 +532,33 @@ class ENGINE_API ULevel : public ULevelBase
 	virtual UBOOL DropToFloor( AActor* Actor );
 	virtual UBOOL DestroyActor( AActor* Actor, UBOOL bNetForce=0 );
 	virtual void CleanupDestroyed( UBOOL bForce );
+	virtual void NoteActorSlot( AActor* Actor, INT iActor, UBOOL bSpawned=0 );
+	virtual INT CountOwned( AActor* Actor );
+	virtual void NoteOwnerChange( AActor* OldOwner, AActor* NewOwner );
+	virtual void NoteOneWayTouch( AActor* Actor );
+	virtual TArray<AActor*>* GetLiveActors();
+	virtual void FlushLiveActors();
+	virtual void ConfigureActorPools();
+	virtual FActorPool* FindActorPool( UClass* Class );
+	virtual void SetActorPool( UClass* Class, INT Max );
+	virtual UBOOL RecycleActor( AActor* Actor );
+	virtual void TrimActorPool( FActorPool& Pool, INT Max );
+	virtual void FlushActorPools();
 	virtual AActor* SpawnActor( UClass* Class, FName InName=NAME_None, AActor* Owner=NULL, class APawn* Instigator=NULL, FVector Location=FVector(0,0,0), FRotator Rotation=FRotator(0,0,0), AActor* Template=NULL, UBOOL bIsPlayer=0, UBOOL bNoCollisionFail=0, UBOOL bRemoteOwned=0 );
 	virtual ABrush*	SpawnBrush();
 	virtual void SpawnViewActor( UViewport* Viewport );
 	virtual APlayerPawn* SpawnPlayActor( UPlayer* Viewport, ENetRole RemoteRole, const FURL& URL, FString Items, char* Error256 );
 	virtual void SetActorZone( AActor* Actor, UBOOL bTest=0, UBOOL bForceRefresh=0 );
+	virtual FPointRegion CachedPointRegion( AActor* Actor, INT Slot, FVector Location );
+	virtual void FlushRegionCache( AActor* Actor );
+	virtual INT FindCachedSight( AActor* Viewer, AActor* Target, INT Variant );
+	virtual void CacheSight( AActor* Viewer, AActor* Target, INT Variant, INT Result );
+	virtual void FlushSightCache( AActor* Actor );
+	virtual INT FindRelevancyViewer( AActor* Viewer, FVector Location, UBOOL& bReset );
+	virtual void FlushRelevancyCache( AActor* Actor );
+	virtual UBOOL ZoneVisibilityBuilt();
+	virtual FActorRepState* UpdateRepState( AActor* Actor );
+	virtual void FlushRepState( AActor* Actor );
 	virtual UBOOL FindSpot( FVector Extent, FVector& Location, UBOOL bCheckActors, UBOOL bAssumeFit );
 	virtual void AdjustSpot( FVector &Adjusted, FVector TraceDest, FLOAT TraceLen, FCheckResult &Hit );
 	virtual UBOOL CheckEncroachment( AActor* Actor, FVector TestLocation, FRotator TestRotation, UBOOL bTouchNotify );
@@ -194,9 +567,37 @@ class ENGINE_API ULevel : public ULevelBase
 	virtual UBOOL SingleLineCheck( FCheckResult& Hit, AActor* SourceActor, const FVector& End, const FVector& Start, DWORD TraceFlags, FVector Extent=FVector(0,0,0), BYTE NodeFlags=0 );
 	virtual FCheckResult* MultiPointCheck( FMemStack& Mem, FVector Location, FVector Extent, DWORD ExtraNodeFlags, ALevelInfo* Level, UBOOL bActors );
 	virtual FCheckResult* MultiLineCheck( FMemStack& Mem, FVector End, FVector Start, FVector Size, UBOOL bCheckActors, ALevelInfo* LevelInfo, BYTE ExtraNodeFlags );
+	virtual INT BatchLineCheck( FCheckResult* Hits, const FTraceRequest* Requests, INT Count );
+	virtual void BatchProjectileSweeps( FLOAT DeltaSeconds );
 	virtual void InitStats();
 	virtual void GetStats( char* Result );
 	virtual void DetailChange( UBOOL NewDetail );
+	virtual void ParkActor( AActor* Actor, FLOAT WakeDelay );
+	virtual void UnparkActor( AActor* Actor );
+	virtual void UnparkAllActors();
+	virtual void TickParkedActors( FLOAT DeltaSeconds );
+	virtual void UpdateTickList();
+	virtual void AddToTickList( AActor* Actor );
+	virtual void RemoveFromTickList( AActor* Actor );
+	virtual void UpdateAIViewers();
+	virtual UBOOL ScheduleAI( APawn* Pawn, FLOAT& DeltaSeconds );
+	virtual void AITicked( APawn* Pawn );
+	virtual void UnscheduleAI( AActor* Actor );
+	virtual UBOOL QueueSense( APawn* Pawn );
+	virtual void TickSenseQueue();
+	virtual INT FindActorIndex( UClass* Class, FName Tag );
+	virtual AActor* NextIndexedActor( INT iIndex, INT& iEntry, DWORD& LastSeq );
+	virtual void IndexActor( AActor* Actor );
+	virtual void UnindexActor( AActor* Actor );
+	virtual void ActorTagChanged( AActor* Actor );
+	virtual void PurgeActorIndices();
+	virtual void FlushActorIndices();
+	virtual void BuildActorOrder();
+	virtual void FlushActorOrder();
+	virtual DWORD GetActorSeq( AActor* Actor );
+	virtual AActor* NextListedActor( INT& iNext, DWORD& LastSeq );
+	virtual FActorLocationGrid* GetActorGrid();
+	virtual class FRoutePlanner* GetRoutePlanner();
 
 	// FNetworkNotify interface.
 	EAcceptConnection NotifyAcceptingConnection();
@@ -220,9 +621,22 @@ class ENGINE_API ULevel : public ULevelBase
 	INT GetActorIndex( AActor* Actor )
 	{
 		guard(ULevel::GetActorIndex);
+		INT Index = Actor->GetIndex();
+		if( Index<ActorSlots.Num() && !bNoActorSlots )
+		{
+			INT iActor = ActorSlots(Index).iActor - 1;
+			if( iActor>=0 && iActor<Num() && Actors(iActor)==Actor )
+				return iActor;
+		}
 		for( int i=0; i<Num(); i++ )
+		{
 			if( Actors(i) == Actor )
+			{
+				if( Index<ActorSlots.Num() )
+					ActorSlots(Index).iActor = i+1;
 				return i;
+			}
+		}
 		appErrorf( "Actor not found: %s", Actor->GetFullName() );
 		return INDEX_NONE;
 		unguard;
@@ -241,6 +655,11 @@ class ENGINE_API ULevel : public ULevelBase
 		return Model->Nodes->Zones[iZone].ZoneActor ? Model->Nodes->Zones[iZone].ZoneActor : GetLevelInfo();
 		unguardSlow;
 	}
+	UBOOL IsParked( AActor* Actor )
+	{
+		DWORD Index = Actor->GetIndex();
+		return Index<(DWORD)ActorSchedule.Num() && ActorSchedule(Index).bParked;
+	}
 	AActor*& Actors( int i )
 	{
 		return Element(i);
@@ -251,6 +670,52 @@ class ENGINE_API ULevel : public ULevelBase
 	Iterators.
 -----------------------------------------------------------------------------*/
 
+//
+// Iterate through the actors matching an AllActors query, in the order the
+// level listed them.  A spawned actor may fill the slot of a destroyed one,
+// but still comes after the actors listed before it.  Walks the level's
+// actor indices when it can, and falls back to walking every listed actor
+// in the same order when it can't.
+//
+class ENGINE_API FActorQuery
+{
+public:
+	FActorQuery( ULevel* InLevel, UClass* InClass, FName InTag );
+	AActor* Next();
+private:
+	ULevel*	Level;
+	UClass*	Class;
+	FName	Tag;
+	INT		iIndex, iNext;
+	DWORD	LastSeq;
+};
+
+//
+// Iterate through the actors within a radius of a point, in the order the
+// level lists them, for RadiusActors and VisibleActors.  Gathers nearby
+// actors from the level's location grid onto a memory stack, which the
+// caller must mark and pop, and gathers them again whenever an actor has
+// been spawned, moved or resized since, so that the loop's body sees the
+// same actors a scan of the list would.  A radius of zero means no limit.
+//
+class ENGINE_API FRadiusActorQuery
+{
+public:
+	FRadiusActorQuery( FMemStack& InMem, ULevel* InLevel, UClass* InClass, FVector InLocation, FLOAT InRadius, UBOOL InAddCollisionRadius );
+	AActor* Next();
+private:
+	ULevel*		Level;
+	UClass*		Class;
+	FVector		Location;
+	FLOAT		Radius;
+	UBOOL		bAddCollisionRadius;
+	FMemStack*	Mem;
+	FActorLocationGrid* Grid;
+	FActorLocationGrid::FGridRecord* Found;
+	INT			NumFound, iFound, iScan;
+	DWORD		Changes, LastSeq;
+};
+
 //
 // Iterate through all static brushes in a level.
 //
@@ -82,6 +82,7 @@ class ENGINE_API UModel : public UPrimitive
 	typedef void (*PLANE_FILTER_CALLBACK )(UModel *Model, INT iNode, int Param);
 	typedef void (*SPHERE_FILTER_CALLBACK)(UModel *Model, INT iNode, int IsBack, int Outside, int Param);
 	FPointRegion PointRegion( AZoneInfo* Zone, FVector Location ) const;
+	FPointRegion PointRegion( AZoneInfo* Zone, FVector Location, FLOAT& SafeRadius ) const;
 	FLOAT FindNearestVertex
 	(
 		const FVector	&SourcePoint,
@@ -104,6 +105,9 @@ class ENGINE_API UModel : public UPrimitive
 	}
 };
 
+// Whether UModel traces use the original recursive traversal (-OLDTRACE).
+ENGINE_API extern UBOOL GRecursiveTrace;
+
 /*----------------------------------------------------------------------------
 	The End.
 ----------------------------------------------------------------------------*/
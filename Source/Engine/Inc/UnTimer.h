@@ -0,0 +1,69 @@
+/*=============================================================================
+	UnTimer.h: Hierarchical timer wheel used by the level's actor scheduler.
+	Copyright 1997 Epic MegaGames, Inc. This software is a trade secret.
+=============================================================================*/
+
+/*-----------------------------------------------------------------------------
+	FTimerWheel.
+-----------------------------------------------------------------------------*/
+
+//
+// A three-level hashed timer wheel with an overflow list.
+//
+// Time is quantized into jiffies of 1/TIMER_HZ seconds, always rounding
+// down so that a timer never expires late.  Scheduling and cancelling are
+// O(1); advancing costs one slot per elapsed jiffy plus an occasional
+// cascade of a higher level into the levels below it.
+//
+// Nodes are referenced by index; index 0 is never handed out so that a
+// zeroed handle means "not scheduled".
+//
+class ENGINE_API FTimerWheel
+{
+public:
+	// Constants.
+	enum {TIMER_HZ   = 64  };	// Jiffies per second.
+	enum {WHEEL0_BITS= 8   };	// Level 0 covers 4 seconds at one jiffy per slot.
+	enum {WHEEL_BITS = 6   };	// Levels 1 and 2 cover 256 seconds and 4.5 hours.
+	enum {WHEEL0_SIZE= 1<<WHEEL0_BITS };
+	enum {WHEEL_SIZE = 1<<WHEEL_BITS  };
+	enum {NUM_SLOTS  = WHEEL0_SIZE + 2*WHEEL_SIZE + 1 };
+
+	// Constructor.
+	FTimerWheel();
+
+	// FTimerWheel interface.
+	INT Schedule( AActor* Actor, FLOAT Time );
+	void Cancel( INT iNode );
+	void Advance( FLOAT Time, TArray<AActor*>& Expired );
+	void Empty();
+	INT Num() const {return NumScheduled;}
+	static INT ToJiffies( FLOAT Time ) {return appFloor( Time * TIMER_HZ );}
+
+private:
+	// A scheduled timer.
+	struct FNode
+	{
+		AActor*	Actor;		// Actor to wake, NULL if free.
+		INT		Expire;		// Expiration jiffy.
+		INT		Next;		// Next node in slot or free list.
+		INT		Prev;		// Previous node in slot.
+		INT		Slot;		// Slot containing this node, INDEX_NONE if free.
+	};
+
+	// Variables.
+	TArray<FNode> Nodes;
+	INT Slots[NUM_SLOTS];
+	INT FirstFree;
+	INT Current;
+	INT NumScheduled;
+
+	// Internal functions.
+	void Link( INT iNode );
+	void Unlink( INT iNode );
+	void Cascade( INT iSlot );
+};
+
+/*-----------------------------------------------------------------------------
+	The End.
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,588 @@
+/*=============================================================================
+	UnActGrid.cpp: Uniform grid actor collision hash.
+	Copyright 1997 Epic MegaGames, Inc. This software is a trade secret.
+
+Design goal:
+	A replacement for FCollisionHash with the same interface.  Each grid
+	cell holds a flat array of compact records carrying the actor's bounds,
+	location and collision size, so the broad phase of every check runs over
+	contiguous memory and only dereferences actors which survive it.
+
+	An actor spanning several cells has a record in each of them.  Rather
+	than tagging actors to skip repeats, a check only accepts a record in
+	the one cell containing the minimum corner of the overlap between the
+	actor's bounds and the query's bounds, so actors are never touched just
+	to find out that they've been seen.  Cells hash into a fixed number of
+	buckets, so a check also skips records which belong to another cell
+	sharing the bucket being scanned.
+=============================================================================*/
+
+#include "EnginePrivate.h"
+#include "UnSIMD.h"
+
+/*-----------------------------------------------------------------------------
+	FCollisionGrid.
+-----------------------------------------------------------------------------*/
+
+//
+// A collision grid.
+//
+class ENGINE_API FCollisionGrid : public FCollisionHashBase
+{
+public:
+	// FCollisionHashBase interface.
+	FCollisionGrid();
+	~FCollisionGrid();
+	void Tick();
+	void AddActor( AActor *Actor );
+	void RemoveActor( AActor *Actor );
+	FCheckResult* ActorLineCheck( FMemStack& Mem, FVector End, FVector Start, FVector Extent, BYTE ExtraNodeFlags );
+	FCheckResult* ActorPointCheck( FMemStack& Mem, FVector Location, FVector Extent, DWORD ExtraNodeFlags );
+	FCheckResult* ActorRadiusCheck( FMemStack& Mem, FVector Location, FLOAT Radius, DWORD ExtraNodeFlags );
+	FCheckResult* ActorEncroachmentCheck( FMemStack& Mem, AActor* Actor, FVector Location, FRotator Rotation, DWORD ExtraNodeFlags );
+	void CheckActorNotReferenced( AActor* Actor );
+
+	// Constants.
+	enum { NUM_CELLS  = 16384              };
+	enum { CELL_BITS  = 10                 };
+	enum { CELL_MASK  = (1<<CELL_BITS)-1   };
+	enum { GRAN       = 256                };
+	enum { WORLD_OFS  = 65536              };
+
+	// One actor's entry in a cell, 16-byte vectors first.
+	struct FGridRecord
+	{
+		FLOAT	Min[4];			// Bounds minimum; W is CollisionRadius.
+		FLOAT	Max[4];			// Bounds maximum; W is CollisionHeight.
+		FLOAT	Location[3];	// Actor location.
+		INT		iCell;			// Packed coordinates of the cell this record is in.
+		AActor*	Actor;			// The actor.
+		UBOOL	bCylinder;		// Whether the actor's primitive is a plain cylinder.
+	};
+
+	// A cell's records.  Never shrinks, so actors moving in and out of a
+	// cell every frame don't churn the allocator.
+	struct FGridCell
+	{
+		FGridRecord*	Records;
+		INT				Num;
+		INT				Max;
+	} Cells[NUM_CELLS];
+
+	// Implementation.
+	void GetActorBounds( AActor* Actor, FLOAT* Min, FLOAT* Max );
+	void GetCellIndices( const FLOAT* P, INT& iX, INT& iY, INT& iZ )
+	{
+		iX = (INT)Clamp( (P[0] + WORLD_OFS) * (1.f/GRAN), 0.f, (FLOAT)CELL_MASK );
+		iY = (INT)Clamp( (P[1] + WORLD_OFS) * (1.f/GRAN), 0.f, (FLOAT)CELL_MASK );
+		iZ = (INT)Clamp( (P[2] + WORLD_OFS) * (1.f/GRAN), 0.f, (FLOAT)CELL_MASK );
+	}
+	FGridCell& GetCell( INT iX, INT iY, INT iZ )
+	{
+		return Cells[ ((DWORD)iX*73856093u ^ (DWORD)iY*19349663u ^ (DWORD)iZ*83492791u) & (NUM_CELLS-1) ];
+	}
+	static INT PackCell( INT iX, INT iY, INT iZ )
+	{
+		return iX + (iY << CELL_BITS) + (iZ << (CELL_BITS*2));
+	}
+	UBOOL IsHomeCell( const FGridRecord& Rec, const FLOAT* QueryMin, INT iScanCell )
+	{
+		// The cell being scanned, and the one containing the minimum corner
+		// of the overlap.
+		if( Rec.iCell!=iScanCell )
+			return 0;
+		FLOAT Corner[3] = { ::Max(Rec.Min[0],QueryMin[0]), ::Max(Rec.Min[1],QueryMin[1]), ::Max(Rec.Min[2],QueryMin[2]) };
+		INT iX, iY, iZ;
+		GetCellIndices( Corner, iX, iY, iZ );
+		return Rec.iCell==PackCell( iX, iY, iZ );
+	}
+};
+
+ENGINE_API FCollisionHashBase* GNewCollisionGrid()
+{
+	guard(GNewCollisionGrid);
+	return new FCollisionGrid;
+	unguard;
+}
+
+// Global statistics.
+static INT GGridActorsAdded=0, GGridRecords=0, GGridChecks=0, GGridCandidates=0;
+
+/*-----------------------------------------------------------------------------
+	Overlap tests.
+-----------------------------------------------------------------------------*/
+
+//
+// Query parameters for a swept box, in the layout the tests want.
+//
+struct FGridSegment
+{
+	FLOAT Start[4];		// Segment start.
+	FLOAT InvDir[4];	// Reciprocal of End-Start, huge where that is zero.
+	FLOAT Extent[4];	// Box half-size plus slop.
+};
+
+//
+// Whether the XYZ parts of two boxes overlap.  W is ignored.
+//
+static inline UBOOL GridBoxesOverlap( const FLOAT* AMin, const FLOAT* AMax, const FLOAT* BMin, const FLOAT* BMax )
+{
+#if ENGINE_SSE
+	__m128 Lo = _mm_cmple_ps( _mm_loadu_ps(AMin), _mm_loadu_ps(BMax) );
+	__m128 Hi = _mm_cmple_ps( _mm_loadu_ps(BMin), _mm_loadu_ps(AMax) );
+	return (_mm_movemask_ps( _mm_and_ps(Lo,Hi) ) & 7)==7;
+#elif ENGINE_NEON
+	uint32x4_t Both = vandq_u32( vcleq_f32(vld1q_f32(AMin),vld1q_f32(BMax)), vcleq_f32(vld1q_f32(BMin),vld1q_f32(AMax)) );
+	return vgetq_lane_u32(Both,0) && vgetq_lane_u32(Both,1) && vgetq_lane_u32(Both,2);
+#else
+	return AMin[0]<=BMax[0] && AMin[1]<=BMax[1] && AMin[2]<=BMax[2]
+		&& BMin[0]<=AMax[0] && BMin[1]<=AMax[1] && BMin[2]<=AMax[2];
+#endif
+}
+
+//
+// Whether a box swept along a segment touches the XYZ part of a box,
+// by slab intersection.  Conservative: Extent includes slop.
+//
+static inline UBOOL GridSegmentHitsBox( const FGridSegment& Seg, const FLOAT* Min, const FLOAT* Max )
+{
+	FLOAT T0[4], T1[4];
+#if ENGINE_SSE
+	__m128 Start  = _mm_loadu_ps( Seg.Start  );
+	__m128 InvDir = _mm_loadu_ps( Seg.InvDir );
+	__m128 Extent = _mm_loadu_ps( Seg.Extent );
+	__m128 A      = _mm_mul_ps( _mm_sub_ps( _mm_sub_ps(_mm_loadu_ps(Min),Extent), Start ), InvDir );
+	__m128 B      = _mm_mul_ps( _mm_sub_ps( _mm_add_ps(_mm_loadu_ps(Max),Extent), Start ), InvDir );
+	_mm_storeu_ps( T0, _mm_min_ps(A,B) );
+	_mm_storeu_ps( T1, _mm_max_ps(A,B) );
+#elif ENGINE_NEON
+	float32x4_t Start  = vld1q_f32( Seg.Start  );
+	float32x4_t InvDir = vld1q_f32( Seg.InvDir );
+	float32x4_t Extent = vld1q_f32( Seg.Extent );
+	float32x4_t A      = vmulq_f32( vsubq_f32( vsubq_f32(vld1q_f32(Min),Extent), Start ), InvDir );
+	float32x4_t B      = vmulq_f32( vsubq_f32( vaddq_f32(vld1q_f32(Max),Extent), Start ), InvDir );
+	vst1q_f32( T0, vminq_f32(A,B) );
+	vst1q_f32( T1, vmaxq_f32(A,B) );
+#else
+	for( INT i=0; i<3; i++ )
+	{
+		FLOAT A = (Min[i] - Seg.Extent[i] - Seg.Start[i]) * Seg.InvDir[i];
+		FLOAT B = (Max[i] + Seg.Extent[i] - Seg.Start[i]) * Seg.InvDir[i];
+		T0[i]   = ::Min( A, B );
+		T1[i]   = ::Max( A, B );
+	}
+#endif
+	FLOAT Enter = ::Max( ::Max(T0[0],T0[1]), ::Max(T0[2],0.f) );
+	FLOAT Leave = ::Min( ::Min(T1[0],T1[1]), ::Min(T1[2],1.f) );
+	return Enter<=Leave;
+}
+
+/*-----------------------------------------------------------------------------
+	FCollisionGrid init/exit.
+-----------------------------------------------------------------------------*/
+
+//
+// Initialize the actor collision information.
+//
+FCollisionGrid::FCollisionGrid()
+{
+	guard(FCollisionGrid::FCollisionGrid);
+	appMemset( Cells, 0, sizeof(Cells) );
+	unguard;
+}
+
+//
+// Shut down the actor collision information.
+//
+FCollisionGrid::~FCollisionGrid()
+{
+	guard(FCollisionGrid::~FCollisionGrid);
+	for( INT i=0; i<NUM_CELLS; i++ )
+		if( Cells[i].Records )
+			appFree( Cells[i].Records );
+	unguard;
+}
+
+/*-----------------------------------------------------------------------------
+	FCollisionGrid tick.
+-----------------------------------------------------------------------------*/
+
+//
+// Per-frame update.
+//
+void FCollisionGrid::Tick()
+{
+	guard(FCollisionGrid::Tick);
+
+	// All we do here is stats.
+	//debugf(NAME_Log,"Records=%i Added=%i Checks=%i Candidates=%i",GGridRecords,GGridActorsAdded,GGridChecks,GGridCandidates);
+	GGridActorsAdded = GGridChecks = GGridCandidates = 0;
+
+	unguard;
+}
+
+/*-----------------------------------------------------------------------------
+	FCollisionGrid adding/removing.
+-----------------------------------------------------------------------------*/
+
+//
+// Compute an actor's bounds: its primitive's collision box, grown to
+// contain its collision cylinder so cylinder tests against the record are
+// always within it.
+//
+void FCollisionGrid::GetActorBounds( AActor* Actor, FLOAT* Min, FLOAT* Max )
+{
+	guard(FCollisionGrid::GetActorBounds);
+	FBox   Box    = Actor->GetPrimitive()->GetCollisionBoundingBox( Actor );
+	FVector Extent = Actor->GetCylinderExtent();
+	Min[0] = ::Min( Box.Min.X, Actor->Location.X - Extent.X );
+	Min[1] = ::Min( Box.Min.Y, Actor->Location.Y - Extent.Y );
+	Min[2] = ::Min( Box.Min.Z, Actor->Location.Z - Extent.Z );
+	Max[0] = ::Max( Box.Max.X, Actor->Location.X + Extent.X );
+	Max[1] = ::Max( Box.Max.Y, Actor->Location.Y + Extent.Y );
+	Max[2] = ::Max( Box.Max.Z, Actor->Location.Z + Extent.Z );
+	unguard;
+}
+
+//
+// Add an actor to the collision info.
+//
+void FCollisionGrid::AddActor( AActor *Actor )
+{
+	guard(FCollisionGrid::AddActor);
+	check(Actor->bCollideActors);
+	if( Actor->bDeleteMe )
+		return;
+	CheckActorNotReferenced( Actor );
+	GGridActorsAdded++;
+
+	// Build the record.
+	FGridRecord Rec;
+	GetActorBounds( Actor, Rec.Min, Rec.Max );
+	Rec.Min[3]      = Actor->CollisionRadius;
+	Rec.Max[3]      = Actor->CollisionHeight;
+	Rec.Location[0] = Actor->Location.X;
+	Rec.Location[1] = Actor->Location.Y;
+	Rec.Location[2] = Actor->Location.Z;
+	Rec.Actor       = Actor;
+	Rec.bCylinder   = !Actor->Brush;
+
+	// Add it to every cell the bounds touch.
+	INT X0,Y0,Z0,X1,Y1,Z1;
+	GetCellIndices( Rec.Min, X0, Y0, Z0 );
+	GetCellIndices( Rec.Max, X1, Y1, Z1 );
+	for( INT X=X0; X<=X1; X++ ) for( INT Y=Y0; Y<=Y1; Y++ ) for( INT Z=Z0; Z<=Z1; Z++ )
+	{
+		FGridCell& Cell = GetCell( X, Y, Z );
+		if( Cell.Num==Cell.Max )
+		{
+			Cell.Max     = Cell.Max ? Cell.Max*2 : 4;
+			Cell.Records = (FGridRecord*)appRealloc( Cell.Records, Cell.Max*sizeof(FGridRecord), "CollisionGridCell" );
+		}
+		FGridRecord& New = Cell.Records[Cell.Num++];
+		New       = Rec;
+		New.iCell = PackCell( X, Y, Z );
+		GGridRecords++;
+	}
+	Actor->ColLocation = Actor->Location;
+	unguard;
+}
+
+//
+// Remove an actor from the collision info.
+//
+void FCollisionGrid::RemoveActor( AActor* Actor )
+{
+	guard(FCollisionGrid::RemoveActor);
+	check(Actor->bCollideActors);
+	if( Actor->bDeleteMe )
+		return;
+	if( Actor->Location!=Actor->ColLocation )
+		appErrorf( "%s moved without proper hashing", Actor->GetFullName() );
+
+	// Remove the actor's records from every cell it was added to.
+	FLOAT Min[3], Max[3];
+	INT X0,Y0,Z0,X1,Y1,Z1;
+	GetActorBounds( Actor, Min, Max );
+	GetCellIndices( Min, X0, Y0, Z0 );
+	GetCellIndices( Max, X1, Y1, Z1 );
+	for( INT X=X0; X<=X1; X++ ) for( INT Y=Y0; Y<=Y1; Y++ ) for( INT Z=Z0; Z<=Z1; Z++ )
+	{
+		FGridCell& Cell = GetCell( X, Y, Z );
+		for( INT i=0; i<Cell.Num; )
+		{
+			if( Cell.Records[i].Actor==Actor )
+			{
+				Cell.Records[i] = Cell.Records[--Cell.Num];
+				GGridRecords--;
+			}
+			else i++;
+		}
+	}
+	CheckActorNotReferenced( Actor );
+	unguard;
+}
+
+/*-----------------------------------------------------------------------------
+	FCollisionGrid collision checking.
+-----------------------------------------------------------------------------*/
+
+//
+// Make a list of all actors which overlap with a cylinder at Location
+// with the given collision size.
+//
+FCheckResult* FCollisionGrid::ActorPointCheck
+(
+	FMemStack&		Mem,
+	FVector			Location,
+	FVector			Extent,
+	DWORD			ExtraNodeFlags
+)
+{
+	guard(FCollisionGrid::ActorPointCheck);
+	FCheckResult* Result=NULL;
+	GGridChecks++;
+
+	// Query bounds.
+	FLOAT QMin[4] = { Location.X-Extent.X, Location.Y-Extent.Y, Location.Z-Extent.Z, 0.f };
+	FLOAT QMax[4] = { Location.X+Extent.X, Location.Y+Extent.Y, Location.Z+Extent.Z, 0.f };
+	INT X0,Y0,Z0,X1,Y1,Z1;
+	GetCellIndices( QMin, X0, Y0, Z0 );
+	GetCellIndices( QMax, X1, Y1, Z1 );
+
+	// Check all actors in this neighborhood.
+	for( INT X=X0; X<=X1; X++ ) for( INT Y=Y0; Y<=Y1; Y++ ) for( INT Z=Z0; Z<=Z1; Z++ )
+	{
+		FGridCell& Cell  = GetCell( X, Y, Z );
+		INT        iCell = PackCell( X, Y, Z );
+		for( INT i=0; i<Cell.Num; i++ )
+		{
+			const FGridRecord& Rec = Cell.Records[i];
+			if( !GridBoxesOverlap( Rec.Min, Rec.Max, QMin, QMax ) || !IsHomeCell( Rec, QMin, iCell ) )
+				continue;
+
+			// Cylinders can be rejected exactly without touching the actor.
+			if
+			(	Rec.bCylinder
+			&&	(	Square(Rec.Location[2]-Location.Z) >= Square(Rec.Max[3]+Extent.Z)
+				||	Square(Rec.Location[0]-Location.X)+Square(Rec.Location[1]-Location.Y) >= Square(Rec.Min[3]+Extent.X) ) )
+				continue;
+
+			// Collision test.
+			GGridCandidates++;
+			FCheckResult TestHit(1.0);
+			if( Rec.Actor->GetPrimitive()->PointCheck( TestHit, Rec.Actor, Location, Extent, 0 )==0 )
+			{
+				check(TestHit.Actor==Rec.Actor);
+				FCheckResult* New = new(GMem)FCheckResult;
+				*New = TestHit;
+				New->GetNext() = Result;
+				Result = New;
+			}
+		}
+	}
+	return Result;
+	unguard;
+}
+
+//
+// Make a list of all actors which are within a given radius.
+//
+FCheckResult* FCollisionGrid::ActorRadiusCheck
+(
+	FMemStack&		Mem,
+	FVector			Location,
+	FLOAT			Radius,
+	DWORD			ExtraNodeFlags
+)
+{
+	guard(FCollisionGrid::ActorRadiusCheck);
+	FCheckResult* Result=NULL;
+	GGridChecks++;
+
+	// Query bounds.
+	FLOAT QMin[4] = { Location.X-Radius, Location.Y-Radius, Location.Z-Radius, 0.f };
+	FLOAT QMax[4] = { Location.X+Radius, Location.Y+Radius, Location.Z+Radius, 0.f };
+	INT X0,Y0,Z0,X1,Y1,Z1;
+	GetCellIndices( QMin, X0, Y0, Z0 );
+	GetCellIndices( QMax, X1, Y1, Z1 );
+	FLOAT RadiusSq = Radius * Radius;
+
+	// Check all actors in this neighborhood, entirely from the records.
+	for( INT X=X0; X<=X1; X++ ) for( INT Y=Y0; Y<=Y1; Y++ ) for( INT Z=Z0; Z<=Z1; Z++ )
+	{
+		FGridCell& Cell  = GetCell( X, Y, Z );
+		INT        iCell = PackCell( X, Y, Z );
+		for( INT i=0; i<Cell.Num; i++ )
+		{
+			const FGridRecord& Rec = Cell.Records[i];
+			if
+			(	Square(Rec.Location[0]-Location.X) + Square(Rec.Location[1]-Location.Y) + Square(Rec.Location[2]-Location.Z) < RadiusSq
+			&&	IsHomeCell( Rec, QMin, iCell ) )
+			{
+				FCheckResult* New = new(GMem)FCheckResult;
+				New->Actor = Rec.Actor;
+				New->GetNext() = Result;
+				Result = New;
+			}
+		}
+	}
+	return Result;
+	unguard;
+}
+
+//
+// Check for encroached actors.
+//
+FCheckResult* FCollisionGrid::ActorEncroachmentCheck
+(
+	FMemStack&		Mem,
+	AActor*			Actor,
+	FVector			Location,
+	FRotator		Rotation,
+	DWORD			ExtraNodeFlags
+)
+{
+	guard(FCollisionGrid::ActorEncroachmentCheck);
+	check(Actor!=NULL);
+	GGridChecks++;
+
+	// Save actor's location and rotation.
+	Exchange( Location, Actor->Location );
+	Exchange( Rotation, Actor->Rotation );
+
+	// Get bounds at the new position.
+	FLOAT QMin[4], QMax[4];
+	INT X0,Y0,Z0,X1,Y1,Z1;
+	GetActorBounds( Actor, QMin, QMax );
+	QMin[3] = QMax[3] = 0.f;
+	GetCellIndices( QMin, X0, Y0, Z0 );
+	GetCellIndices( QMax, X1, Y1, Z1 );
+	FCheckResult *Result, **PrevLink = &Result;
+
+	// Check all actors in this neighborhood.
+	for( INT X=X0; X<=X1; X++ ) for( INT Y=Y0; Y<=Y1; Y++ ) for( INT Z=Z0; Z<=Z1; Z++ )
+	{
+		FGridCell& Cell  = GetCell( X, Y, Z );
+		INT        iCell = PackCell( X, Y, Z );
+		for( INT i=0; i<Cell.Num; i++ )
+		{
+			// Reject by the other actor's cylinder, which is what gets tested.
+			const FGridRecord& Rec = Cell.Records[i];
+			FLOAT CylMin[4] = { Rec.Location[0]-Rec.Min[3], Rec.Location[1]-Rec.Min[3], Rec.Location[2]-Rec.Max[3], 0.f };
+			FLOAT CylMax[4] = { Rec.Location[0]+Rec.Min[3], Rec.Location[1]+Rec.Min[3], Rec.Location[2]+Rec.Max[3], 0.f };
+			if( Rec.Actor==Actor || !GridBoxesOverlap( CylMin, CylMax, QMin, QMax ) || !IsHomeCell( Rec, QMin, iCell ) )
+				continue;
+
+			// Collision test.
+			GGridCandidates++;
+			FCheckResult TestHit(1.0);
+			AActor* Other = Rec.Actor;
+			if
+			(	!Other->IsMovingBrush()
+			&&	Actor->GetPrimitive()->PointCheck( TestHit, Actor, Other->Location, Other->GetCylinderExtent(), 0 )==0 )
+			{
+				TestHit.Actor     = Other;
+				TestHit.Primitive = NULL;
+				*PrevLink         = new(GMem)FCheckResult;
+				**PrevLink        = TestHit;
+				PrevLink          = &(*PrevLink)->GetNext();
+			}
+		}
+	}
+
+	// Restore actor's location and rotation.
+	Exchange( Location, Actor->Location );
+	Exchange( Rotation, Actor->Rotation );
+
+	*PrevLink = NULL;
+	return Result;
+	unguard;
+}
+
+//
+// Make a list of all actors which overlap a cylinder moving along a line
+// from Start to End.  Each record is first tested against the swept box
+// by slab intersection, so long traces only reach the actors near them.
+//
+FCheckResult* FCollisionGrid::ActorLineCheck
+(
+	FMemStack&		Mem,
+	FVector			End,
+	FVector			Start,
+	FVector			Size,
+	BYTE			ExtraNodeFlags
+)
+{
+	guard(FCollisionGrid::ActorLineCheck);
+	FCheckResult* Result=NULL;
+	GGridChecks++;
+
+	// Set up the swept box.
+	FGridSegment Seg;
+	FVector Dir = End - Start;
+	for( INT i=0; i<3; i++ )
+	{
+		Seg.Start [i] = (&Start.X)[i];
+		Seg.InvDir[i] = Abs((&Dir.X)[i])>1.e-6f ? 1.f/(&Dir.X)[i] : 1.e12f;
+		Seg.Extent[i] = (&Size.X)[i] + 1.f;
+	}
+	Seg.Start[3] = Seg.InvDir[3] = Seg.Extent[3] = 0.f;
+
+	// Get extent.
+	FBox  Box( FBox(0) + Start + End );
+	FLOAT QMin[4] = { Box.Min.X-Size.X, Box.Min.Y-Size.Y, Box.Min.Z-Size.Z, 0.f };
+	FLOAT QMax[4] = { Box.Max.X+Size.X, Box.Max.Y+Size.Y, Box.Max.Z+Size.Z, 0.f };
+	INT X0,Y0,Z0,X1,Y1,Z1;
+	GetCellIndices( QMin, X0, Y0, Z0 );
+	GetCellIndices( QMax, X1, Y1, Z1 );
+
+	// Check all potentially colliding actors in the grid.
+	for( INT X=X0; X<=X1; X++ ) for( INT Y=Y0; Y<=Y1; Y++ ) for( INT Z=Z0; Z<=Z1; Z++ )
+	{
+		FGridCell& Cell  = GetCell( X, Y, Z );
+		INT        iCell = PackCell( X, Y, Z );
+		for( INT i=0; i<Cell.Num; i++ )
+		{
+			const FGridRecord& Rec = Cell.Records[i];
+			if
+			(	!GridBoxesOverlap( Rec.Min, Rec.Max, QMin, QMax )
+			||	!IsHomeCell( Rec, QMin, iCell )
+			||	!GridSegmentHitsBox( Seg, Rec.Min, Rec.Max ) )
+				continue;
+
+			// Check collision.
+			GGridCandidates++;
+			FCheckResult Hit(0);
+			if( Rec.Actor->GetPrimitive()->LineCheck( Hit, Rec.Actor, End, Start, Size, ExtraNodeFlags )==0 )
+			{
+				FCheckResult* New = new(Mem)FCheckResult(Hit);
+				New->GetNext() = Result;
+				Result = New;
+			}
+		}
+	}
+	return Result;
+	unguard;
+}
+
+/*-----------------------------------------------------------------------------
+	Checks.
+-----------------------------------------------------------------------------*/
+
+void FCollisionGrid::CheckActorNotReferenced( AActor* Actor )
+{
+#if CHECK_ALL
+	guard(FCollisionGrid::CheckActorNotReferenced);
+	if( !GIsEditor )
+		for( INT i=0; i<NUM_CELLS; i++ )
+			for( INT j=0; j<Cells[i].Num; j++ )
+				if( Cells[i].Records[j].Actor == Actor )
+					appErrorf( "%s has collision grid records", Actor->GetFullName() );
+	unguard;
+#endif
+}
+
+/*-----------------------------------------------------------------------------
+	The End.
+-----------------------------------------------------------------------------*/
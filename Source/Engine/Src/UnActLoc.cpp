@@ -0,0 +1,331 @@
+/*=============================================================================
+	UnActLoc.cpp: Actor location grid for the radius iterators.
+	Copyright 1997 Epic MegaGames, Inc. This software is a trade secret.
+
+Design goal:
+	RadiusActors and VisibleActors used to test every actor in the level.
+	They can't use the collision hash, because they return actors that
+	don't collide, so the level keeps this grid of every actor filed by
+	location.  A query gathers the actors in the cells its sphere touches
+	and sorts them back into the order the level lists them.  If anything
+	is spawned, moved or resized while a script loops over the results,
+	the query gathers again and carries on after the last actor it gave
+	out, so scripts see the same actors in the same order as before.
+=============================================================================*/
+
+#include "EnginePrivate.h"
+
+/*-----------------------------------------------------------------------------
+	FActorLocationGrid.
+-----------------------------------------------------------------------------*/
+
+//
+// Build the grid, filing every actor in the level.
+//
+FActorLocationGrid::FActorLocationGrid( ULevel* Level )
+:	Changes( 0 )
+{
+	guard(FActorLocationGrid::FActorLocationGrid);
+	appMemset( Cells, 0, sizeof(Cells) );
+	for( INT i=0; i<Level->Num(); i++ )
+		if( Level->Actors(i) )
+			AddActor( Level->Actors(i), Level->GetActorSeq(Level->Actors(i)) );
+	unguard;
+}
+
+//
+// Free the cells.
+//
+FActorLocationGrid::~FActorLocationGrid()
+{
+	guard(FActorLocationGrid::~FActorLocationGrid);
+	for( INT i=0; i<=NUM_CELLS; i++ )
+		if( Cells[i].Records )
+			appFree( Cells[i].Records );
+	unguard;
+}
+
+//
+// Packed coordinates of the cell an actor belongs in, or INDEX_NONE if
+// it is too big to file by location.
+//
+INT FActorLocationGrid::GetActorCell( AActor* Actor )
+{
+	if( Actor->CollisionRadius > GRAN )
+		return INDEX_NONE;
+	INT iX = (INT)Clamp( (Actor->Location.X + WORLD_OFS) * (1.f/GRAN), 0.f, (FLOAT)CELL_MASK );
+	INT iY = (INT)Clamp( (Actor->Location.Y + WORLD_OFS) * (1.f/GRAN), 0.f, (FLOAT)CELL_MASK );
+	INT iZ = (INT)Clamp( (Actor->Location.Z + WORLD_OFS) * (1.f/GRAN), 0.f, (FLOAT)CELL_MASK );
+	return iX + (iY << CELL_BITS) + (iZ << (CELL_BITS*2));
+}
+
+//
+// Add a record to its cell.
+//
+void FActorLocationGrid::FileRecord( const FGridRecord& Rec )
+{
+	FGridCell& Cell = GetCell( Rec.iCell );
+	if( Cell.Num==Cell.Max )
+	{
+		Cell.Max     = Cell.Max ? Cell.Max*2 : 4;
+		Cell.Records = (FGridRecord*)appRealloc( Cell.Records, Cell.Max*sizeof(FGridRecord), "ActorLocationGridCell" );
+	}
+	Cell.Records[Cell.Num++] = Rec;
+}
+
+//
+// Take a record out of its cell.
+//
+void FActorLocationGrid::UnfileRecord( const FGridRecord& Rec )
+{
+	FGridCell& Cell = GetCell( Rec.iCell );
+	for( INT i=0; i<Cell.Num; i++ )
+	{
+		if( Cell.Records[i].Actor==Rec.Actor )
+		{
+			Cell.Records[i] = Cell.Records[--Cell.Num];
+			return;
+		}
+	}
+	appErrorf( "%s missing from actor location grid", Rec.Actor->GetFullName() );
+}
+
+//
+// Add an actor which has just been spawned, with its place in the level's
+// actor list.
+//
+void FActorLocationGrid::AddActor( AActor* Actor, DWORD Seq )
+{
+	guard(FActorLocationGrid::AddActor);
+	if( Actor->bDeleteMe )
+		return;
+	DWORD Index = Actor->GetIndex();
+	if( Index>=(DWORD)Filed.Num() )
+		Filed.AddZeroed( Index+1-Filed.Num() );
+	FGridRecord& Rec = Filed(Index);
+	check(Rec.Seq==0);
+	Rec.Actor = Actor;
+	Rec.iCell = GetActorCell( Actor );
+	Rec.Seq   = Seq;
+	FileRecord( Rec );
+	Changes++;
+	unguard;
+}
+
+//
+// Remove an actor which is being destroyed.
+//
+void FActorLocationGrid::RemoveActor( AActor* Actor )
+{
+	guard(FActorLocationGrid::RemoveActor);
+	DWORD Index = Actor->GetIndex();
+	if( Index<(DWORD)Filed.Num() && Filed(Index).Seq && Filed(Index).Actor==Actor )
+	{
+		UnfileRecord( Filed(Index) );
+		Filed(Index).Actor = NULL;
+		Filed(Index).Seq   = 0;
+	}
+	unguard;
+}
+
+//
+// Move an actor to the cell for its current location and size, keeping its
+// place in the order.
+//
+void FActorLocationGrid::RefileActor( AActor* Actor )
+{
+	guardSlow(FActorLocationGrid::RefileActor);
+	DWORD Index = Actor->GetIndex();
+	if( Index>=(DWORD)Filed.Num() || !Filed(Index).Seq || Filed(Index).Actor!=Actor )
+		return;
+	Changes++;
+	FGridRecord& Rec = Filed(Index);
+	INT iCell = GetActorCell( Actor );
+	if( iCell!=Rec.iCell )
+	{
+		UnfileRecord( Rec );
+		Rec.iCell = iCell;
+		FileRecord( Rec );
+	}
+	unguardSlow;
+}
+
+//
+// Sort gathered records into actor list order.
+//
+static INT CDECL CompareGridRecords( const void* A, const void* B )
+{
+	DWORD SeqA = ((FActorLocationGrid::FGridRecord*)A)->Seq;
+	DWORD SeqB = ((FActorLocationGrid::FGridRecord*)B)->Seq;
+	return SeqA<SeqB ? -1 : SeqA>SeqB ? 1 : 0;
+}
+
+//
+// Gather the records of the actors within Radius of Location, plus each
+// actor's collision radius if bAddCollisionRadius, in actor list order.
+// Returns the number found; the records are allocated on Mem.
+//
+INT FActorLocationGrid::GatherActors( FMemStack& Mem, FVector Location, FLOAT Radius, UBOOL bAddCollisionRadius, FGridRecord*& Result )
+{
+	guard(FActorLocationGrid::GatherActors);
+
+	// Cells which may hold actors in range.  Filed actors are no bigger than a cell.
+	FLOAT        Reach = Radius + (bAddCollisionRadius ? GRAN : 0);
+	const FLOAT* P     = &Location.X;
+	INT Lo[3], Hi[3];
+	for( INT i=0; i<3; i++ )
+	{
+		Lo[i] = (INT)Clamp( (P[i] - Reach + WORLD_OFS) * (1.f/GRAN), 0.f, (FLOAT)CELL_MASK );
+		Hi[i] = (INT)Clamp( (P[i] + Reach + WORLD_OFS) * (1.f/GRAN), 0.f, (FLOAT)CELL_MASK );
+	}
+	UBOOL bAllCells = (Hi[0]-Lo[0]+1) * (Hi[1]-Lo[1]+1) * (Hi[2]-Lo[2]+1) >= NUM_CELLS;
+
+	// Count then copy, visiting each cell of the range once, or each cell
+	// of the grid once if the range is bigger than the grid.
+	Result = NULL;
+	INT Count = 0;
+	for( INT Pass=0; Pass<2; Pass++ )
+	{
+		if( Pass==1 )
+		{
+			if( !Count )
+				break;
+			Result = new(Mem,Count)FGridRecord;
+			Count  = 0;
+		}
+		INT NumVisits = bAllCells ? NUM_CELLS+1 : (Hi[0]-Lo[0]+1) * (Hi[1]-Lo[1]+1) * (Hi[2]-Lo[2]+1) + 1;
+		for( INT Visit=0; Visit<NumVisits; Visit++ )
+		{
+			// Find the cell, and the coordinates its records must have.
+			FGridCell* Cell;
+			INT        iWant = INDEX_NONE;
+			if( Visit==NumVisits-1 )
+				Cell = &Cells[NUM_CELLS];
+			else if( bAllCells )
+				Cell = &Cells[Visit];
+			else
+			{
+				INT Span0 = Hi[0]-Lo[0]+1, Span1 = Hi[1]-Lo[1]+1;
+				INT iX    = Lo[0] + Visit % Span0;
+				INT iY    = Lo[1] + (Visit / Span0) % Span1;
+				INT iZ    = Lo[2] + Visit / (Span0 * Span1);
+				iWant     = iX + (iY << CELL_BITS) + (iZ << (CELL_BITS*2));
+				Cell      = &GetCell( iWant );
+			}
+			for( INT i=0; i<Cell->Num; i++ )
+			{
+				FGridRecord& Rec = Cell->Records[i];
+				if( iWant!=INDEX_NONE && Rec.iCell!=iWant )
+					continue;
+				if( bAllCells && Rec.iCell!=INDEX_NONE )
+				{
+					INT iX = Rec.iCell & CELL_MASK, iY = (Rec.iCell >> CELL_BITS) & CELL_MASK, iZ = Rec.iCell >> (CELL_BITS*2);
+					if( iX<Lo[0] || iX>Hi[0] || iY<Lo[1] || iY>Hi[1] || iZ<Lo[2] || iZ>Hi[2] )
+						continue;
+				}
+				AActor* Actor = Rec.Actor;
+				if( (Actor->Location - Location).SizeSquared() < Square(Radius + (bAddCollisionRadius ? Actor->CollisionRadius : 0.f)) )
+				{
+					if( Pass==1 )
+						Result[Count] = Rec;
+					Count++;
+				}
+			}
+		}
+	}
+	if( Count>1 )
+		appQsort( Result, Count, sizeof(FGridRecord), CompareGridRecords );
+	return Count;
+	unguard;
+}
+
+/*-----------------------------------------------------------------------------
+	ULevel interface.
+-----------------------------------------------------------------------------*/
+
+//
+// Return the level's actor location grid, building it the first time it's
+// needed, or NULL if the radius iterators should scan the actor list.
+//
+FActorLocationGrid* ULevel::GetActorGrid()
+{
+	guard(ULevel::GetActorGrid);
+	if( bNoActorGrid || GIsEditor )
+		return NULL;
+	if( !ActorGrid )
+		ActorGrid = new FActorLocationGrid( this );
+	return ActorGrid;
+	unguard;
+}
+
+/*-----------------------------------------------------------------------------
+	FRadiusActorQuery.
+-----------------------------------------------------------------------------*/
+
+//
+// Start a query.
+//
+FRadiusActorQuery::FRadiusActorQuery( FMemStack& InMem, ULevel* InLevel, UClass* InClass, FVector InLocation, FLOAT InRadius, UBOOL InAddCollisionRadius )
+:	Level				( InLevel )
+,	Class				( InClass ? InClass : AActor::StaticClass )
+,	Location			( InLocation )
+,	Radius				( InRadius )
+,	bAddCollisionRadius	( InAddCollisionRadius )
+,	Mem					( &InMem )
+,	Grid				( NULL )
+,	Found				( NULL )
+,	NumFound			( 0 )
+,	iFound				( 0 )
+,	iScan				( 0 )
+,	Changes				( 0 )
+,	LastSeq				( 0 )
+{
+	guard(FRadiusActorQuery::FRadiusActorQuery);
+	Grid = Radius>0.0 ? Level->GetActorGrid() : NULL;
+	if( Grid )
+	{
+		NumFound = Grid->GatherActors( *Mem, Location, Radius, bAddCollisionRadius, Found );
+		Changes  = Grid->Changes;
+	}
+	unguard;
+}
+
+//
+// Return the next actor in range, or NULL if there are no more.
+//
+AActor* FRadiusActorQuery::Next()
+{
+	guardSlow(FRadiusActorQuery::Next);
+	for( ;; )
+	{
+		AActor* Actor;
+		if( Grid )
+		{
+			// Gather again if anything has been spawned, moved or resized,
+			// unless the grid itself has been thrown away.
+			if( Grid==Level->ActorGrid && Grid->Changes!=Changes )
+			{
+				NumFound = Grid->GatherActors( *Mem, Location, Radius, bAddCollisionRadius, Found );
+				Changes  = Grid->Changes;
+				for( iFound=0; iFound<NumFound && Found[iFound].Seq<=LastSeq; iFound++ );
+			}
+			if( iFound>=NumFound )
+				return NULL;
+			LastSeq = Found[iFound].Seq;
+			Actor   = Found[iFound++].Actor;
+		}
+		else if( (Actor=Level->NextListedActor( iScan, LastSeq ))==NULL )
+			return NULL;
+		if
+		(	Actor
+		&& !Actor->bDeleteMe
+		&&	Actor->IsA(Class)
+		&&	(Radius==0.0 || (Actor->Location - Location).SizeSquared() < Square(Radius + (bAddCollisionRadius ? Actor->CollisionRadius : 0.f))) )
+			return Actor;
+	}
+	unguardSlow;
+}
+
+/*-----------------------------------------------------------------------------
+	The End.
+-----------------------------------------------------------------------------*/
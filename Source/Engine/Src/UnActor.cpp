@@ -118,16 +118,41 @@ void AActor::ProcessEvent( UFunction* Function, void* Parms )
 {
 	guardSlow(AActor::ProcessEvent);
 	if( Level->bBegunPlay )
+	{
+		Unpark();
 		Super::ProcessEvent( Function, Parms );
+	}
+	unguardSlow;
+}
+
+//
+// Calls into a parked actor's script wake it up, since they may give it
+// something to do.
+//
+void AActor::CallFunction( FFrame& Stack, BYTE*& Result, UFunction* Function )
+{
+	guardSlow(AActor::CallFunction);
+	Unpark();
+	Super::CallFunction( Stack, Result, Function );
 	unguardSlow;
 }
 
+EGotoState AActor::GotoState( FName State )
+{
+	guard(AActor::GotoState);
+	Unpark();
+	return Super::GotoState( State );
+	unguard;
+}
+
 void AActor::PostEditChange()
 {
 	guard(AActor::PostEditChange);
 	Super::PostEditChange();
 	if( GIsEditor )
 		bLightChanged = 1;
+	else if( XLevel )
+		XLevel->ActorTagChanged( this );
 	unguard;
 }
 
@@ -177,6 +202,8 @@ void AActor::SetCollisionSize( FLOAT NewRadius, FLOAT NewHeight )
 	// Touch this actor.
 	if( bCollideActors && GetLevel()->Hash )
 		GetLevel()->Hash->AddActor( this );
+	if( GetLevel()->ActorGrid )
+		GetLevel()->ActorGrid->RefileActor( this );
 
 	unguard;
 }
@@ -288,8 +315,8 @@ static UBOOL TouchTo( AActor* Actor, AActor* Other )
 //
 // Note that TouchActor has begun touching Actor.
 //
-// If an actor's touch list overflows, neither actor receives the
-// touch messages, as if they are not touching.
+// If an actor's touch list overflows, it doesn't receive the touch
+// message, but the other actor may still touch it.
 //
 // This routine is reflexive.
 //
@@ -303,6 +330,18 @@ void AActor::BeginTouch( AActor* Other )
 	if( TouchTo( this, Other ) )
 		TouchTo( Other, this );
 
+	// Tell the level if only one of them ended up touching the other.
+	UBOOL bTouchingOther=0, bOtherTouching=0;
+	for( INT i=0; i<ARRAY_COUNT(Touching); i++ )
+	{
+		bTouchingOther |= (Touching[i]==Other);
+		bOtherTouching |= (Other->Touching[i]==this);
+	}
+	if( XLevel && bOtherTouching && !bTouchingOther )
+		XLevel->NoteOneWayTouch( this );
+	else if( XLevel && bTouchingOther && !bOtherTouching )
+		XLevel->NoteOneWayTouch( Other );
+
 	unguard;
 }
 
@@ -376,6 +415,8 @@ void AActor::SetOwner( AActor *NewOwner )
 	if( Owner != NULL )
 		Owner->eventLostChild( this );
 
+	if( XLevel && !bDeleteMe )
+		XLevel->NoteOwnerChange( Owner, NewOwner );
 	Owner = NewOwner;
 
 	if( Owner != NULL )
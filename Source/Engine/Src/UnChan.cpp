@@ -609,6 +609,12 @@ FActorChannel::FActorChannel( UNetConnection* InConnection, INT InChannelIndex,
 ,	Recent			( NULL )
 ,	RelevantTime	( Connection->Driver->Time )
 ,	LastUpdateTime	( Connection->Driver->Time - Connection->Driver->SpawnPrioritySeconds )
+,	RecentPending	( NULL )
+,	NumPending		( 0 )
+,	RepSerial		( 0 )
+,	LastRemoteRole	( 0 )
+,	bLastNetOwner	( 0 )
+,	bRecentClean	( 0 )
 {
 	guard(FActorChannel::FActorChannel);
 	unguard;
@@ -638,6 +644,8 @@ FActorChannel::~FActorChannel()
 	guard(FreeRecent);
 	if( Recent )
 		appFree( Recent );
+	if( RecentPending )
+		appFree( RecentPending );
 	unguard;
 
 	// If we're the client, destroy this actor.
@@ -777,6 +785,7 @@ void FActorChannel::ReceivedBunch( FInBunch& Bunch )
 				Bunch.Overflowed = 1;
 				break;
 			}
+			bRecentClean = 0;
 
 			// For debugging.
 			debugfSlow( NAME_DevNetTraffic, "         %s", *PropertyName );
@@ -1016,20 +1025,78 @@ void FActorChannel::ReplicateActor( UBOOL FullReplication )
 		}
 	}
 
+	// Find out which replicated properties changed since the last net tick.
+	FActorRepState* RepState = Level->UpdateRepState( Actor );
+
 	// Save out the actor's RemoteRole, and downgrade it if necessary.
 	BYTE ActualRemoteRole=Actor->RemoteRole;
 	if( Actor->RemoteRole==ROLE_AutonomousProxy && !Actor->bNetOwner )
 		Actor->RemoteRole=ROLE_SimulatedProxy;
 	Actor->bSimulatedPawn = Actor->IsA(APawn::StaticClass) && (Actor->RemoteRole == ROLE_SimulatedProxy);
 
+	// Only compare the properties which changed since the channel last
+	// replicated the actor, and those Recent didn't match then, unless the
+	// last pass stopped short or the connection's view of the actor has
+	// changed.  Now and then compare them all anyway and resend one element
+	// picked at random, as often as the random resends below would pick
+	// one; partial passes skip those.
+	UBOOL bPartial = 0;
+	INT   iForce   = INDEX_NONE;
+	if( RepState )
+	{
+		if( !RecentPending )
+		{
+			RecentPending = (BYTE*)appMalloc( ::Max(RepState->NumLinks,1), "FActorChannelPending" );
+			appMemset( RecentPending, 0, ::Max(RepState->NumLinks,1) );
+			NumPending = 0;
+		}
+		bPartial
+		=	bRecentClean
+		&&	!Actor->bNetInitial
+		&&	LastRemoteRole==Actor->RemoteRole
+		&&	bLastNetOwner==Actor->bNetOwner
+		&&	RepState->NumElements<1000;
+		if( bPartial && appFrand()*1000.0<RepState->NumElements )
+		{
+			bPartial = 0;
+			iForce   = appRand() % RepState->NumElements;
+		}
+		if( bPartial && !NumPending && !RepState->bNetAlways && RepState->LastChange<=RepSerial )
+		{
+			// Nothing to send.
+			Level->TotalRepSkipped++;
+			Actor->bNetOwner  = 0;
+			Actor->RemoteRole = ActualRemoteRole;
+			return;
+		}
+		if( bPartial )
+			Level->TotalRepPartial++;
+		else
+			Level->TotalRepFull++;
+		RepSerial      = Level->RepSerial;
+		LastRemoteRole = Actor->RemoteRole;
+		bLastNetOwner  = Actor->bNetOwner;
+	}
+	bRecentClean = 0;
+
 	// Replicate all applicable properties.
+	INT iLink = 0, iElement = 0;
 	for( UClass* RepClass=Actor->GetClass(); RepClass; RepClass=RepClass->GetSuperClass() )
 	{
-		for( FRepLink* Link=RepClass->Reps; Link; Link=Link->Next )
+		for( FRepLink* Link=RepClass->Reps; Link; Link=Link->Next, iLink++ )
 		{
 			FRepLink*  Condition = Link->Condition;
 			UProperty* It        = Link->Property;
 			INT        Index     = 0;
+			UBOOL      Pending   = 0;
+			INT        iFirst    = iElement;
+			iElement += It->ArrayDim;
+			if
+			(	bPartial
+			&&	!RecentPending[iLink]
+			&&	RepState->Changed[iLink]<=RepSerial
+			&&	!(It->PropertyFlags & CPF_NetAlways) )
+				continue;
 			if
 			(	Condition->LastObject != Actor
 			||	Condition->LastStamp  != Actor->OtherTag
@@ -1038,10 +1105,11 @@ void FActorChannel::ReplicateActor( UBOOL FullReplication )
 				for( Index=0; Index<It->ArrayDim; Index++ )
 				{
 					UBOOL RandomForce=0;
+					UBOOL Differs=!It->Matches(Actor,Recent,Index);
 					if
-					(	!It->Matches(Actor,Recent,Index)
+					(	Differs
 					||	(It->PropertyFlags & CPF_NetAlways)
-					||	(RandomForce=(appFrand()<1.0/1000.0))!=0 )
+					||	(RandomForce=(iForce!=INDEX_NONE ? iFirst+Index==iForce : appFrand()<1.0/1000.0))!=0 )
 					{
 						if
 						(	Condition->LastObject!=Actor
@@ -1064,12 +1132,27 @@ void FActorChannel::ReplicateActor( UBOOL FullReplication )
 							if( Bunch.SendProperty( It, Index, (BYTE*)Actor, Recent, 1 ) )
 								goto FilledUp;
 							Actor->XLevel->NumReps++;
+							if( Differs )
+								Differs = !It->Matches(Actor,Recent,Index);
 						}
 					}
+					Pending |= Differs;
 				}
 			}
+			else if( RepState )
+			{
+				// Not wanted now, but the condition may change.
+				for( Index=0; Index<It->ArrayDim && !Pending; Index++ )
+					Pending = !It->Matches(Actor,Recent,Index);
+			}
+			if( RepState && RecentPending[iLink]!=Pending )
+			{
+				NumPending += Pending ? 1 : -1;
+				RecentPending[iLink] = Pending;
+			}
 		}
 	}
+	bRecentClean = RepState!=NULL;
 	FilledUp:
 	check(!Bunch.Overflowed);
 
@@ -115,6 +115,11 @@ public:
 	void Update( AActor *Actor );
 	int  SurfIsDynamic( INT iSurf );
 
+	// Stats and commands.
+	UBOOL Exec( const char* Cmd, FOutputDevice* Out );
+	void InitStats();
+	void GetStats( char* Result );
+
 	///////////////////////////////////
 	// FMovingBrushTracker interface //
 	///////////////////////////////////
@@ -145,6 +150,8 @@ public:
 
 	void AddActorBrush(AActor *Actor);
 	void FlushActorBrush(AActor *Actor,int Group);
+	UBOOL UpdateActorBrushInPlace(AActor *Actor);
+	inline UBOOL IsOwnChild(INT iChild,AActor *Actor);
 
 	inline void ForceGroupFlush(INT iNode);
 
@@ -190,6 +197,16 @@ private:
 
 	// Used by AddPolyFragment.
 	INT* iActorNodePrevLink;
+
+	// Incremental updates.  WholeBrushes is indexed by actor object index and
+	// is set for brushes whose polys were all added as single, unsplit nodes.
+	TArray<BYTE> WholeBrushes;
+	INT NumAddSplits;
+	UBOOL bNoInPlace;
+
+	// Stats.
+	DWORD UpdateCycles;
+	INT NumNodesAdded, NumNodesRemoved, NumInPlace, NumRebuilt;
 };
 
 /*---------------------------------------------------------------------------------------
@@ -284,6 +301,61 @@ int FMovingBrushTracker::SurfIsDynamic( INT iSurf )
 	unguard;
 }
 
+//
+// Command line.
+//
+UBOOL FMovingBrushTracker::Exec( const char* Cmd, FOutputDevice* Out )
+{
+	guard(FMovingBrushTracker::Exec);
+	const char* Str = Cmd;
+	if( ParseCommand(&Str,"BRUSHTRACKER") )
+	{
+		if( ParseCommand(&Str,"INPLACE") )
+		{
+			if( ParseCommand(&Str,"ON") )
+				bNoInPlace = 0;
+			else if( ParseCommand(&Str,"OFF") )
+				bNoInPlace = 1;
+			else
+				bNoInPlace = !bNoInPlace;
+		}
+		Out->Logf( "Moving brush in-place updates %s", bNoInPlace ? "disabled" : "enabled" );
+		return 1;
+	}
+	return 0;
+	unguard;
+}
+
+//
+// Reset the per-frame stats.
+//
+void FMovingBrushTracker::InitStats()
+{
+	guard(FMovingBrushTracker::InitStats);
+	UpdateCycles = 0;
+	NumNodesAdded = NumNodesRemoved = NumInPlace = NumRebuilt = 0;
+	unguard;
+}
+
+//
+// Return the per-frame stats.
+//
+void FMovingBrushTracker::GetStats( char* Result )
+{
+	guard(FMovingBrushTracker::GetStats);
+	appSprintf
+	(
+		Result,
+		"Brush=%04.1f (%i moved, %i rebuilt, +%i/-%i nodes)",
+		GSecondsPerCycle*1000 * UpdateCycles,
+		NumInPlace,
+		NumRebuilt,
+		NumNodesAdded,
+		NumNodesRemoved
+	);
+	unguard;
+}
+
 /*---------------------------------------------------------------------------------------
 	FMovingBrushTracker init & exit.
 ---------------------------------------------------------------------------------------*/
@@ -306,6 +378,8 @@ FMovingBrushTracker::FMovingBrushTracker( ULevel* ThisLevel )
 	iTopVector			= ExpandDb(Level->Model->Vectors,16384);
 	iTopVertPool		= ExpandDb(Level->Model->Verts);
 	iTopBrushMap		= 0;
+	bNoInPlace			= 0;
+	InitStats();
 
 	// Note that all actors are unassimilated.
 	INT i;
@@ -871,6 +945,7 @@ void FMovingBrushTracker::AddPolyFragment
 
 	*iActorNodePrevLink = iNode;
 	iActorNodePrevLink  = &Node->iRenderBound;
+	NumNodesAdded++;
 
 	return;
 
@@ -907,6 +982,7 @@ void FMovingBrushTracker::FilterFPoly
 	if( EdPoly->NumVertices >= FPoly::VERTEX_THRESHOLD )
 	{
 		// Must split to avoid vertex overflow.
+		NumAddSplits++;
 		TempFrontEdPoly = new(GMem)FPoly;
 		EdPoly->SplitInHalf( TempFrontEdPoly );
 		FilterFPoly( iNode, iCoplanarParent, TempFrontEdPoly, Outside );
@@ -961,6 +1037,7 @@ void FMovingBrushTracker::FilterFPoly
 		if( Node->NodeFlags & (NF_IsFront | NF_IsBack) )
 			appError("Precompute error 3");
 #endif
+		NumAddSplits++;
 		if( (Level->Model->Vectors->Element(Surf->vNormal) | FPolyNormal) >= 0.0 )
 			iCoplanarParent = iNode;
 		goto Front;
@@ -973,6 +1050,7 @@ void FMovingBrushTracker::FilterFPoly
 #endif
 
 		// Handle front fragment.
+		NumAddSplits++;
 		if( Node->iFront != INDEX_NONE )
 			FilterFPoly( Node->iFront, iCoplanarParent, TempFrontEdPoly, Outside || Node->IsCsg() );
 		else if( Outside || Node->IsCsg() )
@@ -1004,6 +1082,7 @@ void FMovingBrushTracker::AddActorBrush( AActor* Actor )
 
 	iActorNodePrevLink = (INT *)(&Actor->Brush->MoverLink);
 	AddActor           = Actor;
+	NumAddSplits       = 0;
 	UModel *Brush      = Actor->Brush;
 
 #if CHECK_ALL
@@ -1097,6 +1176,7 @@ void FMovingBrushTracker::AddActorBrush( AActor* Actor )
 
 	// Tag all newly-added nodes as non-new.
 	INT iNode = *(INT*)&Brush->MoverLink;
+	INT NumNodes = 0;
 	while( iNode != INDEX_NONE )
 	{
 		FBspNode *Node   = &Level->Model->Nodes->Element(iNode);
@@ -1108,8 +1188,15 @@ void FMovingBrushTracker::AddActorBrush( AActor* Actor )
 
 		Node->NodeFlags &= ~NF_IsNew;
 		iNode = Node->iRenderBound;
+		NumNodes++;
 	}
 
+	// Remember whether the brush can be moved in place next time.
+	INT iActor = Actor->GetIndex();
+	if( iActor >= WholeBrushes.Num() )
+		WholeBrushes.AddZeroed( iActor+1-WholeBrushes.Num() );
+	WholeBrushes(iActor) = (NumAddSplits==0 && NumNodes==Brush->Polys->Num());
+
 	Mark.Pop();
 	unguard;
 }
@@ -1186,12 +1273,130 @@ void FMovingBrushTracker::FlushActorBrush( AActor* Actor, int Group )
 		}
 		FreeVertPoolIndex( Node->iVertPool, Node->NumVertices );
 		FreeNodeIndex( iNode );
+		NumNodesRemoved++;
 		iNode = Node->iRenderBound;
 	}
 	Actor->Brush->MoverLink = INDEX_NONE;
 	unguard;
 }
 
+//
+// Return whether a node's child is either empty or one of the actor's own
+// sporadic nodes.
+//
+inline UBOOL FMovingBrushTracker::IsOwnChild( INT iChild, AActor* Actor )
+{
+	return iChild==INDEX_NONE || (iChild>=Level->Model->Nodes->Num() && NodeOwners[iChild-Level->Model->Nodes->Num()]==Actor);
+}
+
+//
+// Try to move a brush's sporadic nodes, points and surfaces to its new
+// location and rotation in place, rather than flushing and re-adding them.
+//
+// This works when every poly of the brush was last added whole, as one
+// node, and each still filters down the Bsp to that node without being
+// split or becoming coplanar with anything on the way.  Since the brush
+// moves rigidly, the way its polys classify against each other can't
+// change, so FilterFPoly would build exactly the same nodes.  Nodes of
+// other brushes must not hang off this brush's nodes, as they were
+// filtered against its old position.
+//
+// Returns 0 if the brush must be flushed and re-added instead, in which
+// case some of its nodes may already have been moved.
+//
+UBOOL FMovingBrushTracker::UpdateActorBrushInPlace( AActor* Actor )
+{
+	guard(FMovingBrushTracker::UpdateActorBrushInPlace);
+	UModel* Model = Level->Model;
+	UModel* Brush = Actor->Brush;
+	INT     iActor = Actor->GetIndex();
+	if
+	(	bNoInPlace
+	||	!Actor->bAssimilated
+	||	iActor>=WholeBrushes.Num()
+	||	!WholeBrushes(iActor)
+	||	Brush->MoverLink==INDEX_NONE
+	||	Model->Nodes->Num()==0 )
+		return 0;
+
+	// Find the node each poly became.
+	FMemMark Mark(GMem);
+	INT* PolyNodes = new(GMem,Brush->Polys->Num())INT;
+	INT  i;
+	for( i=0; i<Brush->Polys->Num(); i++ )
+		PolyNodes[i] = INDEX_NONE;
+	for( INT iNode=Brush->MoverLink; iNode!=INDEX_NONE; iNode=Model->Nodes->Element(iNode).iRenderBound )
+	{
+		FBspNode& Node  = Model->Nodes->Element(iNode);
+		INT       iPoly = Model->Surfs->Element(Node.iSurf).iBrushPoly;
+		if
+		(	!IsOwnChild(Node.iFront,Actor)
+		||	!IsOwnChild(Node.iBack, Actor)
+		||	!IsOwnChild(Node.iPlane,Actor)
+		||	iPoly<0
+		||	iPoly>=Brush->Polys->Num()
+		||	Node.NumVertices!=Brush->Polys->Element(iPoly).NumVertices )
+		{
+			Mark.Pop();
+			return 0;
+		}
+		PolyNodes[iPoly] = iNode;
+	}
+
+	// Move each poly, in the order they were added.
+	FModelCoords Coords;
+	FLOAT  Orientation = ((ABrush*)Actor)->BuildCoords(&Coords,NULL);
+	FPoly* Front       = new(GMem)FPoly;
+	FPoly* Back        = new(GMem)FPoly;
+	UBOOL  Result      = 1;
+	for( i=0; i<Brush->Polys->Num(); i++ )
+	{
+		FPoly Poly = Brush->Polys->Element(i);
+		Poly.Transform( Coords, ((ABrush*)Actor)->PrePivot, Actor->Location, Orientation );
+		INT iFragment = PolyNodes[i];
+		if( iFragment==INDEX_NONE || Poly.NumVertices>=FPoly::VERTEX_THRESHOLD )
+		{
+			Result = 0;
+			break;
+		}
+
+		// Follow it down the Bsp as FilterFPoly would, to see if it reaches the same node.
+		INT iNode = 0;
+		while( iNode!=iFragment && iNode!=INDEX_NONE )
+		{
+			FBspNode* Node  = &Model->Nodes->Element(iNode);
+			FBspSurf* Surf  = &Model->Surfs->Element(Node->iSurf);
+			INT       Split = Poly.SplitWithPlaneFast( FPlane( Model->Points->Element(Surf->pBase), Model->Vectors->Element(Surf->vNormal) ), Front, Back );
+			if( Split==SP_Front )
+				iNode = Node->iFront;
+			else if( Split==SP_Back )
+				iNode = Node->iBack;
+			else
+				iNode = INDEX_NONE;
+		}
+		if( iNode==INDEX_NONE )
+		{
+			Result = 0;
+			break;
+		}
+
+		// Move its surface, node and points.
+		FBspSurf* Surf = &Model->Surfs->Element(Poly.iLink);
+		Model->Points ->Element(Surf->pBase    ) = Poly.Base;
+		Model->Vectors->Element(Surf->vNormal  ) = Poly.Normal;
+		Model->Vectors->Element(Surf->vTextureU) = Poly.TextureU;
+		Model->Vectors->Element(Surf->vTextureV) = Poly.TextureV;
+		FBspNode* Node = &Model->Nodes->Element(iFragment);
+		Node->Plane    = FPlane( Poly.Base, Poly.Normal );
+		FVert* VertPool = &Model->Verts->Element(Node->iVertPool);
+		for( INT j=0; j<Poly.NumVertices; j++ )
+			Model->Points->Element(VertPool[j].pVertex) = Poly.Vertex[j];
+	}
+	Mark.Pop();
+	return Result;
+	unguard;
+}
+
 /*---------------------------------------------------------------------------------------
 	Public operations.
 ---------------------------------------------------------------------------------------*/
@@ -1275,6 +1480,7 @@ void FMovingBrushTracker::RemoveAllBrushes()
 void FMovingBrushTracker::UpdateBrushes( AActor** Actors, int Num )
 {
 	guard(FMovingBrushTracker::UpdateBrushes);
+	uclock(UpdateCycles);
 	INT Group;
 
 	if( Actors == NULL )
@@ -1320,6 +1526,17 @@ void FMovingBrushTracker::UpdateBrushes( AActor** Actors, int Num )
 		}
 	}
 
+	// Move brushes which can be updated in place, and leave them out of the rest.
+	for( i=0; i<NumGroupActors; i++ )
+	{
+		AActor* Actor = GroupActors[i];
+		if( Actor && Actor->IsMovingBrush() && UpdateActorBrushInPlace(Actor) )
+		{
+			GroupActors[i] = NULL;
+			NumInPlace++;
+		}
+	}
+
 	// Flush all actor brushes.  Calls to FlushActorBrush with Group set to true
 	// cause GroupActors to be expanded to include all brushes interwoven with the
 	// specified brushes.
@@ -1339,8 +1556,10 @@ void FMovingBrushTracker::UpdateBrushes( AActor** Actors, int Num )
 			if( !Actor->bAssimilated )
 				SetupActorBrush( Actor );
 			AddActorBrush( Actor );
+			NumRebuilt++;
 		}
 	}
+	uunclock(UpdateCycles);
 	unguard;
 }
 
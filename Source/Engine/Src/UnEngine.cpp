@@ -67,6 +67,7 @@ void UEngine::Init()
 	// Subsystems.
 	FURL::Init();
 	GCache.Init( 1024 * 1024 * Clamp<INT>(CacheSizeMegs,1,1024), 4096 );
+	GRecursiveTrace = ParseParam(appCmdLine(),"OLDTRACE");
 
 	// Objects.
 	Cylinder = new UPrimitive;
@@ -78,7 +79,8 @@ void UEngine::Init()
 	if
 	(	UseSound
 	&&	GIsClient
-	&&	!ParseParam(appCmdLine(),"NOSOUND") )
+	&&	!ParseParam(appCmdLine(),"NOSOUND")
+	&&	!ParseParam(appCmdLine(),"HEADLESS") )
 	{
 		UClass* AudioClass = GObj.LoadClass( UAudioSubsystem::StaticClass, NULL, "ini:Engine.Engine.AudioDevice", NULL, LOAD_NoFail | LOAD_KeepImports, NULL );
 		Audio = ConstructClassObject<UAudioSubsystem>( AudioClass );
@@ -189,6 +191,8 @@ UBOOL UEngine::Exec( const char* Cmd, FOutputDevice* Out )
 	// See if any other subsystems claim the command.
 	if( GObj.Exec					(Cmd,Out) ) return 1;
 	if( GCache.Exec					(Cmd,Out) ) return 1;
+	if( GJobs.Exec					(Cmd,Out) ) return 1;
+	if( GProfiler.Exec				(Cmd,Out) ) return 1;
 	if( GExecHook && GExecHook->Exec(Cmd,Out) ) return 1;
 	if( GSystem && GSystem->Exec	(Cmd,Out) ) return 1;
 	if( Client  && Client->Exec		(Cmd,Out) ) return 1;
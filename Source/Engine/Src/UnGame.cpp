@@ -51,7 +51,11 @@ INT UGameEngine::ChallengeResponse( INT Challenge )
 // Construct the game engine.
 //
 UGameEngine::UGameEngine()
-: LastURL("")
+:	LastURL				( "" )
+,	HibernateDelay		( 30.f )
+,	HibernateTickRate	( 5 )
+,	bHibernating		( 0 )
+,	IdleTime			( 0.f )
 {}
 
 //
@@ -64,6 +68,8 @@ void UGameEngine::InternalClassInitializer( UClass* Class )
 	{
 		(new(Class,"ServerActors",  RF_Public)UStringProperty( CPP_PROPERTY(ServerActors  ), "Settings", CPF_Config, 96 ))->ArrayDim=16;
 		(new(Class,"ServerPackages",RF_Public)UStringProperty( CPP_PROPERTY(ServerPackages), "Settings", CPF_Config, 96 ))->ArrayDim=16;
+		new(Class,"HibernateDelay",    RF_Public)UFloatProperty( CPP_PROPERTY(HibernateDelay   ), "Settings", CPF_Config );
+		new(Class,"HibernateTickRate", RF_Public)UIntProperty  ( CPP_PROPERTY(HibernateTickRate), "Settings", CPF_Config );
 	}
 	unguard;
 }
@@ -88,8 +94,9 @@ void UGameEngine::Init()
 	// If not a dedicated server.
 	if( GIsClient )
 	{	
-		// Init client.
-		UClass* ClientClass = GObj.LoadClass( UClient::StaticClass, NULL, "ini:Engine.Engine.ViewportManager", NULL, LOAD_NoFail | LOAD_KeepImports, NULL );
+		// Init client.  -HEADLESS runs without a window, e.g. for timedemos.
+		const char* ClientName = ParseParam(appCmdLine(),"HEADLESS") ? "NullDrv.NullClient" : "ini:Engine.Engine.ViewportManager";
+		UClass* ClientClass = GObj.LoadClass( UClient::StaticClass, NULL, ClientName, NULL, LOAD_NoFail | LOAD_KeepImports, NULL );
 		Client = ConstructClassObject<UClient>( ClientClass );
 		Client->Init( this );
 
@@ -802,6 +809,9 @@ ULevel* UGameEngine::LoadMap( const FURL& URL, UPendingLevel* Pending, char* Err
 		if( GLevel->Element(i) && !GLevel->Element(i)->bStatic )
 			Actors.AddItem( GLevel->Element(i) );
 	GLevel->Empty();
+	GLevel->bTickListValid = 0;
+	GLevel->FlushLiveActors();
+	GLevel->FlushActorOrder();
 	GLevel->Add( Actors.Num() );
 	for( i=0; i<Actors.Num(); i++ )
 		GLevel->Element(i) = Actors(i);
@@ -859,6 +869,7 @@ ULevel* UGameEngine::LoadMap( const FURL& URL, UPendingLevel* Pending, char* Err
 void UGameEngine::Draw( UViewport* Viewport, BYTE* HitData, INT* HitSize )
 {
 	guard(UGameEngine::Draw);
+	profileZone("UGameEngine::Draw");
 
 	// Get view location.
 	AActor*      ViewActor    = Viewport->Actor;
@@ -896,6 +907,7 @@ void UGameEngine::Draw( UViewport* Viewport, BYTE* HitData, INT* HitSize )
 	// Update level audio.
 	if( Audio )
 	{
+		profileZone("UAudioSubsystem::Update");
 		uclock(GLevel->AudioTickCycles);
 		Audio->Update( ViewActor->Region, Frame->Coords );
 		uunclock(GLevel->AudioTickCycles);
@@ -1006,7 +1018,9 @@ void UGameEngine::SetClientTravel( UPlayer* Player, const char* NextURL, UBOOL b
 INT UGameEngine::GetMaxTickRate()
 {
 	guard(UEngine::GetMaxTickRate);
-	if( GLevel && GLevel->NetDriver && !GLevel->NetDriver->ServerConnection )
+	if( bHibernating )
+		return Max( HibernateTickRate, 1 );
+	else if( GLevel && GLevel->NetDriver && !GLevel->NetDriver->ServerConnection )
 		return GLevel->NetDriver->MaxTicksPerSecond;
 	else
 		return 0;
@@ -1019,6 +1033,8 @@ INT UGameEngine::GetMaxTickRate()
 void UGameEngine::Tick( FLOAT DeltaSeconds )
 {
 	guard(UGameEngine::Tick);
+	GProfiler.Tick();
+	profileZone("UGameEngine::Tick");
 	INT LocalTickCycles=0;
 	uclock(LocalTickCycles);
 
@@ -1052,7 +1068,10 @@ void UGameEngine::Tick( FLOAT DeltaSeconds )
 	GameCycles=0;
 	uclock(GameCycles);
 	if( GLevel )
-		GLevel->Tick( LEVELTICK_All, DeltaSeconds );
+	{
+		GLevel->bHibernating = bHibernating;
+		GLevel->Tick( bHibernating ? LEVELTICK_TimeOnly : LEVELTICK_All, DeltaSeconds );
+	}
 	if( Client && Client->Viewports.Num() && Client->Viewports(0)->Actor->XLevel!=GLevel )
 		Client->Viewports(0)->Actor->XLevel->Tick( LEVELTICK_All, DeltaSeconds );
 	uunclock(GameCycles);
@@ -1167,6 +1186,48 @@ void UGameEngine::Tick( FLOAT DeltaSeconds )
 	uunclock(LocalTickCycles);
 	TickCycles=LocalTickCycles;
 	GTicks++;
+
+	// Enter or leave hibernation for the next tick.
+	UpdateHibernation( DeltaSeconds, GSecondsPerCycle * LocalTickCycles );
+	unguard;
+}
+
+//
+// A dedicated server with nobody connected for HibernateDelay seconds
+// hibernates: the level only keeps time, listens for connections and ticks
+// the ServerActors, so LAN queries and master server heartbeats carry on,
+// at HibernateTickRate.  It wakes on the tick a connection arrives.
+//
+void UGameEngine::UpdateHibernation( FLOAT DeltaSeconds, DOUBLE WorkTime )
+{
+	guard(UGameEngine::UpdateHibernation);
+	UBOOL Idle
+	=	!GIsClient
+	&&	HibernateDelay>0.f
+	&&	GLevel
+	&&	GLevel->NetDriver
+	&&	!GLevel->NetDriver->ServerConnection
+	&&	GLevel->NetDriver->Connections.Num()==0
+	&&	!GPendingLevel;
+	if( bHibernating )
+	{
+		HibernateWorkTime += WorkTime;
+		if( !Idle )
+		{
+			DOUBLE Elapsed = appSeconds() - HibernateTime;
+			debugf( NAME_Log, "Leaving hibernation after %.1f sec, busy %.3f%% of the time", Elapsed, Elapsed>0.0 ? 100.0 * HibernateWorkTime / Elapsed : 0.0 );
+			bHibernating = 0;
+		}
+	}
+	else if( Idle && (IdleTime+=DeltaSeconds)>=HibernateDelay )
+	{
+		debugf( NAME_Log, "No connections for %.1f sec, hibernating at %i Hz", IdleTime, Max(HibernateTickRate,1) );
+		bHibernating      = 1;
+		HibernateTime     = appSeconds();
+		HibernateWorkTime = 0.0;
+	}
+	if( !Idle )
+		IdleTime = 0.f;
 	unguard;
 }
 
@@ -69,11 +69,55 @@ AActor* ULevel::SpawnActor
 		}
 	}
 
-	// Add at end of list.
-	INT iActor = Add();
+	// Fill the slot of a destroyed actor if there is one, so that the list
+	// doesn't grow and the other actors keep their indices, otherwise add
+	// at end of list.  Reconstruct a pooled actor of this class in place if
+	// there is one.  It keeps the name it was first spawned with.
+	INT iActor = INDEX_NONE;
+	if( GetLiveActors() )
+	{
+		while( FreeActorSlots.Num() && iActor==INDEX_NONE )
+		{
+			INT iFree = FreeActorSlots( FreeActorSlots.Num()-1 );
+			FreeActorSlots.Remove( FreeActorSlots.Num()-1 );
+			if( iFree>=iFirstDynamicActor && iFree<Num() && !Actors(iFree) )
+				iActor = iFree;
+		}
+	}
+	if( iActor!=INDEX_NONE )
+		NumActorHoles = ::Max( NumActorHoles-1, 0 );
+	else
+		iActor = Add();
 	ModifyItem( iActor );
-    AActor* Actor = Actors(iActor) = (AActor*)GObj.ConstructObject( Class, GetParent(), InName, 0, Template );
+	FActorPool* Pool   = (InName==NAME_None && !GIsEditor && !bNoActorPool) ? FindActorPool( Class ) : NULL;
+	AActor*     Pooled = NULL;
+	if( Pool && Pool->First )
+	{
+		Pooled      = Pool->First;
+		Pool->First = Pooled->Deleted;
+		Pool->Num--;
+	}
+	DWORD Cycles=0;
+	uclock(Cycles);
+    AActor* Actor = Actors(iActor) = (AActor*)GObj.ConstructObject( Class, GetParent(), Pooled ? Pooled->GetFName() : InName, 0, Template );
+	uunclock(Cycles);
 	Actor->SetFlags( RF_Transactional );
+	if( Pool )
+	{
+		check(Actor==Pooled || !Pooled);
+		NumPoolSpawns++;
+		if( Pooled )
+		{
+			Pool->Hits++;
+			Pool->HitSeconds += GSecondsPerCycle * Cycles;
+			NumPoolHits++;
+		}
+		else
+		{
+			Pool->Misses++;
+			Pool->MissSeconds += GSecondsPerCycle * Cycles;
+		}
+	}
 
 	// Set base actor properties.
 	Actor->Tag		= Class->GetFName();
@@ -81,6 +125,15 @@ AActor* ULevel::SpawnActor
 	Actor->Level	= GetLevelInfo();
 	Actor->bTicked  = !Ticked;
 	Actor->XLevel	= this;
+	NoteActorSlot( Actor, iActor, 1 );
+	if( bLiveActorsValid )
+		ActorSlots(Actor->GetIndex()).iLive = LiveActors.AddItem( Actor ) + 1;
+	if( bTickListValid )
+	{
+		AddToTickList( Actor );
+		NumLiveActors++;
+	}
+	IndexActor( Actor );
 	if( Class->IsChildOf(APawn::StaticClass) )
 		((APawn*)Actor)->bIsPlayer = bIsPlayer;
 
@@ -99,11 +152,17 @@ AActor* ULevel::SpawnActor
 	Actor->Rotation = Rotation;
 	if( Actor->bCollideActors && Hash  )
 		Hash->AddActor( Actor );
+	if( ActorGrid )
+		ActorGrid->AddActor( Actor, GetActorSeq(Actor) );
 
 	// Init the actor's zone.
 	Actor->Region = FPointRegion(GetLevelInfo());
 	if( Actor->IsA(APawn::StaticClass) )
 		((APawn*)Actor)->FootRegion = ((APawn*)Actor)->HeadRegion = FPointRegion(GetLevelInfo());
+	FlushRegionCache( Actor );
+	FlushSightCache( Actor );
+	FlushRelevancyCache( Actor );
+	FlushRepState( Actor );
 
 	// Set owner.
 	Actor->SetOwner( Owner );
@@ -243,6 +302,8 @@ UBOOL ULevel::DestroyActor( AActor* ThisActor, UBOOL bNetForce )
 			Hash->RemoveActor( ThisActor );
 		Hash->CheckActorNotReferenced( ThisActor );
 	}
+	if( ActorGrid )
+		ActorGrid->RemoveActor( ThisActor );
 	unguard;
 
 	// Tell this actor it's about to be destroyed.
@@ -252,9 +313,33 @@ UBOOL ULevel::DestroyActor( AActor* ThisActor, UBOOL bNetForce )
 		return 1;
 	unguard;
 
-	// Clean up all owned and touching actors.
+	// Clean up all owned and touching actors.  If this actor owns nothing,
+	// only the actors it is touching need looking at, unless one may be
+	// touching it without it touching back, which happens when its touch
+	// list was full.
 	guard(CleanupStandardRefs);
-	for( INT iActor=0; iActor<Num(); iActor++ )
+	INT Index = ThisActor->GetIndex();
+	if( CountOwned(ThisActor)==0 && (Index>=ActorSlots.Num() || !ActorSlots(Index).bOneWayTouch) )
+	{
+		for( INT i=0; i<ARRAY_COUNT(ThisActor->Touching); i++ )
+		{
+			AActor* Other = ThisActor->Touching[i];
+			if( Other && !Other->bDeleteMe )
+			{
+				for( INT j=0; j<ARRAY_COUNT(Other->Touching); j++ )
+				{
+					if( Other->Touching[j]==ThisActor )
+					{
+						ThisActor->EndTouch( Other, 1 );
+						if( ThisActor->bDeleteMe )
+							return 1;
+						break;
+					}
+				}
+			}
+		}
+	}
+	else for( INT iActor=0; iActor<Num(); iActor++ )
 	{
 		AActor* Other = Actors(iActor);
 		if( Other )
@@ -311,8 +396,31 @@ UBOOL ULevel::DestroyActor( AActor* ThisActor, UBOOL bNetForce )
 	// Remove the actor from the actor list.
 	guard(Unlist);
 	check(Actors(iActor)==ThisActor);
+	ThisActor->Unpark();
+	if( bTickListValid )
+	{
+		RemoveFromTickList( ThisActor );
+		NumLiveActors--;
+	}
+	UnindexActor( ThisActor );
+	UnscheduleAI( ThisActor );
+	FlushRepState( ThisActor );
+	NoteOwnerChange( ThisActor->Owner, NULL );
+	INT Index = ThisActor->GetIndex();
+	if( bLiveActorsValid && Index<ActorSlots.Num() && ActorSlots(Index).iLive )
+	{
+		// Move the last live actor into this one's place.
+		AActor* Last = LiveActors( LiveActors.Num()-1 );
+		LiveActors( ActorSlots(Index).iLive-1 ) = Last;
+		ActorSlots(Last->GetIndex()).iLive = ActorSlots(Index).iLive;
+		LiveActors.Remove( LiveActors.Num()-1 );
+		ActorSlots(Index).iLive = 0;
+	}
 	Actors(iActor) = NULL;
 	ThisActor->bDeleteMe = 1;
+	NumActorHoles++;
+	if( !GIsEditor && !bNoActorSlots && iActor>=iFirstDynamicActor )
+		FreeActorSlots.AddItem( iActor );
 	unguard;
 
 	// Do object destroy.
@@ -343,24 +451,173 @@ UBOOL ULevel::DestroyActor( AActor* ThisActor, UBOOL bNetForce )
 }
 
 //
-// Compact the actor list.
+// Compact the actor list.  During play the holes left by DestroyActor are
+// filled by SpawnActor, so only those at the end are removed, and actors
+// keep their indices for as long as they are listed.
 //
 void ULevel::CompactActors()
 {
 	guard(ULevel::CompactActors);
+	if( !GIsEditor && !bNoActorSlots )
+	{
+		while( NumActorHoles>0 && Num()>iFirstDynamicActor && !Actors(Num()-1) )
+		{
+			Remove( Num()-1 );
+			NumActorHoles--;
+		}
+		return;
+	}
 	INT c = iFirstDynamicActor;
 	for( INT i=iFirstDynamicActor; i<Num(); i++ )
 	{
 		if( Actors(i) )
 		{
 			if( !Actors(i)->bDeleteMe )
+			{
+				if( c != i )
+					NoteActorSlot( Actors(i), c );
 				Actors(c++) = Actors(i);
-			else
-				debugf( "Undeleted %s", Actors(i)->GetFullName() );
+			}
+			else debugf( "Undeleted %s", Actors(i)->GetFullName() );
 		}
 	}
 	if( c != Num() )
 		Remove( c, Num()-c );
+	NumActorHoles = 0;
+	FreeActorSlots.Empty();
+	unguard;
+}
+
+//
+// Remember where an actor is in the actor list, so that GetActorIndex can
+// find it without searching.  Called when an actor is added or moved; a
+// stale entry is only a missed shortcut, since it is checked before use.
+// A newly spawned actor may have taken over the object index of an old
+// one, so its count of owned actors starts again.
+//
+void ULevel::NoteActorSlot( AActor* Actor, INT iActor, UBOOL bSpawned )
+{
+	guardSlow(ULevel::NoteActorSlot);
+	INT Index = Actor->GetIndex();
+	if( Index>=ActorSlots.Num() )
+		ActorSlots.AddZeroed( Index+1-ActorSlots.Num() );
+	ActorSlots(Index).iActor = iActor+1;
+	if( bSpawned )
+	{
+		ActorSlots(Index).iLive        = 0;
+		ActorSlots(Index).NumOwned     = 0;
+		ActorSlots(Index).bOneWayTouch = 0;
+		ActorSlots(Index).Seq          = 0;
+		NoteOwnerChange( NULL, Actor->Owner );
+	}
+	unguardSlow;
+}
+
+//
+// Return the number of listed actors owned by Actor, or INDEX_NONE if it
+// isn't known.  The counts are kept up by SetOwner, which is the only way
+// to change an owner except on network clients, where replication sets it
+// directly, and in the editor.
+//
+INT ULevel::CountOwned( AActor* Actor )
+{
+	guardSlow(ULevel::CountOwned);
+	if( bNoActorSlots || GIsEditor || (NetDriver && NetDriver->ServerConnection) )
+		return INDEX_NONE;
+	if( !bOwnedCountsValid )
+	{
+		for( INT i=0; i<ActorSlots.Num(); i++ )
+			ActorSlots(i).NumOwned = 0;
+		bOwnedCountsValid = 1;
+		for( INT iActor=0; iActor<Num(); iActor++ )
+			if( Actors(iActor) && Actors(iActor)->Owner )
+				NoteOwnerChange( NULL, Actors(iActor)->Owner );
+	}
+	INT Index = Actor->GetIndex();
+	return Index<ActorSlots.Num() ? ActorSlots(Index).NumOwned : 0;
+	unguardSlow;
+}
+
+//
+// Move an owned actor's count from its old owner to its new one.
+//
+void ULevel::NoteOwnerChange( AActor* OldOwner, AActor* NewOwner )
+{
+	guardSlow(ULevel::NoteOwnerChange);
+	if( !bOwnedCountsValid || OldOwner==NewOwner )
+		return;
+	if( OldOwner && OldOwner->GetIndex()<(DWORD)ActorSlots.Num() )
+		ActorSlots(OldOwner->GetIndex()).NumOwned--;
+	if( NewOwner )
+	{
+		INT Index = NewOwner->GetIndex();
+		if( Index>=ActorSlots.Num() )
+			ActorSlots.AddZeroed( Index+1-ActorSlots.Num() );
+		ActorSlots(Index).NumOwned++;
+	}
+	unguardSlow;
+}
+
+//
+// Note that another actor may be touching Actor without Actor touching it
+// back, so that DestroyActor can't rely on Actor's touch list alone.
+//
+void ULevel::NoteOneWayTouch( AActor* Actor )
+{
+	guardSlow(ULevel::NoteOneWayTouch);
+	INT Index = Actor->GetIndex();
+	if( Index>=ActorSlots.Num() )
+		ActorSlots.AddZeroed( Index+1-ActorSlots.Num() );
+	ActorSlots(Index).bOneWayTouch = 1;
+	unguardSlow;
+}
+
+//
+// Return the dense list of listed dynamic actors, in no particular order,
+// or NULL if it isn't kept, in the editor or with the bookkeeping off.
+// Built on first use after the actor list is rearranged, and kept up by
+// SpawnActor and DestroyActor, which also keep the free slot list.  The
+// list order is numbered first, since filling free slots would lose it.
+//
+TArray<AActor*>* ULevel::GetLiveActors()
+{
+	guardSlow(ULevel::GetLiveActors);
+	if( GIsEditor || bNoActorSlots )
+		return NULL;
+	if( !bLiveActorsValid )
+	{
+		BuildActorOrder();
+		FlushLiveActors();
+		bLiveActorsValid = 1;
+		for( INT iActor=Num()-1; iActor>=iFirstDynamicActor; iActor-- )
+		{
+			AActor* Actor = Actors(iActor);
+			if( Actor && !Actor->bDeleteMe )
+			{
+				NoteActorSlot( Actor, iActor );
+				ActorSlots(Actor->GetIndex()).iLive = LiveActors.AddItem( Actor ) + 1;
+			}
+			else if( !Actor )
+				FreeActorSlots.AddItem( iActor );
+		}
+		NumActorHoles = FreeActorSlots.Num();
+	}
+	return &LiveActors;
+	unguardSlow;
+}
+
+//
+// Throw away the live actor list and the free slot list.  They are rebuilt
+// by GetLiveActors.
+//
+void ULevel::FlushLiveActors()
+{
+	guard(ULevel::FlushLiveActors);
+	for( INT i=0; i<LiveActors.Num(); i++ )
+		ActorSlots(LiveActors(i)->GetIndex()).iLive = 0;
+	LiveActors.Empty();
+	FreeActorSlots.Empty();
+	bLiveActorsValid = 0;
 	unguard;
 }
 
@@ -373,9 +630,12 @@ void ULevel::CleanupDestroyed( UBOOL bForce )
 {
 	guard(ULevel::CleanupDestroyed);
 
-	// Pack actor list.
+	// Pack actor list and indices.
 	if( !GIsEditor && !bForce )
+	{
 		CompactActors();
+		PurgeActorIndices();
+	}
 
 	// If nothing deleted, exit.
 	if( !FirstDeleted )
@@ -417,14 +677,616 @@ void ULevel::CleanupDestroyed( UBOOL bForce )
 		FirstDeleted        = FirstDeleted->Deleted;
 		check(ActorToKill->bDeleteMe);
 
-		// Destroy the actor.
+		// Destroy the actor, or keep it for reuse.  Forced cleanups come
+		// before saving and travelling, so they leave nothing behind.
+		if( bForce || !RecycleActor( ActorToKill ) )
+			delete ActorToKill;
+	}
+	unguard;
+
+	unguard;
+}
+
+/*-----------------------------------------------------------------------------
+	Actor pools.
+-----------------------------------------------------------------------------*/
+
+// Default number of actors kept by a pool.
+#define DEFAULT_POOL_MAX	64
+
+//
+// Read the pools from the [ActorPool] section of the ini file, as
+// ClassName=Max lines, unless that has already been done.
+//
+void ULevel::ConfigureActorPools()
+{
+	guard(ULevel::ConfigureActorPools);
+	if( bActorPoolsConfigured )
+		return;
+	bActorPoolsConfigured = 1;
+	char Text[4096], *Next;
+	GetConfigSection( "ActorPool", Text, ARRAY_COUNT(Text) );
+	for( char* Ptr=Text; *Ptr; Ptr=Next )
+	{
+		Next = Ptr + appStrlen(Ptr) + 1;
+		char* Value = appStrstr( Ptr, "=" );
+		if( !Value )
+			continue;
+		*Value++ = 0;
+
+		// Accept Package.Class as well as plain class names.
+		char* Name = Ptr;
+		for( char* Dot=appStrstr(Name,"."); Dot; Dot=appStrstr(Name,".") )
+			Name = Dot+1;
+		FActorPool* Pool = new(ActorPools)FActorPool;
+		appMemset( Pool, 0, sizeof(FActorPool) );
+		Pool->ClassName = FName( Name );
+		Pool->Max       = appAtoi( Value );
+	}
+	unguard;
+}
+
+//
+// Find the pool for a class, or NULL if it isn't pooled.  Only the exact
+// class is pooled, since a pooled actor can only be reconstructed as the
+// class it already is.
+//
+FActorPool* ULevel::FindActorPool( UClass* Class )
+{
+	guardSlow(ULevel::FindActorPool);
+	if( !bActorPoolsConfigured )
+		ConfigureActorPools();
+	for( INT i=0; i<ActorPools.Num(); i++ )
+	{
+		FActorPool& Pool = ActorPools(i);
+		if( Pool.Class==Class )
+			return &Pool;
+		if( !Pool.Class && Pool.ClassName==Class->GetFName() )
+		{
+			Pool.Class = Class;
+			return &Pool;
+		}
+	}
+	return NULL;
+	unguardSlow;
+}
+
+//
+// Start pooling a class, or change how many of it are kept.  A Max of zero
+// or less stops pooling the class.
+//
+void ULevel::SetActorPool( UClass* Class, INT Max )
+{
+	guard(ULevel::SetActorPool);
+	FActorPool* Pool = FindActorPool( Class );
+	if( !Pool && Max>0 )
+	{
+		Pool = new(ActorPools)FActorPool;
+		appMemset( Pool, 0, sizeof(FActorPool) );
+		Pool->ClassName = Class->GetFName();
+		Pool->Class     = Class;
+	}
+	if( Pool )
+	{
+		TrimActorPool( *Pool, Max );
+		Pool->Max = Max;
+		if( Max<=0 )
+			ActorPools.Remove( Pool - &ActorPools(0) );
+	}
+	unguard;
+}
+
+//
+// Take a destroyed actor into its class's pool if there is room.  Called
+// by CleanupDestroyed once all references to the actor have been cleared.
+// The actor is wiped back to its class defaults straight away, so that
+// while it waits it neither keeps other objects alive nor points at ones
+// which have since been deleted.
+//
+UBOOL ULevel::RecycleActor( AActor* Actor )
+{
+	guardSlow(ULevel::RecycleActor);
+	if( bNoActorPool || GIsEditor )
+		return 0;
+	UClass* Class = Actor->GetClass();
+	FActorPool* Pool = FindActorPool( Class );
+	if( !Pool || Pool->Num>=Pool->Max )
+		return 0;
+	GObj.InitProperties( Class, (BYTE*)Actor, Class->GetPropertiesSize(), Class, NULL, 0 );
+	Actor->bDeleteMe = 1;
+	Actor->Deleted   = Pool->First;
+	Pool->First      = Actor;
+	Pool->Num++;
+	Pool->Recycled++;
+	return 1;
+	unguardSlow;
+}
+
+//
+// Delete pooled actors until no more than Max are left.
+//
+void ULevel::TrimActorPool( FActorPool& Pool, INT Max )
+{
+	guard(ULevel::TrimActorPool);
+	while( Pool.First && Pool.Num>::Max(Max,0) )
+	{
+		AActor* ActorToKill = Pool.First;
+		Pool.First          = ActorToKill->Deleted;
+		Pool.Num--;
 		delete ActorToKill;
 	}
 	unguard;
+}
+
+//
+// Delete every pooled actor, keeping the pools themselves.
+//
+void ULevel::FlushActorPools()
+{
+	guard(ULevel::FlushActorPools);
+	for( INT i=0; i<ActorPools.Num(); i++ )
+		TrimActorPool( ActorPools(i), 0 );
+	unguard;
+}
+
+/*-----------------------------------------------------------------------------
+	Actor indices.
+-----------------------------------------------------------------------------*/
+
+//
+// Sort index entries into sequence number order.
+//
+static INT CDECL CompareIndexEntries( const void* A, const void* B )
+{
+	DWORD SeqA = ((FActorIndexEntry*)A)->Seq;
+	DWORD SeqB = ((FActorIndexEntry*)B)->Seq;
+	return SeqA<SeqB ? -1 : SeqA>SeqB ? 1 : 0;
+}
+
+//
+// Position of the first entry in an index whose sequence number is at least Seq.
+//
+static INT FindIndexEntry( const FActorIndex& Index, DWORD Seq )
+{
+	INT Min=0, Max=Index.Entries.Num();
+	while( Min<Max )
+	{
+		INT Mid = (Min+Max)/2;
+		if( Index.Entries(Mid).Seq < Seq )
+			Min = Mid+1;
+		else
+			Max = Mid;
+	}
+	return Min;
+}
+
+//
+// Add an actor to an index, keeping it in sequence order.  Actors are
+// usually appended, but one whose tag changes may land in the middle.
+//
+static void AddIndexEntry( FActorIndex& Index, AActor* Actor, DWORD Seq )
+{
+	INT i = FindIndexEntry( Index, Seq );
+	if( i<Index.Entries.Num() && Index.Entries(i).Seq==Seq )
+	{
+		// Rejoining a list it left before the list was purged.
+		if( !Index.Entries(i).Actor )
+			Index.NumHoles--;
+		Index.Entries(i).Actor = Actor;
+		return;
+	}
+	Index.Entries.Add();
+	if( i<Index.Entries.Num()-1 )
+		appMemmove( &Index.Entries(i+1), &Index.Entries(i), (Index.Entries.Num()-1-i)*sizeof(FActorIndexEntry) );
+	Index.Entries(i).Actor = Actor;
+	Index.Entries(i).Seq   = Seq;
+}
+
+//
+// Take an actor out of an index, leaving a hole.
+//
+static void RemoveIndexEntry( FActorIndex& Index, DWORD Seq )
+{
+	INT i = FindIndexEntry( Index, Seq );
+	if( i<Index.Entries.Num() && Index.Entries(i).Seq==Seq && Index.Entries(i).Actor )
+	{
+		Index.Entries(i).Actor = NULL;
+		Index.NumHoles++;
+	}
+}
+
+//
+// Index slot listing a class or tag, or INDEX_NONE if it isn't listed yet.
+//
+static INT GetIndexSlot( TArray<INT>& Slots, DWORD Index )
+{
+	return Index<(DWORD)Slots.Num() ? Slots(Index)-1 : INDEX_NONE;
+}
+static void SetIndexSlot( TArray<INT>& Slots, DWORD Index, INT iSlot )
+{
+	if( Index>=(DWORD)Slots.Num() )
+		Slots.AddZeroed( Index+1-Slots.Num() );
+	Slots(Index) = iSlot+1;
+}
+
+//
+// Called when script assigns an actor's Tag.  The assignment may also have
+// been to a class's default Tag, which isn't a live object.
+//
+static void ActorTagLet( BYTE* Var )
+{
+	UObject* Object = (UObject*)(Var - GLetWatchProperty->Offset);
+	if
+	(	GObj.GetIndexedObject(Object->GetIndex())==Object
+	&&	Object->IsA(AActor::StaticClass)
+	&&	((AActor*)Object)->XLevel )
+		((AActor*)Object)->XLevel->ActorTagChanged( (AActor*)Object );
+}
+
+//
+// Return the slot of the index to walk for an AllActors query, building
+// it if needed, or INDEX_NONE if the actor list must be scanned.  A tag
+// list is preferred because it is almost always the shorter one.
+//
+INT ULevel::FindActorIndex( UClass* Class, FName Tag )
+{
+	guard(ULevel::FindActorIndex);
+	if( bNoActorIndex || GIsEditor )
+		return INDEX_NONE;
+
+	// Note each actor's place in the list order and its tag the first time
+	// the indices are needed.
+	if( !bActorIndexValid )
+	{
+		FlushActorIndices();
+		for( INT i=0; i<Num(); i++ )
+		{
+			AActor* Actor = Actors(i);
+			if( Actor && !Actor->bDeleteMe )
+			{
+				DWORD Index = Actor->GetIndex();
+				if( Index>=(DWORD)ActorIndexInfo.Num() )
+					ActorIndexInfo.AddZeroed( Index+1-ActorIndexInfo.Num() );
+				ActorIndexInfo(Index).Seq = GetActorSeq( Actor );
+				ActorIndexInfo(Index).Tag = Actor->Tag;
+			}
+		}
+		bActorIndexValid = 1;
+
+		// Watch script assignments to Tag.  The hook is set first, since
+		// execLet calls it as soon as the property matches.
+		if( !GLetWatchProperty )
+		{
+			for( TFieldIterator<UNameProperty> It(AActor::StaticClass); It; ++It )
+			{
+				if( appStricmp(It->GetName(),"Tag")==0 )
+				{
+					GLetWatchHook     = ActorTagLet;
+					GLetWatchProperty = *It;
+					break;
+				}
+			}
+		}
+	}
+
+	// Find an existing list.
+	TArray<INT>& Slots = Tag!=NAME_None ? TagIndexSlots : ClassIndexSlots;
+	DWORD        Key   = Tag!=NAME_None ? Tag.GetIndex() : Class->GetIndex();
+	INT          iSlot = GetIndexSlot( Slots, Key );
+	if( iSlot!=INDEX_NONE )
+		return iSlot;
+
+	// Build a new one.
+	iSlot = ActorIndices.AddZeroed();
+	ActorIndices(iSlot).Class = Tag!=NAME_None ? NULL : Class;
+	ActorIndices(iSlot).Tag   = Tag;
+	UBOOL bSorted = 1;
+	DWORD LastSeq = 0;
+	for( INT i=0; i<Num(); i++ )
+	{
+		AActor* Actor = Actors(i);
+		if( Actor && !Actor->bDeleteMe && (Tag!=NAME_None ? Actor->Tag==Tag : Actor->IsA(Class)) )
+		{
+			// The actor list is in list order unless a spawned actor has
+			// filled a destroyed one's slot.
+			DWORD Seq = GetActorSeq( Actor );
+			FActorIndexEntry* Entry = new(ActorIndices(iSlot).Entries)FActorIndexEntry;
+			Entry->Actor = Actor;
+			Entry->Seq   = Seq;
+			bSorted      = bSorted && Seq>LastSeq;
+			LastSeq      = Seq;
+		}
+	}
+	if( !bSorted )
+		appQsort( &ActorIndices(iSlot).Entries(0), ActorIndices(iSlot).Entries.Num(), sizeof(FActorIndexEntry), CompareIndexEntries );
+	SetIndexSlot( Slots, Key, iSlot );
+	return iSlot;
+	unguard;
+}
+
+//
+// Return the next live actor in an index after the one with sequence number
+// LastSeq, or NULL if there are no more.  iEntry is where to look first; the
+// list may have changed under the caller since it was last stepped.
+//
+static AActor* NextIndexEntry( FActorIndex& Index, INT& iEntry, DWORD& LastSeq )
+{
+	INT Count = Index.Entries.Num();
+	if
+	(	iEntry>Count
+	||	(iEntry>0     && Index.Entries(iEntry-1).Seq>LastSeq)
+	||	(iEntry<Count && Index.Entries(iEntry  ).Seq<=LastSeq) )
+		iEntry = FindIndexEntry( Index, LastSeq+1 );
+	while( iEntry<Count )
+	{
+		FActorIndexEntry& Entry = Index.Entries(iEntry++);
+		LastSeq = Entry.Seq;
+		if( Entry.Actor && !Entry.Actor->bDeleteMe )
+			return Entry.Actor;
+	}
+	return NULL;
+}
+AActor* ULevel::NextIndexedActor( INT iIndex, INT& iEntry, DWORD& LastSeq )
+{
+	guardSlow(ULevel::NextIndexedActor);
+	if( !bActorIndexValid || iIndex>=ActorIndices.Num() )
+		return NULL;
+	return NextIndexEntry( ActorIndices(iIndex), iEntry, LastSeq );
+	unguardSlow;
+}
+
+//
+// Add a newly spawned actor to the indices listing it.
+//
+void ULevel::IndexActor( AActor* Actor )
+{
+	guard(ULevel::IndexActor);
+
+	// It comes after every actor already listed.
+	DWORD Index = Actor->GetIndex();
+	if( bActorOrderValid )
+	{
+		FActorIndexEntry* Entry = new(ActorOrder.Entries)FActorIndexEntry;
+		Entry->Actor = Actor;
+		Entry->Seq   = ActorSlots(Index).Seq = ++NextListSeq;
+	}
+	if( !bActorIndexValid )
+		return;
+
+	if( Index>=(DWORD)ActorIndexInfo.Num() )
+		ActorIndexInfo.AddZeroed( Index+1-ActorIndexInfo.Num() );
+	FActorIndexInfo& Info = ActorIndexInfo(Index);
+	Info.Seq = GetActorSeq( Actor );
+	Info.Tag = Actor->Tag;
+
+	for( UClass* Class=Actor->GetClass(); Class; Class=Class->GetSuperClass() )
+	{
+		INT iSlot = GetIndexSlot( ClassIndexSlots, Class->GetIndex() );
+		if( iSlot!=INDEX_NONE )
+			AddIndexEntry( ActorIndices(iSlot), Actor, Info.Seq );
+	}
+	INT iSlot = GetIndexSlot( TagIndexSlots, Info.Tag.GetIndex() );
+	if( iSlot!=INDEX_NONE )
+		AddIndexEntry( ActorIndices(iSlot), Actor, Info.Seq );
+	unguard;
+}
+
+//
+// Take a destroyed actor out of the indices listing it.
+//
+void ULevel::UnindexActor( AActor* Actor )
+{
+	guard(ULevel::UnindexActor);
+	DWORD Index = Actor->GetIndex();
+	if( bActorOrderValid && Index<(DWORD)ActorSlots.Num() && ActorSlots(Index).Seq )
+	{
+		RemoveIndexEntry( ActorOrder, ActorSlots(Index).Seq );
+		ActorSlots(Index).Seq = 0;
+	}
+	if( !bActorIndexValid || Index>=(DWORD)ActorIndexInfo.Num() || !ActorIndexInfo(Index).Seq )
+		return;
+
+	FActorIndexInfo& Info = ActorIndexInfo(Index);
+	for( UClass* Class=Actor->GetClass(); Class; Class=Class->GetSuperClass() )
+	{
+		INT iSlot = GetIndexSlot( ClassIndexSlots, Class->GetIndex() );
+		if( iSlot!=INDEX_NONE )
+			RemoveIndexEntry( ActorIndices(iSlot), Info.Seq );
+	}
+	INT iSlot = GetIndexSlot( TagIndexSlots, Info.Tag.GetIndex() );
+	if( iSlot!=INDEX_NONE )
+		RemoveIndexEntry( ActorIndices(iSlot), Info.Seq );
+	Info.Seq = 0;
+	Info.Tag = NAME_None;
+	unguard;
+}
+
+//
+// Move an actor whose Tag has been changed to its new tag list.
+//
+void ULevel::ActorTagChanged( AActor* Actor )
+{
+	guard(ULevel::ActorTagChanged);
+	DWORD Index = Actor->GetIndex();
+	if( !bActorIndexValid || Actor->bDeleteMe || Index>=(DWORD)ActorIndexInfo.Num() )
+		return;
+	FActorIndexInfo& Info = ActorIndexInfo(Index);
+	if( !Info.Seq || Info.Tag==Actor->Tag )
+		return;
+
+	INT iOld = GetIndexSlot( TagIndexSlots, Info.Tag.GetIndex() );
+	if( iOld!=INDEX_NONE )
+		RemoveIndexEntry( ActorIndices(iOld), Info.Seq );
+	INT iNew = GetIndexSlot( TagIndexSlots, Actor->Tag.GetIndex() );
+	if( iNew!=INDEX_NONE )
+		AddIndexEntry( ActorIndices(iNew), Actor, Info.Seq );
+	Info.Tag = Actor->Tag;
+	unguard;
+}
+
+//
+// Squeeze the holes out of lists, including the list order, which have
+// collected a lot of them.  Must not be called while script may be iterating.
+//
+static void PurgeIndex( FActorIndex& Index )
+{
+	if( Index.NumHoles>0 && Index.NumHoles*4>=Index.Entries.Num() )
+	{
+		INT c=0;
+		for( INT j=0; j<Index.Entries.Num(); j++ )
+			if( Index.Entries(j).Actor )
+				Index.Entries(c++) = Index.Entries(j);
+		Index.Entries.Remove( c, Index.Entries.Num()-c );
+		Index.NumHoles = 0;
+	}
+}
+void ULevel::PurgeActorIndices()
+{
+	guard(ULevel::PurgeActorIndices);
+	for( INT i=0; i<ActorIndices.Num(); i++ )
+		PurgeIndex( ActorIndices(i) );
+	PurgeIndex( ActorOrder );
+	unguard;
+}
+
+//
+// Throw away all actor indices.  They are rebuilt on demand.
+//
+void ULevel::FlushActorIndices()
+{
+	guard(ULevel::FlushActorIndices);
+	for( INT i=0; i<ActorIndices.Num(); i++ )
+		ActorIndices(i).Entries.Empty();
+	ActorIndices.Empty();
+	ClassIndexSlots.Empty();
+	TagIndexSlots.Empty();
+	ActorIndexInfo.Empty();
+	bActorIndexValid = 0;
+	unguard;
+}
+
+//
+// Number the listed actors in list order, if they aren't already.  Until
+// SpawnActor fills a free slot, list order is the actor list's order, and
+// from then on only spawned actors are numbered, after all the others.
+// The order isn't kept in the editor, which doesn't fill free slots.
+//
+void ULevel::BuildActorOrder()
+{
+	guard(ULevel::BuildActorOrder);
+	if( bActorOrderValid || GIsEditor )
+		return;
+	FlushActorOrder();
+	for( INT i=0; i<Num(); i++ )
+	{
+		AActor* Actor = Actors(i);
+		if( Actor && !Actor->bDeleteMe )
+		{
+			INT Index = Actor->GetIndex();
+			if( Index>=ActorSlots.Num() )
+				ActorSlots.AddZeroed( Index+1-ActorSlots.Num() );
+			FActorIndexEntry* Entry = new(ActorOrder.Entries)FActorIndexEntry;
+			Entry->Actor = Actor;
+			Entry->Seq   = ActorSlots(Index).Seq = ++NextListSeq;
+		}
+	}
+	bActorOrderValid = 1;
+	unguard;
+}
 
+//
+// Throw away the list order, and the actor indices and location grid which
+// are sorted by it.  Called when the actor list is rearranged.
+//
+void ULevel::FlushActorOrder()
+{
+	guard(ULevel::FlushActorOrder);
+	for( INT i=0; i<ActorOrder.Entries.Num(); i++ )
+		if( ActorOrder.Entries(i).Actor )
+			ActorSlots(ActorOrder.Entries(i).Actor->GetIndex()).Seq = 0;
+	ActorOrder.Entries.Empty();
+	ActorOrder.NumHoles = 0;
+	NextListSeq         = 0;
+	bActorOrderValid    = 0;
+	FlushActorIndices();
+	if( ActorGrid )
+	{
+		delete ActorGrid;
+		ActorGrid = NULL;
+	}
 	unguard;
 }
 
+//
+// Return where a listed actor comes in list order.
+//
+DWORD ULevel::GetActorSeq( AActor* Actor )
+{
+	guardSlow(ULevel::GetActorSeq);
+	BuildActorOrder();
+	INT Index = Actor->GetIndex();
+	return Index<ActorSlots.Num() ? ActorSlots(Index).Seq : 0;
+	unguardSlow;
+}
+
+//
+// Return the next listed actor after the one numbered LastSeq in list
+// order, or NULL if there are no more, for the iterators which would
+// otherwise scan the actor list.  iNext is where to look first.  In the
+// editor the list order isn't kept, and iNext steps through the actor list.
+//
+AActor* ULevel::NextListedActor( INT& iNext, DWORD& LastSeq )
+{
+	guardSlow(ULevel::NextListedActor);
+	if( GIsEditor )
+	{
+		while( iNext<Num() )
+		{
+			AActor* Actor = Actors(iNext++);
+			if( Actor && !Actor->bDeleteMe )
+				return Actor;
+		}
+		return NULL;
+	}
+	BuildActorOrder();
+	return NextIndexEntry( ActorOrder, iNext, LastSeq );
+	unguardSlow;
+}
+
+//
+// FActorQuery implementation.
+//
+FActorQuery::FActorQuery( ULevel* InLevel, UClass* InClass, FName InTag )
+:	Level	( InLevel )
+,	Class	( InClass ? InClass : AActor::StaticClass )
+,	Tag		( InTag )
+,	iIndex	( InLevel->FindActorIndex( Class, InTag ) )
+,	iNext	( 0 )
+,	LastSeq	( 0 )
+{}
+AActor* FActorQuery::Next()
+{
+	guardSlow(FActorQuery::Next);
+	if( iIndex!=INDEX_NONE )
+	{
+		// Walk the index; a tag list still has to be checked for class.
+		AActor* Actor;
+		while( (Actor=Level->NextIndexedActor( iIndex, iNext, LastSeq ))!=NULL )
+			if( Actor->IsA(Class) && (Tag==NAME_None || Actor->Tag==Tag) )
+				return Actor;
+	}
+	else
+	{
+		// Walk every listed actor.
+		AActor* Actor;
+		while( (Actor=Level->NextListedActor( iNext, LastSeq ))!=NULL )
+			if(	Actor->IsA(Class) && (Tag==NAME_None || Actor->Tag==Tag) )
+				return Actor;
+	}
+	return NULL;
+	unguardSlow;
+}
+
 /*-----------------------------------------------------------------------------
 	Player spawning.
 -----------------------------------------------------------------------------*/
@@ -460,6 +1322,7 @@ void ULevel::SpawnViewActor( UViewport* Viewport )
 		Viewport->Actor = (ACamera*)SpawnActor( ACamera::StaticClass, NAME_None, NULL, NULL, FVector(-500,-300,+300), FRotator(0,0,0), NULL, 1, 1 );
 		check(Viewport->Actor);
 		Viewport->Actor->Tag = Viewport->GetFName();
+		ActorTagChanged( Viewport->Actor );
 	}
 	unguard;
 
@@ -766,6 +1629,8 @@ UBOOL ULevel::FarMoveActor( AActor* Actor, FVector DestLocation,  UBOOL test, UB
 
 	if( Actor->bCollideActors && Hash ) //&& !test
 		Hash->AddActor( Actor );
+	if( ActorGrid )
+		ActorGrid->RefileActor( Actor );
 
 	// Set the zone after moving, so that if a ZoneChange or ActorEntered/ActorEntered message
 	// tries to move the actor, the hashing will be correct.
@@ -796,6 +1661,30 @@ UBOOL ULevel::DropToFloor( AActor *Actor)
 	unguard;
 }
 
+static FCheckResult* MultiLineCheckActors( FCollisionHashBase* Hash, FMemStack& Mem, const FCheckResult* WorldHit, FVector End, FVector Start, FVector Extent, UBOOL bCheckActors, BYTE ExtraNodeFlags );
+
+//
+// Find the world trace ULevel::BatchProjectileSweeps made for a projectile
+// this tick, if any.
+//
+static FProjectileSweep* FindProjectileSweep( ULevel* Level, AActor* Actor )
+{
+	guardSlow(FindProjectileSweep);
+	if( !Level->NumProjectileSweeps || Actor->Physics!=PHYS_Projectile )
+		return NULL;
+	INT Min=0, Max=Level->NumProjectileSweeps;
+	while( Min<Max )
+	{
+		INT Mid = (Min+Max)/2;
+		if( Level->ProjectileSweeps[Mid].Actor<Actor )
+			Min = Mid+1;
+		else
+			Max = Mid;
+	}
+	return (Min<Level->NumProjectileSweeps && Level->ProjectileSweeps[Min].Actor==Actor) ? &Level->ProjectileSweeps[Min] : NULL;
+	unguardSlow;
+}
+
 //
 // Tries to move the actor by a movement vector.  If no collision occurs, this function 
 // just does a Location+=Move.
@@ -881,8 +1770,30 @@ UBOOL ULevel::MoveActor
 	// Perform movement collision checking if needed for this actor.
 	if( (Actor->bCollideActors || Actor->bCollideWorld) && !Actor->IsMovingBrush() && Delta!=FVector(0,0,0) )
 	{
-		// Check collision along the line.
-		FirstHit = MultiLineCheck
+		// Check collision along the line, using the world trace batched
+		// for this actor at the start of the tick if it's the same trace.
+		FProjectileSweep* Sweep = FindProjectileSweep( this, Actor );
+		if
+		(	Sweep
+		&&	Actor->bCollideWorld
+		&&	Sweep->Start  == Actor->Location
+		&&	Sweep->End    == Actor->Location + TestDelta
+		&&	Sweep->Extent == Actor->GetCylinderExtent() )
+		{
+			NumSweepsUsed++;
+			FirstHit = MultiLineCheckActors
+			(
+				Hash,
+				GMem,
+				Sweep->bHitWorld ? &Sweep->WorldHit : NULL,
+				Sweep->End,
+				Sweep->Start,
+				Sweep->Extent,
+				Actor->bCollideActors ? 1 : 0,
+				0
+			);
+		}
+		else FirstHit = MultiLineCheck
 		(
 			GMem,
 			Actor->Location + TestDelta,
@@ -974,6 +1885,8 @@ UBOOL ULevel::MoveActor
 	Actor->Rotation  = NewRotation;
 	if( Actor->bCollideActors && Hash )
 		Hash->AddActor( Actor );
+	if( ActorGrid )
+		ActorGrid->RefileActor( Actor );
 
 	// Handle bump and touch notifications.
 	if( !bTest )
@@ -1176,35 +2089,12 @@ FCheckResult* ULevel::MultiPointCheck( FMemStack& Mem, FVector Location, FVector
 -----------------------------------------------------------------------------*/
 
 //
-// Trace a line and return the first hit actor (LevelInfo means hit the world geomtry).
+// Pick the nearest hit in a sorted MultiLineCheck list which TraceFlags
+// accepts, skipping SourceActor's owners.  Returns 1 if there was none.
 //
-UBOOL ULevel::SingleLineCheck
-(
-	FCheckResult&	Hit,
-	AActor*			SourceActor,
-	const FVector&	End,
-	const FVector&	Start,
-	DWORD           TraceFlags,
-	FVector			Extent,
-	BYTE			ExtraNodeFlags
-)
+static UBOOL PickLineCheckHit( FCheckResult& Hit, AActor* SourceActor, FCheckResult* FirstHit, DWORD TraceFlags )
 {
-	guard(ULevel::Trace);
-
-	// Get list of hit actors.
-	FMemMark Mark(GMem);
-	FCheckResult* FirstHit = MultiLineCheck
-	(
-		GMem,
-		End,
-		Start,
-		Extent,
-		(TraceFlags & TRACE_AllColliding) ? 1 : 0,
-		(TraceFlags & TRACE_Level       ) ? GetLevelInfo() : NULL,
-		ExtraNodeFlags
-	);
-
-	// Skip owned actors and return the one nearest actor.
+	guardSlow(PickLineCheckHit);
 	FCheckResult* Check;
 	for( Check = FirstHit; Check!=NULL; Check=Check->GetNext() )
 	{
@@ -1253,9 +2143,43 @@ UBOOL ULevel::SingleLineCheck
 		Hit.Time = 1.0;
 		Hit.Actor = NULL;
 	}
+	return Check==NULL;
+	unguardSlow;
+}
+
+//
+// Trace a line and return the first hit actor (LevelInfo means hit the world geomtry).
+//
+UBOOL ULevel::SingleLineCheck
+(
+	FCheckResult&	Hit,
+	AActor*			SourceActor,
+	const FVector&	End,
+	const FVector&	Start,
+	DWORD           TraceFlags,
+	FVector			Extent,
+	BYTE			ExtraNodeFlags
+)
+{
+	guard(ULevel::Trace);
+
+	// Get list of hit actors.
+	FMemMark Mark(GMem);
+	FCheckResult* FirstHit = MultiLineCheck
+	(
+		GMem,
+		End,
+		Start,
+		Extent,
+		(TraceFlags & TRACE_AllColliding) ? 1 : 0,
+		(TraceFlags & TRACE_Level       ) ? GetLevelInfo() : NULL,
+		ExtraNodeFlags
+	);
 
+	// Skip owned actors and return the one nearest actor.
+	UBOOL Result = PickLineCheckHit( Hit, SourceActor, FirstHit, TraceFlags );
 	Mark.Pop();
-	return Check==NULL;
+	return Result;
 	unguard;
 }
 
@@ -1263,31 +2187,34 @@ UBOOL ULevel::SingleLineCheck
 	MultiLineCheck.
 -----------------------------------------------------------------------------*/
 
-FCheckResult* ULevel::MultiLineCheck
+//
+// Second half of MultiLineCheck: given the world hit, if any, clip the
+// trace by it, check the collision hash, and return the sorted list.
+//
+static FCheckResult* MultiLineCheckActors
 (
-	FMemStack&		Mem,
-	FVector			End,
-	FVector			Start,
-	FVector			Extent,
-	UBOOL			bCheckActors,
-	ALevelInfo*		LevelInfo,
-	BYTE			ExtraNodeFlags
+	FCollisionHashBase*	Hash,
+	FMemStack&			Mem,
+	const FCheckResult*	WorldHit,
+	FVector				End,
+	FVector				Start,
+	FVector				Extent,
+	UBOOL				bCheckActors,
+	BYTE				ExtraNodeFlags
 )
 {
-	guard(ULevel::MultiLineCheck);
+	guard(MultiLineCheckActors);
 	INT NumHits=0;
 	FCheckResult Hits[64];
 
-	// Check for collision with the level, and cull by the end point for speed.
+	// Cull by the world hit for speed.
 	FLOAT Dilation = 1.0;
 	INT bOnlyCheckForMovers = 0;
 	INT bHitWorld = 0;
-
-	guard(CheckWithLevel);
-	if( LevelInfo && LevelInfo->XLevel->Model->LineCheck( Hits[NumHits], NULL, End, Start, Extent, ExtraNodeFlags )==0 )
+	if( WorldHit )
 	{
 		bHitWorld = 1;
-		Hits[NumHits].Actor = LevelInfo;
+		Hits[NumHits] = *WorldHit;
 		FLOAT Dist = (Hits[NumHits].Location - Start).Size();
 		Dilation = ::Min(1.f, Hits[NumHits].Time * (Dist + 5)/Dist);
 		End = Start + (End - Start) * Dilation;
@@ -1295,7 +2222,6 @@ FCheckResult* ULevel::MultiLineCheck
 			bOnlyCheckForMovers = 1;
 		NumHits++;
 	}
-	unguard;
 
 	// Check with actors.
 	guard(CheckWithActors);
@@ -1339,10 +2265,257 @@ FCheckResult* ULevel::MultiLineCheck
 	unguard;
 }
 
+FCheckResult* ULevel::MultiLineCheck
+(
+	FMemStack&		Mem,
+	FVector			End,
+	FVector			Start,
+	FVector			Extent,
+	UBOOL			bCheckActors,
+	ALevelInfo*		LevelInfo,
+	BYTE			ExtraNodeFlags
+)
+{
+	guard(ULevel::MultiLineCheck);
+
+	// Check for collision with the level.
+	FCheckResult WorldHit(1.0);
+	UBOOL bHitWorld = 0;
+	guard(CheckWithLevel);
+	if( LevelInfo && LevelInfo->XLevel->Model->LineCheck( WorldHit, NULL, End, Start, Extent, ExtraNodeFlags )==0 )
+	{
+		bHitWorld = 1;
+		WorldHit.Actor = LevelInfo;
+	}
+	unguard;
+
+	return MultiLineCheckActors( Hash, Mem, bHitWorld ? &WorldHit : NULL, End, Start, Extent, bCheckActors, ExtraNodeFlags );
+	unguard;
+}
+
+/*-----------------------------------------------------------------------------
+	BatchLineCheck.
+-----------------------------------------------------------------------------*/
+
+//
+// World geometry pass of a batch, run on the job workers.  Bsp line
+// checks only read the model, so any number of them can run at once.
+//
+struct FBatchWorldCheck
+{
+	UModel*					Model;
+	const FTraceRequest*	Requests;
+	FCheckResult*			WorldHits;
+	BYTE*					bHitWorld;
+};
+static void BatchWorldCheckRange( void* Arg, INT Start, INT End )
+{
+	guard(BatchWorldCheckRange);
+	FBatchWorldCheck& Batch = *(FBatchWorldCheck*)Arg;
+	for( INT i=Start; i<End; i++ )
+	{
+		const FTraceRequest& Request = Batch.Requests[i];
+		Batch.bHitWorld[i] = (Request.TraceFlags & TRACE_Level) && Batch.Model->LineCheck( Batch.WorldHits[i], NULL, Request.End, Request.Start, Request.Extent, Request.NodeFlags )==0;
+	}
+	unguard;
+}
+
+//
+// Trace Count lines, each exactly as SingleLineCheck would unless it only
+// wants the level, storing the results in Hits.  Returns the number of
+// unblocked traces.
+//
+// The traces against world geometry, which are most of the cost of
+// visibility checks, are split across the job workers.  The traces which
+// also check actors then finish on this thread, since the collision hash
+// and GMem aren't thread safe.
+//
+INT ULevel::BatchLineCheck( FCheckResult* Hits, const FTraceRequest* Requests, INT Count )
+{
+	guard(ULevel::BatchLineCheck);
+	if( Count<=0 )
+		return 0;
+	ALevelInfo* LevelInfo = GetLevelInfo();
+
+	// Trace all lines against the world in parallel.
+	FMemMark Mark(GMem);
+	FBatchWorldCheck Batch;
+	Batch.Model     = LevelInfo->XLevel->Model;
+	Batch.Requests  = Requests;
+	Batch.WorldHits = new(GMem,Count)FCheckResult;
+	Batch.bHitWorld = new(GMem,Count)BYTE;
+	for( INT i=0; i<Count; i++ )
+		Batch.WorldHits[i] = FCheckResult(1.0);
+	GJobs.ParallelFor( Count, BatchWorldCheckRange, &Batch, 16 );
+
+	// Resolve each trace.
+	INT NumClear = 0;
+	for( INT i=0; i<Count; i++ )
+	{
+		const FTraceRequest& Request = Requests[i];
+		FMemMark HitMark(GMem);
+		if( Batch.bHitWorld[i] )
+			Batch.WorldHits[i].Actor = LevelInfo;
+		FCheckResult* FirstHit = MultiLineCheckActors
+		(
+			Hash,
+			GMem,
+			Batch.bHitWorld[i] ? &Batch.WorldHits[i] : NULL,
+			Request.End,
+			Request.Start,
+			Request.Extent,
+			Request.bCheckActors,
+			Request.NodeFlags
+		);
+		NumClear += PickLineCheckHit( Hits[i], Request.SourceActor, FirstHit, Request.TraceFlags );
+		HitMark.Pop();
+	}
+	Mark.Pop();
+	return NumClear;
+	unguard;
+}
+
 /*-----------------------------------------------------------------------------
 	ULevel zone functions.
 -----------------------------------------------------------------------------*/
 
+//
+// Find the region containing a point belonging to an actor, such as its
+// location or a pawn's feet, using the actor's region cache slot.  A point
+// stays in the same Bsp leaf until it crosses one of the planes on the way
+// down to it, so the Bsp walk is skipped while the point is closer to where
+// it was last looked up than to any of those planes.
+//
+FPointRegion ULevel::CachedPointRegion( AActor* Actor, INT Slot, FVector Location )
+{
+	guard(ULevel::CachedPointRegion);
+	debug(Slot>=0 && Slot<REGION_MAX);
+	NumRegionLookups++;
+	TotalRegionLookups++;
+	if( bNoRegionCache || GIsEditor )
+		return Model->PointRegion( GetLevelInfo(), Location );
+
+	// Look for a hit.
+	INT Index = Actor->GetIndex();
+	if( Index>=ActorRegions.Num() )
+		ActorRegions.AddZeroed( Index+1-ActorRegions.Num() );
+	FRegionCacheSlot& Cache = ActorRegions(Index).Slots[Slot];
+	if( (Location - Cache.Location).SizeSquared() < Square(Cache.SafeRadius) )
+	{
+		NumRegionHits++;
+		TotalRegionHits++;
+		return FPointRegion( GetZoneActor(Cache.ZoneNumber), Cache.iLeaf, Cache.ZoneNumber );
+	}
+
+	// Walk the Bsp and remember the result.
+	FPointRegion Result = Model->PointRegion( GetLevelInfo(), Location, Cache.SafeRadius );
+	Cache.Location   = Location;
+	Cache.iLeaf      = Result.iLeaf;
+	Cache.ZoneNumber = Result.ZoneNumber;
+	return Result;
+	unguard;
+}
+
+//
+// Forget the regions cached for an actor, so that they are next looked up
+// in the Bsp.  Called when an object index is reused.
+//
+void ULevel::FlushRegionCache( AActor* Actor )
+{
+	guard(ULevel::FlushRegionCache);
+	INT Index = Actor->GetIndex();
+	if( Index<ActorRegions.Num() )
+		appMemset( &ActorRegions(Index), 0, sizeof(FActorRegionCache) );
+	unguard;
+}
+
+/*-----------------------------------------------------------------------------
+	ULevel line of sight cache.
+-----------------------------------------------------------------------------*/
+
+//
+// Look for the result of traces Viewer made to Target with the same
+// Variant recently, from about the same place to about the same place.
+// Returns an ESightResult, or INDEX_NONE if the traces must be made.
+//
+INT ULevel::FindCachedSight( AActor* Viewer, AActor* Target, INT Variant )
+{
+	guard(ULevel::FindCachedSight);
+	NumSightLookups++;
+	TotalSightLookups++;
+	INT Index = Viewer->GetIndex();
+	if( bNoSightCache || GIsEditor || Index>=ActorSights.Num() )
+		return INDEX_NONE;
+
+	FLOAT Tolerance = SightTolerance>0.f ? SightTolerance : 16.f;
+	FLOAT Lifetime  = SightLifetime >0.f ? SightLifetime  : 0.25f;
+	FActorSightCache& Cache = ActorSights(Index);
+	for( INT i=0; i<SIGHT_SLOTS; i++ )
+	{
+		FSightCacheSlot& Slot = Cache.Slots[i];
+		if
+		(	Slot.Target==Target
+		&&	Slot.Variant==Variant
+		&&	TimeSeconds-Slot.Time>=0.f
+		&&	TimeSeconds-Slot.Time<=Lifetime
+		&&	(Viewer->Location-Slot.ViewerLocation).SizeSquared()<=Square(Tolerance)
+		&&	(Target->Location-Slot.TargetLocation).SizeSquared()<=Square(Tolerance) )
+		{
+			NumSightHits++;
+			TotalSightHits++;
+			return Slot.Result;
+		}
+	}
+	return INDEX_NONE;
+	unguard;
+}
+
+//
+// Remember the result of traces Viewer just made to Target.
+//
+void ULevel::CacheSight( AActor* Viewer, AActor* Target, INT Variant, INT Result )
+{
+	guard(ULevel::CacheSight);
+	if( bNoSightCache || GIsEditor )
+		return;
+	INT Index = Viewer->GetIndex();
+	if( Index>=ActorSights.Num() )
+		ActorSights.AddZeroed( Index+1-ActorSights.Num() );
+	FActorSightCache& Cache = ActorSights(Index);
+
+	// Replace the slot for the same target and variant, or the oldest.
+	INT i;
+	for( i=0; i<SIGHT_SLOTS; i++ )
+		if( Cache.Slots[i].Target==Target && Cache.Slots[i].Variant==Variant )
+			break;
+	if( i==SIGHT_SLOTS )
+	{
+		i = Cache.iNext;
+		Cache.iNext = (Cache.iNext + 1) % SIGHT_SLOTS;
+	}
+	FSightCacheSlot& Slot = Cache.Slots[i];
+	Slot.Target         = Target;
+	Slot.ViewerLocation = Viewer->Location;
+	Slot.TargetLocation = Target->Location;
+	Slot.Time           = TimeSeconds;
+	Slot.Variant        = Variant;
+	Slot.Result         = Result;
+	unguard;
+}
+
+//
+// Forget the lines of sight cached for an actor.  Called when an object
+// index is reused.
+//
+void ULevel::FlushSightCache( AActor* Actor )
+{
+	guard(ULevel::FlushSightCache);
+	INT Index = Actor->GetIndex();
+	if( Index<ActorSights.Num() )
+		appMemset( &ActorSights(Index), 0, sizeof(FActorSightCache) );
+	unguard;
+}
+
 //
 // Figure out which zone an actor is in, update the actor's iZone,
 // and notify the actor of the zone change.  Skips the zone notification
@@ -1372,10 +2545,11 @@ void ULevel::SetActorZone( AActor* Actor, UBOOL bTest, UBOOL bForceRefresh )
 		Actor->Region = FPointRegion(GetLevelInfo());
 		if( Pawn )
 			Pawn->FootRegion = Pawn->HeadRegion = FPointRegion(GetLevelInfo());
+		FlushRegionCache( Actor );
 	}
 
 	// Find zone based on actor's location and see if it has changed.
-	FPointRegion NewRegion = Model->PointRegion( Num() ? GetLevelInfo() : (ALevelInfo*)Actor, Actor->Location );
+	FPointRegion NewRegion = Num() ? CachedPointRegion( Actor, REGION_Actor, Actor->Location ) : Model->PointRegion( (ALevelInfo*)Actor, Actor->Location );
 	if( NewRegion.Zone!=Actor->Region.Zone )
 	{
 		// Notify old zone info of player leaving.
@@ -1396,13 +2570,13 @@ void ULevel::SetActorZone( AActor* Actor, UBOOL bTest, UBOOL bForceRefresh )
 	if( Pawn )
 	{
 		// Update foot region.
-		FPointRegion NewFootRegion = Model->PointRegion( GetLevelInfo(), Pawn->Location - FVector(0,0,Pawn->CollisionHeight) );
+		FPointRegion NewFootRegion = CachedPointRegion( Pawn, REGION_Foot, Pawn->Location - FVector(0,0,Pawn->CollisionHeight) );
 		if( NewFootRegion.Zone!=Pawn->FootRegion.Zone && !bTest )
 			Pawn->eventFootZoneChange(NewFootRegion.Zone);
 		Pawn->FootRegion = NewFootRegion;
 
 		// Update head region.
-		FPointRegion NewHeadRegion = Model->PointRegion( GetLevelInfo(), Pawn->Location + FVector(0,0,Pawn->EyeHeight) );
+		FPointRegion NewHeadRegion = CachedPointRegion( Pawn, REGION_Head, Pawn->Location + FVector(0,0,Pawn->EyeHeight) );
 		if( NewHeadRegion.Zone!=Pawn->HeadRegion.Zone && !bTest )
 			Pawn->eventHeadZoneChange(NewHeadRegion.Zone);
 		Pawn->HeadRegion = NewHeadRegion;
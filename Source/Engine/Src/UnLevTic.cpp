@@ -53,19 +53,27 @@ struct FActorPriority
 	Tick a single actor.
 -----------------------------------------------------------------------------*/
 
+//
+// Whether an actor is in stasis, and so isn't being ticked.
+//
+static inline UBOOL InStasis( AActor* Actor )
+{
+	return Actor->bStasis 
+		&& (Actor->bForceStasis || (Actor->Physics==PHYS_None) || (Actor->Physics == PHYS_Rotating))
+		&& (Actor->XLevel->TimeSeconds - Actor->XLevel->Model->Nodes->Zones[Actor->Region.ZoneNumber].LastRenderTime > 5)
+		&& (Actor->Level->NetMode == NM_Standalone);
+}
+
 UBOOL AActor::Tick( FLOAT DeltaSeconds, ELevelTick TickType )
 {
 	guard(AActor::Tick);
 
 	// Ignore actors in stasis
-	if ( bStasis 
-		&& (bForceStasis || (Physics==PHYS_None) || (Physics == PHYS_Rotating))
-		&& (XLevel->TimeSeconds - XLevel->Model->Nodes->Zones[Region.ZoneNumber].LastRenderTime > 5)
-		&& (Level->NetMode == NM_Standalone) )
+	if( InStasis(this) )
 		return 1;
 
 	// Handle owner-first updating.
-	if( Owner && (INT)Owner->bTicked!=XLevel->Ticked )
+	if( Owner && (INT)Owner->bTicked!=XLevel->Ticked && !XLevel->IsParked(Owner) )
 	{
 		XLevel->NewlySpawned = new(GDynMem)FActorLink(this,XLevel->NewlySpawned);
 		return 0;
@@ -323,18 +331,9 @@ UBOOL AActor::Tick( FLOAT DeltaSeconds, ELevelTick TickType )
 
 		if ( (Role == ROLE_Authority) && (TickType==LEVELTICK_All) )
 		{
-			if( Pawn->SightCounter < 0.0 )
-				Pawn->SightCounter += 0.2;
-
-			Pawn->SightCounter = Pawn->SightCounter - DeltaSeconds; 
-			if( Pawn->bIsPlayer && !Pawn->bHidden )
-				Pawn->ShowSelf();
-
-			if( (Pawn->SightCounter < 0.0) && Pawn->IsProbing(NAME_EnemyNotVisible) )
-			{
-				Pawn->CheckEnemyVisible();
-				Pawn->SightCounter = 0.1;
-			}
+			// Sight runs on frame time, since the AI scheduler keeps it
+			// going while it skips the pawn.
+			Pawn->TickSight( XLevel->ScheduleDelta>0.0 ? XLevel->ScheduleDelta : DeltaSeconds );
 
 			if( Pawn->PainTime > 0.0 )
 			{
@@ -361,6 +360,110 @@ UBOOL AActor::Tick( FLOAT DeltaSeconds, ELevelTick TickType )
 	unguard;
 }
 
+/*-----------------------------------------------------------------------------
+	Replicated property change tracking.
+-----------------------------------------------------------------------------*/
+
+//
+// Copy one element of a replicated property, leaving the other bits
+// sharing a bool's DWORD alone.
+//
+static void CopyRepElement( UProperty* Property, INT Index, BYTE* Dest, BYTE* Src )
+{
+	INT Offset = Property->Offset + Index*Property->GetElementSize();
+	UBoolProperty* Bool = Cast<UBoolProperty>( Property );
+	if( !Bool )
+		appMemcpy( Dest + Offset, Src + Offset, Property->GetElementSize() );
+	else
+		*(DWORD*)(Dest + Offset) = (*(DWORD*)(Dest + Offset) & ~Bool->BitMask) | (*(DWORD*)(Src + Offset) & Bool->BitMask);
+}
+
+//
+// Find which of an actor's replicated properties have changed since the
+// last time this was called for it, stamping them with RepSerial.  An actor
+// is only compared once per net tick however many connections replicate it.
+// Returns the actor's record, or NULL if changes aren't being tracked.
+//
+FActorRepState* ULevel::UpdateRepState( AActor* Actor )
+{
+	guard(ULevel::UpdateRepState);
+	if( bNoRepTracking || GIsEditor )
+		return NULL;
+	INT Index = Actor->GetIndex();
+	if( Index>=ActorRepStates.Num() )
+		ActorRepStates.AddZeroed( Index+1-ActorRepStates.Num() );
+	FActorRepState& State = ActorRepStates(Index);
+	if( State.Class!=Actor->GetClass() )
+	{
+		// New to us, so everything has changed.
+		FlushRepState( Actor );
+		INT Size    = Actor->GetClass()->Defaults.Num();
+		State.Class  = Actor->GetClass();
+		State.Shadow = (BYTE*)appMalloc( Size, "FActorRepState" );
+		appMemcpy( State.Shadow, Actor, Size );
+		for( UClass* RepClass=State.Class; RepClass; RepClass=RepClass->GetSuperClass() )
+		{
+			for( FRepLink* Link=RepClass->Reps; Link; Link=Link->Next )
+			{
+				State.NumLinks++;
+				State.NumElements += Link->Property->ArrayDim;
+				if( Link->Property->PropertyFlags & CPF_NetAlways )
+					State.bNetAlways = 1;
+			}
+		}
+		State.Changed = (INT*)appMalloc( ::Max(State.NumLinks,1)*sizeof(INT), "FActorRepState" );
+		for( INT i=0; i<State.NumLinks; i++ )
+			State.Changed[i] = RepSerial;
+		State.CheckedSerial = State.LastChange = RepSerial;
+	}
+	else if( State.CheckedSerial!=RepSerial )
+	{
+		// Compare with the last check.
+		INT iLink = 0;
+		for( UClass* RepClass=State.Class; RepClass; RepClass=RepClass->GetSuperClass() )
+		{
+			for( FRepLink* Link=RepClass->Reps; Link; Link=Link->Next, iLink++ )
+			{
+				UProperty* It = Link->Property;
+				for( INT i=0; i<It->ArrayDim; i++ )
+				{
+					if( !It->Matches(Actor,State.Shadow,i) )
+					{
+						CopyRepElement( It, i, State.Shadow, (BYTE*)Actor );
+						State.Changed[iLink] = State.LastChange = RepSerial;
+					}
+				}
+			}
+		}
+		State.CheckedSerial = RepSerial;
+	}
+	return &State;
+	unguard;
+}
+
+//
+// Forget which of an actor's replicated properties have changed, or every
+// actor's if Actor is NULL.
+//
+void ULevel::FlushRepState( AActor* Actor )
+{
+	guard(ULevel::FlushRepState);
+	INT First = Actor ? Actor->GetIndex() : 0;
+	INT Last  = Actor ? Actor->GetIndex() : ActorRepStates.Num()-1;
+	for( INT i=First; i<=Last && i<ActorRepStates.Num(); i++ )
+	{
+		FActorRepState& State = ActorRepStates(i);
+		if( State.Shadow )
+			appFree( State.Shadow );
+		if( State.Changed )
+			appFree( State.Changed );
+		appMemset( &State, 0, sizeof(FActorRepState) );
+	}
+	if( !Actor )
+		ActorRepStates.Empty();
+	unguard;
+}
+
 /*-----------------------------------------------------------------------------
 	Network client tick.
 -----------------------------------------------------------------------------*/
@@ -368,7 +471,9 @@ UBOOL AActor::Tick( FLOAT DeltaSeconds, ELevelTick TickType )
 void ULevel::TickNetClient( FLOAT DeltaSeconds )
 {
 	guard(ULevel::TickNetClient);
+	profileZone("ULevel::TickNetClient");
 	uclock(NetTickCycles);
+	RepSerial++;
 	if( NetDriver->ServerConnection->State==USOCK_Open )
 	{
 		for( FTypedChannelIterator<FActorChannel> It(NetDriver->ServerConnection); It; ++It )
@@ -510,9 +615,11 @@ INT ULevel::ServerTickClient( UNetConnection* Connection, FLOAT DeltaSeconds )
 void ULevel::TickNetServer( FLOAT DeltaSeconds )
 {
 	guard(ULevel::TickNetServer);
+	profileZone("ULevel::TickNetServer");
 
 	// Update all clients.
 	uclock(NetTickCycles);
+	RepSerial++;
 	INT Updated=0;
 	INT i;
 	for( i=0; i<NetDriver->Connections.Num(); i++ )
@@ -551,6 +658,468 @@ void ULevel::TickNetServer( FLOAT DeltaSeconds )
 	unguard;
 }
 
+/*-----------------------------------------------------------------------------
+	Tick list.
+-----------------------------------------------------------------------------*/
+
+//
+// Make sure the tick list is ready for use: rebuild it if the actor list
+// has been rearranged, or squeeze out the holes left by destroyed and
+// parked actors once there are enough of them.  The list holds the dynamic
+// actors which aren't parked, in actor list order as far as possible;
+// actors that are spawned or unparked later go on the end, and
+// owner-before-owned ticking is still enforced by AActor::Tick.
+//
+void ULevel::UpdateTickList()
+{
+	guard(ULevel::UpdateTickList);
+	if( !bTickListValid )
+	{
+		for( INT i=0; i<ActorSchedule.Num(); i++ )
+			ActorSchedule(i).iTick = 0;
+		TickList.Empty();
+		NumTickHoles   = 0;
+		NumLiveActors  = 0;
+		bTickListValid = 1;
+		for( INT iActor=0; iActor<Num(); iActor++ )
+		{
+			AActor* Actor = Actors(iActor);
+			if( Actor && !Actor->bDeleteMe )
+			{
+				NumLiveActors++;
+				if( iActor>=iFirstDynamicActor && !IsParked(Actor) )
+					AddToTickList( Actor );
+			}
+		}
+	}
+	else if( NumTickHoles > 32 + TickList.Num()/4 )
+	{
+		INT c=0;
+		for( INT i=0; i<TickList.Num(); i++ )
+		{
+			AActor* Actor = TickList(i);
+			if( Actor )
+			{
+				TickList(c++) = Actor;
+				ActorSchedule(Actor->GetIndex()).iTick = c;
+			}
+		}
+		TickList.Remove( c, TickList.Num()-c );
+		NumTickHoles = 0;
+	}
+	unguard;
+}
+
+//
+// Add an actor to the end of the tick list.
+//
+void ULevel::AddToTickList( AActor* Actor )
+{
+	guardSlow(ULevel::AddToTickList);
+	if( !bTickListValid )
+		return;
+	INT Index = Actor->GetIndex();
+	if( Index>=ActorSchedule.Num() )
+		ActorSchedule.AddZeroed( Index+1-ActorSchedule.Num() );
+	FActorSchedule& Schedule = ActorSchedule(Index);
+	if( !Schedule.iTick )
+		Schedule.iTick = TickList.AddItem( Actor ) + 1;
+	unguardSlow;
+}
+
+//
+// Remove an actor from the tick list, leaving a hole so that the list may
+// be safely modified while it is being ticked.
+//
+void ULevel::RemoveFromTickList( AActor* Actor )
+{
+	guardSlow(ULevel::RemoveFromTickList);
+	INT Index = Actor->GetIndex();
+	if( Index<ActorSchedule.Num() && ActorSchedule(Index).iTick )
+	{
+		TickList(ActorSchedule(Index).iTick-1) = NULL;
+		ActorSchedule(Index).iTick = 0;
+		NumTickHoles++;
+	}
+	unguardSlow;
+}
+
+/*-----------------------------------------------------------------------------
+	Actor parking.
+-----------------------------------------------------------------------------*/
+
+// Actors due to wake sooner than this aren't worth parking.
+#define MIN_PARK_DELAY		0.1f
+
+// Seconds between checks of parked actors for changes made behind their backs.
+#define PARK_CHECK_PERIOD	1.0f
+
+//
+// Return whether this actor is idle, meaning that ticking it does nothing
+// but count down its timer or a latent Sleep.  WakeDelay is set to the
+// number of seconds until one of those needs attention, or to zero if the
+// actor can stay idle until something happens to it.
+//
+UBOOL AActor::IsIdle( FLOAT& WakeDelay )
+{
+	guardSlow(AActor::IsIdle);
+	if
+	(	Role!=ROLE_Authority
+	||	RemoteRole==ROLE_AutonomousProxy
+	||	bIsPawn
+	||	bDeleteMe
+	||	bAlwaysTick
+	||	Physics!=PHYS_None
+	||	LifeSpan!=0.0
+	||	IsAnimating()
+	||	IsProbing(NAME_Tick) )
+		return 0;
+
+	// Timer.
+	UBOOL bWake = 0;
+	WakeDelay   = 0.0;
+	if( TimerRate>0.0 )
+	{
+		WakeDelay = TimerRate - TimerCounter;
+		bWake     = 1;
+	}
+
+	// State code, which may only be sleeping.
+	FMainFrame* Frame = GetMainFrame();
+	if( Frame && Frame->Code )
+	{
+		if( Frame->LatentAction!=EPOLL_Sleep )
+			return 0;
+		if( !bWake || LatentFloat<WakeDelay )
+			WakeDelay = LatentFloat;
+		bWake = 1;
+	}
+	return !bWake || WakeDelay>=MIN_PARK_DELAY;
+	unguardSlow;
+}
+
+//
+// Stop ticking an idle actor until WakeDelay seconds have passed, or forever
+// if WakeDelay is zero.  The actor is woken early by anything that could
+// change its idleness: events, function calls, state changes, SetTimer,
+// SetPhysics, animation, and destruction.
+//
+void ULevel::ParkActor( AActor* Actor, FLOAT WakeDelay )
+{
+	guardSlow(ULevel::ParkActor);
+	INT Index = Actor->GetIndex();
+	if( Index>=ActorSchedule.Num() )
+		ActorSchedule.AddZeroed( Index+1-ActorSchedule.Num() );
+	FActorSchedule& Schedule = ActorSchedule(Index);
+	check(!Schedule.bParked);
+	Schedule.bParked  = 1;
+	Schedule.ParkTime = ScheduleTime;
+	Schedule.iTimer   = WakeDelay>0.0 ? TimerWheel->Schedule( Actor, ScheduleTime + WakeDelay ) : 0;
+	NumParked++;
+	RemoveFromTickList( Actor );
+	unguardSlow;
+}
+
+//
+// Resume ticking a parked actor, crediting its timer and latent Sleep with
+// the time it spent parked.
+//
+void ULevel::UnparkActor( AActor* Actor )
+{
+	guardSlow(ULevel::UnparkActor);
+	INT Index = Actor->GetIndex();
+	if( Index>=ActorSchedule.Num() || !ActorSchedule(Index).bParked )
+		return;
+	FActorSchedule& Schedule = ActorSchedule(Index);
+
+	// The current frame's time is applied by the actor's own tick.
+	FLOAT Elapsed = ::Max( ScheduleTime - ScheduleDelta - Schedule.ParkTime, 0.f );
+	if( Actor->TimerRate>0.0 )
+		Actor->TimerCounter += Elapsed;
+	FMainFrame* Frame = Actor->GetMainFrame();
+	if( Frame && Frame->Code && Frame->LatentAction==EPOLL_Sleep )
+		Actor->LatentFloat -= Elapsed;
+
+	if( Schedule.iTimer )
+		TimerWheel->Cancel( Schedule.iTimer );
+	Schedule.iTimer  = 0;
+	Schedule.bParked = 0;
+	NumParked--;
+	NumWoken++;
+	if( !Actor->bDeleteMe )
+		AddToTickList( Actor );
+	unguardSlow;
+}
+
+//
+// Resume ticking all parked actors.
+//
+void ULevel::UnparkAllActors()
+{
+	guard(ULevel::UnparkAllActors);
+	for( INT i=0; i<Num() && NumParked>0; i++ )
+		if( Actors(i) && IsParked(Actors(i)) )
+			UnparkActor( Actors(i) );
+	unguard;
+}
+
+//
+// Advance the schedule by DeltaSeconds and wake all parked actors which are
+// due during this frame.  Called before the actors are ticked.
+//
+void ULevel::TickParkedActors( FLOAT DeltaSeconds )
+{
+	guard(ULevel::TickParkedActors);
+	if( !TimerWheel )
+		TimerWheel = new FTimerWheel;
+	ScheduleTime += DeltaSeconds;
+	ScheduleDelta = DeltaSeconds;
+	if( bNoParking )
+	{
+		if( NumParked )
+			UnparkAllActors();
+		return;
+	}
+
+	// Wake actors whose timers or sleeps are due.
+	TArray<AActor*> Expired;
+	TimerWheel->Advance( ScheduleTime, Expired );
+	for( INT i=0; i<Expired.Num(); i++ )
+	{
+		// The wheel has already freed the node.
+		ActorSchedule(Expired(i)->GetIndex()).iTimer = 0;
+		UnparkActor( Expired(i) );
+	}
+
+	// Script may change another actor's variables directly without
+	// notifying it, so now and then make sure parked actors are still idle.
+	if( NumParked && ScheduleTime>=NextParkCheck )
+	{
+		NextParkCheck = ScheduleTime + PARK_CHECK_PERIOD;
+		for( INT iActor=iFirstDynamicActor; iActor<Num(); iActor++ )
+		{
+			FLOAT WakeDelay;
+			AActor* Actor = Actors(iActor);
+			if( Actor && IsParked(Actor) && !Actor->IsIdle(WakeDelay) )
+				UnparkActor( Actor );
+		}
+	}
+	unguard;
+}
+
+/*-----------------------------------------------------------------------------
+	AI update scheduling.
+-----------------------------------------------------------------------------*/
+
+// Default distances from the nearest player beyond which AI is throttled.
+#define AI_NEAR_DIST		1600.f
+#define AI_FAR_DIST			4000.f
+
+// Default seconds between ticks of throttled pawns.
+#define AI_MID_INTERVAL		0.1f
+#define AI_FAR_INTERVAL		0.25f
+
+// Default milliseconds per frame spent on queued enemy sight checks.
+#define AI_SENSE_BUDGET		1.0f
+
+//
+// Count down a pawn's sight timer, show a player to the pawns around it,
+// and check that the pawn can still see its enemy when the timer runs out.
+// Called every frame, even while the AI scheduler is skipping the pawn.
+//
+void APawn::TickSight( FLOAT DeltaSeconds )
+{
+	guardSlow(APawn::TickSight);
+	if( SightCounter < 0.0 )
+		SightCounter += 0.2;
+
+	SightCounter = SightCounter - DeltaSeconds; 
+	if( bIsPlayer && !bHidden )
+		ShowSelf();
+
+	if( (SightCounter < 0.0) && IsProbing(NAME_EnemyNotVisible) && !XLevel->QueueSense(this) )
+	{
+		CheckEnemyVisible();
+		SightCounter = 0.1;
+	}
+	unguardSlow;
+}
+
+//
+// Note where the players are viewing from this frame.
+//
+void ULevel::UpdateAIViewers()
+{
+	guard(ULevel::UpdateAIViewers);
+	AIViewers.Empty();
+	for( APawn* Pawn=GetLevelInfo()->PawnList; Pawn; Pawn=Pawn->nextPawn )
+	{
+		APlayerPawn* PlayerPawn = Cast<APlayerPawn>(Pawn);
+		if( PlayerPawn && PlayerPawn->Player )
+			AIViewers.AddItem( PlayerPawn->ViewTarget ? PlayerPawn->ViewTarget->Location : PlayerPawn->Location );
+	}
+	unguard;
+}
+
+//
+// Decide whether a pawn is ticked this frame.  Pawns near a player are
+// ticked every frame; monsters further away are ticked less often, with
+// DeltaSeconds set to all the time they have missed, so script Tick, state
+// code, latent moves and physics all catch up at once.  Skipped pawns still
+// count down their sight timer every frame so that they see and are seen on
+// schedule, unless they are in stasis.  Players, bots and anything not
+// simulated here are never skipped.
+//
+// The missed time is only given up by AITicked, once the pawn's Tick has
+// run.  A pawn put off until after its owner is asked again, with a
+// DeltaSeconds of zero, and gets the same missed time.
+//
+UBOOL ULevel::ScheduleAI( APawn* Pawn, FLOAT& DeltaSeconds )
+{
+	guardSlow(ULevel::ScheduleAI);
+	INT Index = Pawn->GetIndex();
+	if( Index>=ActorSchedule.Num() )
+		ActorSchedule.AddZeroed( Index+1-ActorSchedule.Num() );
+	FActorSchedule& Schedule = ActorSchedule(Index);
+
+	// Pick the interval from the distance to the nearest player, keeping
+	// monsters in a zone that is on screen fairly smooth.
+	FLOAT Interval = 0.0;
+	if
+	(	!bNoAISchedule
+	&&	!Pawn->bIsPlayer
+	&&	!Pawn->bAlwaysTick
+	&&	Pawn->Role==ROLE_Authority
+	&&	Pawn->RemoteRole!=ROLE_AutonomousProxy )
+	{
+		FLOAT NearDist = AINearDist>0.0 ? AINearDist : AI_NEAR_DIST;
+		FLOAT FarDist  = AIFarDist >0.0 ? AIFarDist  : AI_FAR_DIST;
+		FLOAT DistSq   = Square(FarDist) + 1.0;
+		for( INT i=0; i<AIViewers.Num(); i++ )
+			DistSq = ::Min( DistSq, (AIViewers(i) - Pawn->Location).SizeSquared() );
+		if( DistSq > Square(NearDist) )
+		{
+			if( DistSq > Square(FarDist) && TimeSeconds - Model->Nodes->Zones[Pawn->Region.ZoneNumber].LastRenderTime > 1.0 )
+				Interval = AIFarInterval>0.0 ? AIFarInterval : AI_FAR_INTERVAL;
+			else
+				Interval = AIMidInterval>0.0 ? AIMidInterval : AI_MID_INTERVAL;
+		}
+	}
+	if( Interval!=Schedule.AIInterval )
+	{
+		if( Schedule.AIInterval==0.0 )
+		{
+			// Stagger newly throttled pawns so they don't all come due together.
+			FLOAT Phase = Index * 0.618034f;
+			Schedule.AINextTime = ScheduleTime + Interval * (Phase - appFloor(Phase));
+		}
+		else Schedule.AINextTime = ::Min( Schedule.AINextTime, ScheduleTime + Interval );
+		Schedule.AIInterval = Interval;
+	}
+
+	// Skip the pawn if it isn't due yet.
+	Schedule.AIDelta += DeltaSeconds;
+	if( Interval>0.0 && ScheduleTime<Schedule.AINextTime )
+	{
+		Pawn->bTicked = Ticked;
+		if( !InStasis(Pawn) )
+			Pawn->TickSight( DeltaSeconds );
+		NumAISkipped++;
+		return 0;
+	}
+	DeltaSeconds = ::Min( Schedule.AIDelta, 0.4f );
+	return 1;
+	unguardSlow;
+}
+
+//
+// Note that a pawn the AI scheduler let through has been ticked.
+//
+void ULevel::AITicked( APawn* Pawn )
+{
+	guardSlow(ULevel::AITicked);
+	INT Index = Pawn->GetIndex();
+	if( Index<ActorSchedule.Num() )
+	{
+		FActorSchedule& Schedule = ActorSchedule(Index);
+		Schedule.AIDelta    = 0.0;
+		Schedule.AINextTime = ScheduleTime + Schedule.AIInterval;
+	}
+	unguardSlow;
+}
+
+//
+// Forget an actor's AI schedule when it is destroyed.
+//
+void ULevel::UnscheduleAI( AActor* Actor )
+{
+	guardSlow(ULevel::UnscheduleAI);
+	INT Index = Actor->GetIndex();
+	if( Index>=ActorSchedule.Num() )
+		return;
+	FActorSchedule& Schedule = ActorSchedule(Index);
+	if( Schedule.bSenseQueued )
+		for( INT i=0; i<SenseQueue.Num(); i++ )
+			if( SenseQueue(i)==Actor )
+				SenseQueue(i) = NULL;
+	Schedule.bSenseQueued = 0;
+	Schedule.AIInterval   = 0.0;
+	Schedule.AINextTime   = 0.0;
+	Schedule.AIDelta      = 0.0;
+	unguardSlow;
+}
+
+//
+// Put a pawn whose sight timer has run out in line for its enemy check,
+// returning 0 if the check should be made straight away instead.
+//
+UBOOL ULevel::QueueSense( APawn* Pawn )
+{
+	guardSlow(ULevel::QueueSense);
+	if( bNoAISchedule || GIsEditor )
+		return 0;
+	INT Index = Pawn->GetIndex();
+	if( Index>=ActorSchedule.Num() )
+		ActorSchedule.AddZeroed( Index+1-ActorSchedule.Num() );
+	FActorSchedule& Schedule = ActorSchedule(Index);
+	if( !Schedule.bSenseQueued )
+	{
+		Schedule.bSenseQueued = 1;
+		SenseQueue.AddItem( Pawn );
+	}
+	return 1;
+	unguardSlow;
+}
+
+//
+// Make the queued enemy checks, oldest first, until this frame's budget is
+// spent.  At least one is made each frame, and the rest wait their turn.
+//
+void ULevel::TickSenseQueue()
+{
+	guard(ULevel::TickSenseQueue);
+	DOUBLE StartTime = appSeconds();
+	DOUBLE Budget    = (AISenseBudget>0.0 ? AISenseBudget : AI_SENSE_BUDGET) / 1000.0;
+	INT i, Sensed=0;
+	for( i=0; i<SenseQueue.Num(); i++ )
+	{
+		if( Sensed && !bNoAISchedule && appSeconds()-StartTime>=Budget )
+			break;
+		APawn* Pawn = SenseQueue(i);
+		if( !Pawn )
+			continue;
+		ActorSchedule(Pawn->GetIndex()).bSenseQueued = 0;
+		if( Pawn->bDeleteMe || !Pawn->IsProbing(NAME_EnemyNotVisible) )
+			continue;
+		Pawn->CheckEnemyVisible();
+		Pawn->SightCounter = 0.1;
+		Sensed++;
+	}
+	SenseQueue.Remove( 0, i );
+	NumAISensed += Sensed;
+	unguard;
+}
+
 /*-----------------------------------------------------------------------------
 	Main level timer tick handler.
 -----------------------------------------------------------------------------*/
@@ -562,6 +1131,7 @@ void ULevel::TickNetServer( FLOAT DeltaSeconds )
 void ULevel::Tick( ELevelTick TickType, FLOAT DeltaSeconds )
 {
 	guard(ULevel::Tick);
+	profileZone("ULevel::Tick");
 	InitStats();
 	FMemMark Mark(GMem);
 	FMemMark DynMark(GDynMem);
@@ -571,7 +1141,10 @@ void ULevel::Tick( ELevelTick TickType, FLOAT DeltaSeconds )
 	// Update the net code and fetch all incoming packets.
 	if( NetDriver )
 	{
-		NetDriver->Tick();
+		{
+			profileZone("UNetDriver::Tick");
+			NetDriver->Tick();
+		}
 		if( NetDriver->ServerConnection )
 			TickNetClient( DeltaSeconds );
 	}
@@ -599,21 +1172,99 @@ void ULevel::Tick( ELevelTick TickType, FLOAT DeltaSeconds )
 	&&	(!Info->Pauser[0])
 	&&	(!NetDriver || !NetDriver->ServerConnection || NetDriver->ServerConnection->State==USOCK_Open) )
 	{
-		// Tick all actors, owners before owned.
+		// Wake parked actors which are due.
+		profileZone("ULevel::TickActors");
 		uclock(ActorTickCycles);
+		UBOOL bCanPark = (TickType==LEVELTICK_All);
+		if( bCanPark )
+			TickParkedActors( DeltaSeconds );
+		bCanPark = bCanPark && !bNoParking;
+
+		// Tick all actors, owners before owned.
 		NewlySpawned=NULL;
 		INT Updated=0;
-		for( INT iActor=iFirstDynamicActor; iActor<Num(); iActor++ )
-			if( Actors(iActor) )
-				Updated += Actors(iActor)->Tick(DeltaSeconds,TickType);
+		if( GIsEditor )
+		{
+			// The editor may rearrange the actor list at any time, so don't trust the tick list.
+			for( INT iActor=iFirstDynamicActor; iActor<Num(); iActor++ )
+				if( Actors(iActor) )
+					Updated += Actors(iActor)->Tick(DeltaSeconds,TickType);
+		}
+		else
+		{
+			// Actors spawned or woken during the loop are appended and ticked this frame.
+			UpdateTickList();
+			if( TickType==LEVELTICK_All )
+			{
+				BatchProjectileSweeps( DeltaSeconds );
+				UpdateAIViewers();
+			}
+			for( INT i=0; i<TickList.Num(); i++ )
+			{
+				FLOAT WakeDelay;
+				AActor* Actor = TickList(i);
+				if( !Actor )
+					continue;
+				if( Actor->bIsPawn && TickType==LEVELTICK_All && !Actor->IsA(APlayerPawn::StaticClass) )
+				{
+					// Monsters and bots, which may be ticked less often.
+					FLOAT ActorDelta = DeltaSeconds;
+					uclock(AITickCycles);
+					UBOOL bTick = ScheduleAI( (APawn*)Actor, ActorDelta );
+					if( bTick )
+					{
+						NumTicked++;
+						if( Actor->Tick( ActorDelta, TickType ) )
+						{
+							Updated++;
+							AITicked( (APawn*)Actor );
+						}
+					}
+					uunclock(AITickCycles);
+					continue;
+				}
+				NumTicked++;
+				if( Actor->Tick(DeltaSeconds,TickType) )
+				{
+					Updated++;
+					if( bCanPark && (INT)Actor->bTicked==Ticked && Actor->IsIdle(WakeDelay) )
+						ParkActor( Actor, WakeDelay );
+				}
+			}
+		}
 		while( NewlySpawned && Updated )
 		{
 			FActorLink* Link=NewlySpawned;
 			NewlySpawned=NULL;
 			Updated=0;
 			for( Link; Link; Link=Link->Next )
-				Updated += Link->Actor->Tick( DeltaSeconds, TickType );
+			{
+				FLOAT WakeDelay;
+				AActor* Actor = Link->Actor;
+				if( Actor->bIsPawn && TickType==LEVELTICK_All && !GIsEditor && !Actor->IsA(APlayerPawn::StaticClass) )
+				{
+					// Give put off monsters and bots the time the scheduler gave them.
+					FLOAT ActorDelta = 0.0;
+					if( ScheduleAI( (APawn*)Actor, ActorDelta ) && Actor->Tick( ActorDelta, TickType ) )
+					{
+						Updated++;
+						AITicked( (APawn*)Actor );
+					}
+					continue;
+				}
+				if( Actor->Tick( DeltaSeconds, TickType ) )
+				{
+					Updated++;
+					if( bCanPark && (INT)Actor->bTicked==Ticked && Actor->IsIdle(WakeDelay) )
+						ParkActor( Actor, WakeDelay );
+				}
+			}
 		}
+		if( TickType==LEVELTICK_All )
+			TickSenseQueue();
+		ProjectileSweeps    = NULL;
+		NumProjectileSweeps = 0;
+		ScheduleDelta = 0.0;
 	}
 	else if( Info->Pauser[0] )
 	{
@@ -633,6 +1284,29 @@ void ULevel::Tick( ELevelTick TickType, FLOAT DeltaSeconds )
 				Actors(iActor)->Tick(DeltaSeconds,TickType);
 		}
 	}
+	else if( TickType==LEVELTICK_TimeOnly && bHibernating )
+	{
+		// Keep the server support actors, such as the LAN beacon and the
+		// master server uplink, answering queries and sending heartbeats.
+		// Parked ones are left alone until their timers wake them, as in
+		// a normal tick.
+		TickParkedActors( DeltaSeconds );
+		NewlySpawned=NULL;
+		for( INT iActor=iFirstDynamicActor; iActor<Num(); iActor++ )
+		{
+			AActor* Actor = Actors(iActor);
+			if( !Actor || IsParked(Actor) )
+				continue;
+			for( INT i=0; i<ServerActorClasses.Num(); i++ )
+			{
+				if( Actor->IsA(ServerActorClasses(i)) )
+				{
+					Actor->Tick( DeltaSeconds, LEVELTICK_All );
+					break;
+				}
+			}
+		}
+	}
 	uunclock(ActorTickCycles);
 
 	// Update net server.
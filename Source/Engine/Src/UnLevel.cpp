@@ -120,9 +120,9 @@ void ULevel::SetActorCollision( UBOOL bCollision )
 	// Init collision if first time through.
 	if( bCollision && !Hash )
 	{
-		// Init hash.
+		// Init hash.  -OLDHASH selects the original linked-list hash.
 		guard(StartCollision);
-		Hash = GNewCollisionHash();
+		Hash = ParseParam(appCmdLine(),"OLDHASH") ? GNewCollisionHash() : GNewCollisionGrid();
 		for( INT i=0; i<Num(); i++ )
 			if( Actors(i) && Actors(i)->bCollideActors )
 				Hash->AddActor( Actors(i) );
@@ -163,6 +163,15 @@ void ULevel::Serialize( FArchive& Ar )
 	if( Ar.Ver() >= 61 )//oldver
 		Ar << TravelNames << TravelItems;
 
+	// Pooled actors are only referenced from here, and are never saved.
+	if( !Ar.IsLoading() && !Ar.IsSaving() )
+	{
+		for( INT i=0; i<ActorPools.Num(); i++ )
+			Ar << ActorPools(i).Class << ActorPools(i).First;
+		for( INT i=0; i<ServerActorClasses.Num(); i++ )
+			Ar << ServerActorClasses(i);
+	}
+
 	unguard;
 }
 void ULevel::Export( FOutputDevice& Out, const char* FileType, int Indent )
@@ -176,167 +185,2088 @@ void ULevel::Export( FOutputDevice& Out, const char* FileType, int Indent )
 		AActor* Actor = Actors(iActor);
 		if( Actor && !Actor->IsA(ACamera::StaticClass) && (AllSelected ||Actor->bSelected) )
 		{
-			Out.Logf( "%sBegin Actor Class=%s Name=%s\r\n", appSpc(Indent), Actor->GetClassName(), Actor->GetName() );
-			GObj.ExportProperties( Actor->GetClass(), (BYTE*)Actor, &Out, Indent+3, Actor->GetClass(), &Actor->GetClass()->Defaults(0) );
-			Out.Logf("%sEnd Actor\r\n",appSpc(Indent));
+			Out.Logf( "%sBegin Actor Class=%s Name=%s\r\n", appSpc(Indent), Actor->GetClassName(), Actor->GetName() );
+			GObj.ExportProperties( Actor->GetClass(), (BYTE*)Actor, &Out, Indent+3, Actor->GetClass(), &Actor->GetClass()->Defaults(0) );
+			Out.Logf("%sEnd Actor\r\n",appSpc(Indent));
+		}
+	}
+	Out.Logf( "%sEnd Map\r\n", appSpc(Indent) );
+
+	unguard;
+}
+void ULevel::ModifyAllItems()
+{
+	guard(ULevel::ModifyAllItems);
+
+	// Modify all actors that exist.
+	for( int i=0; i<Num(); i++ )
+	{
+		ModifyItem( i );
+		if( Actors(i) )
+			Actors(i)->Modify();
+	}
+	unguard;
+}
+void ULevel::Destroy()
+{
+	guard(ULevel::Destroy);
+
+	// Free the cached collision info.
+	if( Hash )
+	{
+		delete Hash;
+		Hash = NULL; /* Required because actors may try to unhash themselves */
+	}
+
+	if( BrushTracker )
+	{
+		delete BrushTracker;
+		BrushTracker = NULL; /* Required because brushes may clean themselves up */
+	}
+
+	if( TimerWheel )
+	{
+		delete TimerWheel;
+		TimerWheel = NULL;
+	}
+	if( ActorGrid )
+	{
+		delete ActorGrid;
+		ActorGrid = NULL;
+	}
+	if( RoutePlanner )
+	{
+		delete RoutePlanner;
+		RoutePlanner = NULL;
+	}
+	ActorSchedule.Empty();
+	ActorRegions.Empty();
+	ActorSights.Empty();
+	ActorRelevancy.Empty();
+	appMemset( RelevancyViewers, 0, sizeof(RelevancyViewers) );
+	FlushRepState( NULL );
+	AIViewers.Empty();
+	SenseQueue.Empty();
+	ActorPools.Empty();
+	bActorPoolsConfigured = 0;
+	ServerActorClasses.Empty();
+	ActorSlots.Empty();
+	FreeActorSlots.Empty();
+	LiveActors.Empty();
+	NumActorHoles = 0;
+	bOwnedCountsValid = 0;
+	bLiveActorsValid = 0;
+	ActorOrder.Entries.Empty();
+	ActorOrder.NumHoles = 0;
+	NextListSeq = 0;
+	bActorOrderValid = 0;
+	TickList.Empty();
+	NumParked = 0;
+	bTickListValid = 0;
+	FlushActorIndices();
+
+	ULevelBase::Destroy();
+	unguard;
+}
+IMPLEMENT_DB_CLASS(ULevel);
+
+/*-----------------------------------------------------------------------------
+	Reconcile actors and Viewports after loading or creating a new level.
+
+	These functions provide the basic mechanism by which UnrealEd associates
+	Viewports and actors together, even when new maps are loaded which contain
+	an entirely different set of actors which must be mapped onto the existing 
+	Viewports.
+-----------------------------------------------------------------------------*/
+
+//
+// Remember actors.
+//
+void ULevel::RememberActors()
+{
+	guard(ULevel::RememberActors);
+
+	if( Engine->Client )
+	{
+		for( int i=0; i<Engine->Client->Viewports.Num(); i++ )
+		{
+			UViewport* Viewport			= Engine->Client->Viewports(i);
+			Viewport->SavedOrthoZoom	= Viewport->Actor->OrthoZoom;
+			Viewport->SavedFovAngle		= Viewport->Actor->FovAngle;
+			Viewport->SavedShowFlags	= Viewport->Actor->ShowFlags;
+			Viewport->SavedRendMap		= Viewport->Actor->RendMap;
+			Viewport->SavedMisc1		= Viewport->Actor->Misc1;
+			Viewport->SavedMisc2		= Viewport->Actor->Misc2;
+			Viewport->Actor				= NULL;
+		}
+	}
+	unguard;
+}
+
+//
+// Reconcile actors.  This is called after loading a level.
+// It attempts to match each existing Viewport to an actor in the newly-loaded
+// level.  If no decent match can be found, creates a new actor for the Viewport.
+//
+void ULevel::ReconcileActors()
+{
+	guard(ULevel::ReconcileActors);
+	check(GIsEditor);
+
+	// Dissociate all actor Viewports and remember their view properties.
+	int i;
+	for( i=0; i<Num(); i++ )
+		if( Actors(i) && Actors(i)->IsA(APlayerPawn::StaticClass) )
+			if( ((APlayerPawn*)Actors(i))->Player )
+				((APlayerPawn*)Actors(i))->Player = NULL;
+
+	// Match Viewports and Viewport-actors with identical names.
+	guard(MatchIdentical);
+	for( i=0; i<Engine->Client->Viewports.Num(); i++ )
+	{
+		UViewport* Viewport = Engine->Client->Viewports(i);
+		check(Viewport->Actor==NULL);
+		for( INT j=0; j<Num(); j++ )
+		{
+			AActor* Actor = Actors(j);
+			if( Actor && Actor->IsA(ACamera::StaticClass) && appStricmp(*Actor->Tag,Viewport->GetName())==0 )
+			{
+				debugf( NAME_Log, "Matched Viewport %s", Viewport->GetName() );
+				Viewport->Actor         = (APlayerPawn *)Actor;
+				Viewport->Actor->Player = Viewport;
+				break;
+			}
+		}
+	}
+	unguard;
+
+	// Match up all remaining Viewports to actors.
+	guard(MatchEditorOther);
+	for( i=0; i<Engine->Client->Viewports.Num(); i++ )
+	{
+		// Hook Viewport up to an existing actor or createa a new one.
+		UViewport* Viewport = Engine->Client->Viewports(i);
+		if( !Viewport->Actor )
+			SpawnViewActor( Viewport );
+	}
+	unguard;
+
+	// Handle remaining unassociated view actors.
+	guard(KillViews);
+	for( i=0; i<Num(); i++ )
+	{
+		ACamera* View = Cast<ACamera>(Actors(i));
+		if( View )
+		{
+			UViewport* Viewport = Cast<UViewport>(View->Player);
+			if( Viewport )
+			{
+				UViewport* Viewport	= (UViewport*)View->Player;
+				View->ClearFlags( RF_Transactional );
+				View->OrthoZoom		= Viewport->SavedOrthoZoom;	
+				View->FovAngle		= Viewport->SavedFovAngle;
+				View->ShowFlags		= Viewport->SavedShowFlags;
+				View->RendMap		= Viewport->SavedRendMap;
+				View->Misc1			= Viewport->SavedMisc1;
+				View->Misc2			= Viewport->SavedMisc2;
+			}
+			else DestroyActor( View );
+		}
+	}
+	unguard;
+
+	unguard;
+}
+
+/*-----------------------------------------------------------------------------
+	ULevel command-line.
+-----------------------------------------------------------------------------*/
+
+//
+// Time ticking the level with a crowd of idle actors on looping timers,
+// first with idle actors parked and then with every actor ticked.
+//
+static void TimerBench( ULevel* Level, UClass* Class, INT Count, INT Frames, FOutputDevice* Out )
+{
+	guard(TimerBench);
+	FLOAT DeltaSeconds = 0.02f / Level->GetLevelInfo()->TimeDilation;
+
+	// Spawn the crowd.
+	TArray<AActor*> Spawned;
+	FVector Location = Level->GetLevelInfo()->Location;
+	for( INT i=0; i<Count; i++ )
+	{
+		AActor* Actor = Level->SpawnActor( Class, NAME_None, NULL, NULL, Location, FRotator(0,0,0), NULL, 0, 1 );
+		if( Actor )
+		{
+			Actor->TimerCounter = 0.0;
+			Actor->TimerRate    = 0.5 + 4.5 * appFrand();
+			Actor->bTimerLoop   = 1;
+			Spawned.AddItem( Actor );
+		}
+	}
+
+	// Tick with parking, then without.
+	UBOOL  OldNoParking = Level->bNoParking;
+	DOUBLE Seconds[2];
+	INT    Woken[2], Parked[2];
+	for( INT Pass=0; Pass<2; Pass++ )
+	{
+		Level->bNoParking = (Pass==1);
+		Woken[Pass] = Parked[Pass] = 0;
+		DOUBLE StartTime = appSeconds();
+		for( INT i=0; i<Frames; i++ )
+		{
+			Level->Tick( LEVELTICK_All, DeltaSeconds );
+			Woken [Pass] += Level->NumWoken;
+			Parked[Pass] += Level->NumParked;
+		}
+		Seconds[Pass] = appSeconds() - StartTime;
+	}
+	Level->bNoParking = OldNoParking;
+
+	// Clean up.
+	for( INT i=0; i<Spawned.Num(); i++ )
+		if( !Spawned(i)->bDeleteMe )
+			Level->DestroyActor( Spawned(i) );
+
+	Out->Logf
+	(
+		"TIMERBENCH %s: %i actors, %i frames: parked %.3f ms/frame (avg %i parked, %.1f wakes/frame), unparked %.3f ms/frame",
+		Class->GetName(),
+		Spawned.Num(),
+		Frames,
+		1000.0 * Seconds[0] / Frames,
+		Parked[0] / Frames,
+		(FLOAT)Woken[0] / Frames,
+		1000.0 * Seconds[1] / Frames
+	);
+	unguard;
+}
+
+//
+// Random point in a cube.
+//
+static FVector BenchPoint( const FVector& Center, FLOAT Spread )
+{
+	return Center + FVector( appFrand()*2.f-1.f, appFrand()*2.f-1.f, appFrand()*2.f-1.f ) * Spread;
+}
+
+//
+// Run one kind of actor collision check over a set of queries and return
+// the number of actors found, a checksum of which actors each query found
+// regardless of order, and the number found more than once by one query.
+//
+enum ECollisionBenchCheck {CBC_Point, CBC_Line, CBC_LongLine, CBC_Radius, CBC_Encroach, CBC_MAX};
+static INT CollisionBenchRun( FCollisionHashBase* Hash, INT Check, TArray<FVector>& A, TArray<FVector>& B, TArray<FVector>& C, TArray<AActor*>& Movers, DWORD& Checksum, INT& Repeats )
+{
+	guard(CollisionBenchRun);
+	INT Found = 0;
+	Checksum = 0;
+	Repeats  = 0;
+	for( INT i=0; i<A.Num(); i++ )
+	{
+		FMemMark Mark(GMem);
+		FCheckResult* Hit = NULL;
+		switch( Check )
+		{
+			case CBC_Point:    Hit = Hash->ActorPointCheck( GMem, A(i), FVector(17,17,39), 0 ); break;
+			case CBC_Line:     Hit = Hash->ActorLineCheck( GMem, B(i), A(i), (i&1) ? FVector(17,17,39) : FVector(0,0,0), 0 ); break;
+			case CBC_LongLine: Hit = Hash->ActorLineCheck( GMem, C(i), A(i), (i&1) ? FVector(17,17,39) : FVector(0,0,0), 0 ); break;
+			case CBC_Radius:   Hit = Hash->ActorRadiusCheck( GMem, A(i), 512.f, 0 ); break;
+			case CBC_Encroach: Hit = Hash->ActorEncroachmentCheck( GMem, Movers(i%Movers.Num()), A(i), FRotator(0,0,0), 0 ); break;
+		}
+		for( FCheckResult* First=Hit; Hit; Hit=Hit->GetNext() )
+		{
+			Found++;
+			Checksum += (Hit->Actor->GetIndex() + 1) * (2*i + 1);
+			for( FCheckResult* Prev=First; Prev!=Hit; Prev=Prev->GetNext() )
+				if( Prev->Actor==Hit->Actor )
+				{
+					Repeats++;
+					break;
+				}
+		}
+		Mark.Pop();
+	}
+	return Found;
+	unguard;
+}
+
+//
+// Time the original collision hash and the collision grid on the same
+// crowd of colliding actors and the same random checks, and make sure
+// both find the same actors.
+//
+static void CollisionBench( ULevel* Level, UClass* Class, INT Count, INT Queries, FLOAT Spread, FOutputDevice* Out )
+{
+	guard(CollisionBench);
+	FVector Center = Level->GetLevelInfo()->Location;
+
+	// Spawn the crowd.
+	TArray<AActor*> Spawned;
+	for( INT i=0; i<Count; i++ )
+	{
+		AActor* Actor = Level->SpawnActor( Class, NAME_None, NULL, NULL, BenchPoint(Center,Spread), FRotator(0,0,0), NULL, 0, 1 );
+		if( Actor )
+		{
+			Actor->Physics = PHYS_None;
+			Actor->SetCollisionSize( 10.f + 50.f*appFrand(), 20.f + 40.f*appFrand() );
+			Actor->SetCollision( 1, 1, 1 );
+			Spawned.AddItem( Actor );
+		}
+	}
+	if( !Spawned.Num() )
+	{
+		Out->Logf( "COLLISIONBENCH: couldn't spawn any %s", Class->GetName() );
+		return;
+	}
+
+	// Make the queries: points and trace starts, and short and long trace
+	// ends.  The long traces cross enough grid cells for several of them to
+	// share a bucket.
+	TArray<FVector> A, B, C;
+	for( INT i=0; i<Queries; i++ )
+	{
+		A.AddItem( BenchPoint(Center,Spread) );
+		B.AddItem( A(i) + BenchPoint(FVector(0,0,0),1.f).SafeNormal() * 1024.f );
+		C.AddItem( A(i) + BenchPoint(FVector(0,0,0),1.f).SafeNormal() * 8192.f );
+	}
+
+	// Run each check on each structure.
+	static const char* CheckNames[CBC_MAX] = {"point","line","longline","radius","encroach"};
+	DOUBLE Seconds [2][CBC_MAX];
+	INT    Found   [2][CBC_MAX];
+	INT    Repeats [2][CBC_MAX];
+	DWORD  Checksum[2][CBC_MAX];
+	for( INT Pass=0; Pass<2; Pass++ )
+	{
+		DOUBLE StartTime = appSeconds();
+		FCollisionHashBase* Hash = Pass==0 ? GNewCollisionHash() : GNewCollisionGrid();
+		for( INT i=0; i<Spawned.Num(); i++ )
+			Hash->AddActor( Spawned(i) );
+		DOUBLE BuildTime = appSeconds() - StartTime;
+		for( INT Check=0; Check<CBC_MAX; Check++ )
+		{
+			StartTime            = appSeconds();
+			Found  [Pass][Check] = CollisionBenchRun( Hash, Check, A, B, C, Spawned, Checksum[Pass][Check], Repeats[Pass][Check] );
+			Seconds[Pass][Check] = appSeconds() - StartTime;
+		}
+		for( INT i=0; i<Spawned.Num(); i++ )
+			Hash->RemoveActor( Spawned(i) );
+		delete Hash;
+		Out->Logf( "COLLISIONBENCH %s: built in %.3f ms", Pass==0 ? "hash" : "grid", 1000.0 * BuildTime );
+	}
+
+	// Clean up.
+	for( INT i=0; i<Spawned.Num(); i++ )
+		if( !Spawned(i)->bDeleteMe )
+			Level->DestroyActor( Spawned(i) );
+
+	// Report.
+	Out->Logf( "COLLISIONBENCH %s: %i actors, %i queries per check, spread %.0f", Class->GetName(), Spawned.Num(), Queries, Spread );
+	for( INT Check=0; Check<CBC_MAX; Check++ )
+		Out->Logf
+		(
+			"  %-8s hash %8.3f us  grid %8.3f us  (%.2fx)  found %i/%i  repeated %i/%i%s",
+			CheckNames[Check],
+			1000000.0 * Seconds[0][Check] / Queries,
+			1000000.0 * Seconds[1][Check] / Queries,
+			Seconds[1][Check]>0.0 ? Seconds[0][Check] / Seconds[1][Check] : 0.0,
+			Found[0][Check],
+			Found[1][Check],
+			Repeats[0][Check],
+			Repeats[1][Check],
+			(Found[0][Check]!=Found[1][Check] || Checksum[0][Check]!=Checksum[1][Check] || Repeats[1][Check]) ? "  MISMATCH" : ""
+		);
+	unguard;
+}
+
+//
+// Run RadiusActors-style queries, returning the number of actors found
+// and a checksum of the order they were found in.
+//
+static INT RadiusBenchRun( ULevel* Level, TArray<FVector>& Points, FLOAT Radius, UBOOL bAddCollisionRadius, DWORD& Checksum )
+{
+	guard(RadiusBenchRun);
+	INT Found = 0;
+	Checksum  = 0;
+	for( INT i=0; i<Points.Num(); i++ )
+	{
+		FMemMark Mark(GMem);
+		FRadiusActorQuery Query( GMem, Level, AActor::StaticClass, Points(i), Radius, bAddCollisionRadius );
+		for( AActor* Actor=Query.Next(); Actor; Actor=Query.Next() )
+		{
+			Checksum = Checksum*31 + Actor->GetIndex();
+			Found++;
+		}
+		Mark.Pop();
+	}
+	return Found;
+	unguard;
+}
+
+//
+// Time RadiusActors and VisibleActors style queries among a crowd of actors,
+// with the actor location grid and by scanning the actor list, and make sure
+// both find the same actors in the same order.  The visibility traces are
+// left out, since they cost the same either way.
+//
+static void RadiusBench( ULevel* Level, UClass* Class, INT Count, INT Queries, FLOAT Radius, FLOAT Spread, FOutputDevice* Out )
+{
+	guard(RadiusBench);
+	FVector Center = Level->GetLevelInfo()->Location;
+
+	// Spawn the crowd.
+	TArray<AActor*> Spawned;
+	for( INT i=0; i<Count; i++ )
+	{
+		AActor* Actor = Level->SpawnActor( Class, NAME_None, NULL, NULL, BenchPoint(Center,Spread), FRotator(0,0,0), NULL, 0, 1 );
+		if( Actor )
+			Spawned.AddItem( Actor );
+	}
+	TArray<FVector> Points;
+	for( INT i=0; i<Queries; i++ )
+		Points.AddItem( BenchPoint(Center,Spread) );
+
+	// Query with the grid, then without.
+	UBOOL  OldNoGrid = Level->bNoActorGrid;
+	DOUBLE Seconds[2][2];
+	INT    Found[2][2];
+	DWORD  Checksum[2][2];
+	for( INT Pass=0; Pass<2; Pass++ )
+	{
+		Level->bNoActorGrid = (Pass==1);
+		for( INT Mode=0; Mode<2; Mode++ )
+		{
+			DOUBLE StartTime      = appSeconds();
+			Found   [Pass][Mode] = RadiusBenchRun( Level, Points, Radius, Mode==0, Checksum[Pass][Mode] );
+			Seconds [Pass][Mode] = appSeconds() - StartTime;
+		}
+	}
+	Level->bNoActorGrid = OldNoGrid;
+
+	// Clean up.
+	for( INT i=0; i<Spawned.Num(); i++ )
+		if( !Spawned(i)->bDeleteMe )
+			Level->DestroyActor( Spawned(i) );
+
+	// Report.
+	static const char* ModeNames[2] = {"radius","visible"};
+	Out->Logf( "RADIUSBENCH %s: %i actors in level, %i queries, radius %.0f, spread %.0f", Class->GetName(), Level->Num(), Queries, Radius, Spread );
+	for( INT Mode=0; Mode<2; Mode++ )
+		Out->Logf
+		(
+			"  %-8s grid %8.3f us  scan %8.3f us  (%.2fx)  found %i/%i%s",
+			ModeNames[Mode],
+			1000000.0 * Seconds[0][Mode] / Queries,
+			1000000.0 * Seconds[1][Mode] / Queries,
+			Seconds[0][Mode]>0.0 ? Seconds[1][Mode] / Seconds[0][Mode] : 0.0,
+			Found[0][Mode],
+			Found[1][Mode],
+			Found[0][Mode]!=Found[1][Mode] || Checksum[0][Mode]!=Checksum[1][Mode] ? "  MISMATCH" : ""
+		);
+	unguard;
+}
+
+//
+// Repeatable random numbers for TRACEBENCH, so that a mismatching trace
+// can be found again with the same SEED.
+//
+static FLOAT TraceBenchRand( DWORD& Seed )
+{
+	Seed = Seed * 196314165 + 907633515;
+	return (Seed >> 8) * (1.f / 16777216.f);
+}
+
+//
+// One trace made by TRACEBENCH, and its result from each traversal.
+//
+struct FTraceBenchCase
+{
+	UModel*			Model;
+	AActor*			Owner;
+	FVector			Start, End, Extent;
+	UBOOL			Clear[2];
+	FCheckResult	Hit[2];
+};
+
+//
+// Run the traces of one kind with the recursive (Pass 0) or stackless
+// (Pass 1) Bsp traversal and return the time taken.
+//
+static DOUBLE TraceBenchRun( TArray<FTraceBenchCase>& Cases, UBOOL bBox, INT Pass )
+{
+	guard(TraceBenchRun);
+	UBOOL SavedRecursive = GRecursiveTrace;
+	GRecursiveTrace = Pass==0;
+	DOUBLE StartTime = appSeconds();
+	for( INT i=0; i<Cases.Num(); i++ )
+	{
+		FTraceBenchCase& Case = Cases(i);
+		if( (Case.Extent!=FVector(0,0,0))==bBox )
+		{
+			Case.Hit  [Pass] = FCheckResult(1.0);
+			Case.Clear[Pass] = Case.Model->LineCheck( Case.Hit[Pass], Case.Owner, Case.End, Case.Start, Case.Extent, 0 );
+		}
+	}
+	DOUBLE Seconds = appSeconds() - StartTime;
+	GRecursiveTrace = SavedRecursive;
+	return Seconds;
+	unguard;
+}
+
+//
+// Trace random lines and boxes through the level and its movers with both
+// the original recursive Bsp traversal and the stackless one, time them,
+// and check that every result is the same.
+//
+static void TraceBench( ULevel* Level, INT Count, FLOAT Length, DWORD InSeed, FOutputDevice* Out )
+{
+	guard(TraceBench);
+	DWORD Seed = InSeed;
+
+	// Traces start where actors were placed, which is known to be open space.
+	TArray<AActor*> Spots, Movers;
+	for( INT i=0; i<Level->Num(); i++ )
+	{
+		AActor* Actor = Level->Actors(i);
+		if( Actor && Actor->IsA(AMover::StaticClass) && Actor->Brush )
+			Movers.AddItem( Actor );
+		else if( Actor && !Actor->Brush && Actor!=Level->GetLevelInfo() )
+			Spots.AddItem( Actor );
+	}
+	if( !Spots.Num() )
+	{
+		Out->Log( "TRACEBENCH: no actors to trace from" );
+		return;
+	}
+
+	// Make the traces: half lines and half boxes, one in eight near a mover.
+	TArray<FTraceBenchCase> Cases;
+	FVector PawnExtent(17,17,39);
+	for( INT i=0; i<Count; i++ )
+	{
+		FTraceBenchCase Case;
+		FVector Dir = FVector( TraceBenchRand(Seed)*2.f-1.f, TraceBenchRand(Seed)*2.f-1.f, TraceBenchRand(Seed)*2.f-1.f ).SafeNormal();
+		if( Movers.Num() && (i&7)==7 )
+		{
+			Case.Owner  = Movers( (INT)(TraceBenchRand(Seed)*Movers.Num()) % Movers.Num() );
+			Case.Model  = Case.Owner->Brush;
+			Case.Start  = Case.Owner->Location + Dir * 256.f;
+			Case.End    = Case.Owner->Location - Dir * 256.f;
+			Case.Extent = (i&1) ? PawnExtent : FVector(0,0,0);
+		}
+		else
+		{
+			FCheckResult Hit(1.0);
+			Case.Owner  = NULL;
+			Case.Model  = Level->Model;
+			Case.Start  = Spots( (INT)(TraceBenchRand(Seed)*Spots.Num()) % Spots.Num() )->Location;
+			Case.End    = Case.Start + Dir * Length * TraceBenchRand(Seed);
+			Case.Extent = (i&1) && Level->Model->PointCheck(Hit,NULL,Case.Start,PawnExtent,0) ? PawnExtent : FVector(0,0,0);
+		}
+		Cases.AddItem( Case );
+	}
+
+	// Time each kind of trace with each traversal.
+	DOUBLE Seconds[2][2];
+	INT    Num[2]={0,0};
+	for( INT i=0; i<Cases.Num(); i++ )
+		Num[Cases(i).Extent!=FVector(0,0,0)]++;
+	for( INT bBox=0; bBox<2; bBox++ )
+		for( INT Pass=0; Pass<2; Pass++ )
+			Seconds[bBox][Pass] = TraceBenchRun( Cases, bBox, Pass );
+
+	// Compare the results.
+	INT Mismatches[2]={0,0};
+	for( INT i=0; i<Cases.Num(); i++ )
+	{
+		FTraceBenchCase& Case = Cases(i);
+		FCheckResult*    Hit  = Case.Hit;
+		UBOOL            bBox = Case.Extent!=FVector(0,0,0);
+		if
+		(	Case.Clear[0]!=Case.Clear[1]
+		||	(!Case.Clear[0]
+		&&	(	Abs(Hit[0].Time-Hit[1].Time)>0.0001
+			||	(Hit[0].Location-Hit[1].Location).SizeSquared()>0.0001
+			||	(Hit[0].Normal-Hit[1].Normal).SizeSquared()>0.0001
+			||	(!bBox && Hit[0].Item!=Hit[1].Item) ) ) )
+		{
+			if( Mismatches[0]+Mismatches[1] < 8 )
+				Out->Logf
+				(
+					"TRACEBENCH mismatch: %s %s (%.2f,%.2f,%.2f)-(%.2f,%.2f,%.2f): clear %i/%i time %f/%f item %i/%i",
+					bBox ? "box" : "line",
+					Case.Owner ? Case.Owner->GetName() : "level",
+					Case.Start.X, Case.Start.Y, Case.Start.Z,
+					Case.End.X, Case.End.Y, Case.End.Z,
+					Case.Clear[0], Case.Clear[1],
+					Hit[0].Time, Hit[1].Time,
+					Hit[0].Item, Hit[1].Item
+				);
+			Mismatches[bBox]++;
+		}
+	}
+
+	// Report.
+	Out->Logf( "TRACEBENCH: %i traces, length %.0f, %i movers, seed %u", Cases.Num(), Length, Movers.Num(), InSeed );
+	for( INT bBox=0; bBox<2; bBox++ )
+		Out->Logf
+		(
+			"  %-4s %6i  recursive %7.3f us  stackless %7.3f us  (%.2fx)  mismatches %i",
+			bBox ? "box" : "line",
+			Num[bBox],
+			Num[bBox] ? 1000000.0 * Seconds[bBox][0] / Num[bBox] : 0.0,
+			Num[bBox] ? 1000000.0 * Seconds[bBox][1] / Num[bBox] : 0.0,
+			Seconds[bBox][1]>0.0 ? Seconds[bBox][0] / Seconds[bBox][1] : 0.0,
+			Mismatches[bBox]
+		);
+	unguard;
+}
+
+//
+// Level collision queries timed by CHECKBENCH.
+//
+enum ECheckBenchQuery {CBQ_SingleLine, CBQ_MultiLine, CBQ_SinglePoint, CBQ_MultiPoint, CBQ_MAX};
+static const char* CheckBenchNames[CBQ_MAX] = {"SingleLine","MultiLine","SinglePoint","MultiPoint"};
+
+//
+// Results of one CHECKBENCH case, with latencies in microseconds.
+//
+struct FCheckBenchResult
+{
+	INT		Query;
+	UBOOL	bBox, bActors;
+	DOUBLE	QueriesPerSecond;
+	FLOAT	Avg, Min, P50, P90, P99, Max;
+	INT		Hits;
+};
+
+static int CDECL CompareCheckBenchCycles( const void* A, const void* B )
+{
+	return *(DWORD*)A<*(DWORD*)B ? -1 : *(DWORD*)A>*(DWORD*)B ? 1 : 0;
+}
+
+//
+// Run one query against the level and return whether it found anything.
+// Without actors, a single line trace goes straight to the level's Bsp,
+// since SingleLineCheck walks actors for any colliding trace flag.
+//
+static UBOOL CheckBenchQuery( ULevel* Level, INT Query, const FVector& Start, const FVector& End, const FVector& Extent, UBOOL bActors )
+{
+	FCheckResult Hit(1.0);
+	FMemMark Mark(GMem);
+	UBOOL Found = 0;
+	switch( Query )
+	{
+		case CBQ_SingleLine:  Found = bActors ? !Level->SingleLineCheck( Hit, NULL, End, Start, TRACE_AllColliding, Extent ) : !Level->Model->LineCheck( Hit, NULL, End, Start, Extent, 0 ); break;
+		case CBQ_MultiLine:   Found = Level->MultiLineCheck( GMem, End, Start, Extent, bActors, Level->GetLevelInfo(), 0 )!=NULL; break;
+		case CBQ_SinglePoint: Found = !Level->SinglePointCheck( Hit, Start, Extent, 0, Level->GetLevelInfo(), bActors ); break;
+		case CBQ_MultiPoint:  Found = Level->MultiPointCheck( GMem, Start, Extent, 0, Level->GetLevelInfo(), bActors )!=NULL; break;
+	}
+	Mark.Pop();
+	return Found;
+}
+
+//
+// Time every kind of level collision query, with zero and pawn-sized
+// extents and with actor checks off and on, against the same random points
+// and lines near where actors were placed in the level.  Reports queries
+// per second and the latency distribution of each, and writes them to File
+// as JSON if given.
+//
+static void CheckBench( ULevel* Level, INT Count, FLOAT Length, DWORD InSeed, const char* File, FOutputDevice* Out )
+{
+	guard(CheckBench);
+	DWORD Seed = InSeed;
+
+	// Queries are made around the places actors were put.
+	TArray<FVector> Spots;
+	for( INT i=0; i<Level->Num(); i++ )
+		if( Level->Actors(i) && !Level->Actors(i)->Brush && Level->Actors(i)!=Level->GetLevelInfo() )
+			Spots.AddItem( Level->Actors(i)->Location );
+	if( !Spots.Num() )
+	{
+		Out->Log( "CHECKBENCH: no actors to query around" );
+		return;
+	}
+	TArray<FVector> Starts, Ends;
+	for( INT i=0; i<Count; i++ )
+	{
+		FVector Offset = FVector( TraceBenchRand(Seed)*2.f-1.f, TraceBenchRand(Seed)*2.f-1.f, TraceBenchRand(Seed)*2.f-1.f );
+		FVector Dir    = FVector( TraceBenchRand(Seed)*2.f-1.f, TraceBenchRand(Seed)*2.f-1.f, TraceBenchRand(Seed)*2.f-1.f ).SafeNormal();
+		FVector Start  = Spots( (INT)(TraceBenchRand(Seed)*Spots.Num()) % Spots.Num() ) + Offset * 64.f;
+		Starts.AddItem( Start );
+		Ends.AddItem( Start + Dir * Length * TraceBenchRand(Seed) );
+	}
+
+	// Run each case, after a short warmup.
+	TArray<FCheckBenchResult> Results;
+	TArray<DWORD> Cycles( Count );
+	for( INT Query=0; Query<CBQ_MAX; Query++ )
+	{
+		for( INT bBox=0; bBox<2; bBox++ )
+		{
+			for( INT bActors=0; bActors<2; bActors++ )
+			{
+				FVector Extent = bBox ? FVector(17,17,39) : FVector(0,0,0);
+				for( INT i=0; i<Min(Count,1000); i++ )
+					CheckBenchQuery( Level, Query, Starts(i), Ends(i), Extent, bActors );
+
+				FCheckBenchResult& Result = Results( Results.Add() );
+				Result.Query   = Query;
+				Result.bBox    = bBox;
+				Result.bActors = bActors;
+				Result.Hits    = 0;
+				DOUBLE StartTime = appSeconds();
+				for( INT i=0; i<Count; i++ )
+				{
+					DWORD StartCycles = appCycles();
+					Result.Hits      += CheckBenchQuery( Level, Query, Starts(i), Ends(i), Extent, bActors );
+					Cycles(i)         = appCycles() - StartCycles;
+				}
+				DOUBLE Seconds = appSeconds() - StartTime;
+
+				DOUBLE Sum = 0.0;
+				for( INT i=0; i<Count; i++ )
+					Sum += Cycles(i);
+				appQsort( &Cycles(0), Count, sizeof(DWORD), CompareCheckBenchCycles );
+				FLOAT Scale = GSecondsPerCycle * 1000000.0;
+				Result.QueriesPerSecond = Seconds>0.0 ? Count / Seconds : 0.0;
+				Result.Avg = Scale * Sum / Count;
+				Result.Min = Scale * Cycles(0);
+				Result.P50 = Scale * Cycles( Count/2 );
+				Result.P90 = Scale * Cycles( Min(Count-1, (INT)(Count*0.90f)) );
+				Result.P99 = Scale * Cycles( Min(Count-1, (INT)(Count*0.99f)) );
+				Result.Max = Scale * Cycles( Count-1 );
+			}
+		}
+	}
+
+	// Report.
+	Out->Logf( "CHECKBENCH %s: %i queries per case, length %.0f, seed %u, latencies in us", *Level->URL.Map, Count, Length, InSeed );
+	for( INT i=0; i<Results.Num(); i++ )
+	{
+		FCheckBenchResult& Result = Results(i);
+		Out->Logf
+		(
+			"  %-11s %-4s %-8s %10.0f q/s  avg %7.2f  min %7.2f  p50 %7.2f  p90 %7.2f  p99 %7.2f  max %8.2f  hits %i",
+			CheckBenchNames[Result.Query],
+			Result.bBox ? "box" : "zero",
+			Result.bActors ? "actors" : "level",
+			Result.QueriesPerSecond,
+			Result.Avg, Result.Min, Result.P50, Result.P90, Result.P99, Result.Max,
+			Result.Hits
+		);
+	}
+	if( File && *File )
+	{
+		FILE* F = appFopen( File, "w" );
+		if( F )
+		{
+			appFprintf( F, "{\n\t\"map\": \"%s\",\n\t\"count\": %i,\n\t\"length\": %f,\n\t\"seed\": %u,\n\t\"cases\": [", *Level->URL.Map, Count, Length, InSeed );
+			for( INT i=0; i<Results.Num(); i++ )
+			{
+				FCheckBenchResult& Result = Results(i);
+				appFprintf
+				(
+					F,
+					"%s\n\t\t{\"query\": \"%s\", \"extent\": \"%s\", \"actors\": %i, \"qps\": %.0f, \"avg\": %.4f, \"min\": %.4f, \"p50\": %.4f, \"p90\": %.4f, \"p99\": %.4f, \"max\": %.4f, \"hits\": %i}",
+					i ? "," : "",
+					CheckBenchNames[Result.Query],
+					Result.bBox ? "box" : "zero",
+					Result.bActors,
+					Result.QueriesPerSecond,
+					Result.Avg, Result.Min, Result.P50, Result.P90, Result.P99, Result.Max,
+					Result.Hits
+				);
+			}
+			appFprintf( F, "\n\t]\n}\n" );
+			appFclose( F );
+			Out->Logf( "CHECKBENCH results written to %s", File );
+		}
+		else Out->Logf( "CHECKBENCH: couldn't write %s", File );
+	}
+	unguard;
+}
+
+//
+// Time ticking the level with a swarm of projectiles, first with their
+// world sweeps batched and then with each tracing for itself.  Both passes
+// fire the same projectiles from the same spots.
+//
+static void ProjectileBench( ULevel* Level, UClass* Class, INT Count, INT Frames, FLOAT Speed, DWORD InSeed, FOutputDevice* Out )
+{
+	guard(ProjectileBench);
+	FLOAT DeltaSeconds = 0.02f / Level->GetLevelInfo()->TimeDilation;
+
+	// Projectiles are fired from where actors were placed, which is known to be open space.
+	TArray<AActor*> Spots;
+	for( INT i=0; i<Level->Num(); i++ )
+	{
+		AActor* Actor = Level->Actors(i);
+		if( Actor && Actor->IsA(ANavigationPoint::StaticClass) )
+			Spots.AddItem( Actor );
+	}
+	if( !Spots.Num() )
+	{
+		Out->Log( "PROJECTILEBENCH: no navigation points to fire from" );
+		return;
+	}
+
+	UBOOL  OldNoBatch = Level->bNoProjectileBatch;
+	DOUBLE Seconds[2];
+	INT    Fired[2], Alive[2], Batched[2], Used[2];
+	for( INT Pass=0; Pass<2; Pass++ )
+	{
+		// Fire the swarm.
+		DWORD Seed = InSeed;
+		TArray<AActor*> Spawned;
+		for( INT i=0; i<Count; i++ )
+		{
+			AActor* Spot = Spots( (INT)(TraceBenchRand(Seed)*Spots.Num()) % Spots.Num() );
+			FVector Dir  = FVector( TraceBenchRand(Seed)*2.f-1.f, TraceBenchRand(Seed)*2.f-1.f, TraceBenchRand(Seed)*2.f-1.f ).SafeNormal();
+			AActor* Actor = Level->SpawnActor( Class, NAME_None, NULL, NULL, Spot->Location, Dir.Rotation(), NULL, 0, 1 );
+			if( Actor )
+			{
+				Actor->Physics      = PHYS_Projectile;
+				Actor->Velocity     = Dir * Speed;
+				Actor->Acceleration = FVector(0,0,0);
+				Actor->LifeSpan     = 0.0;
+				Spawned.AddItem( Actor );
+			}
+		}
+
+		// Tick.
+		Level->bNoProjectileBatch = (Pass==1);
+		Batched[Pass] = Used[Pass] = 0;
+		DOUBLE StartTime = appSeconds();
+		for( INT i=0; i<Frames; i++ )
+		{
+			Level->Tick( LEVELTICK_All, DeltaSeconds );
+			Batched[Pass] += Level->NumSweepsBatched;
+			Used   [Pass] += Level->NumSweepsUsed;
+		}
+		Seconds[Pass] = appSeconds() - StartTime;
+
+		// Clean up.
+		Fired[Pass] = Spawned.Num();
+		Alive[Pass] = 0;
+		for( INT i=0; i<Spawned.Num(); i++ )
+		{
+			if( !Spawned(i)->bDeleteMe )
+			{
+				Alive[Pass]++;
+				Level->DestroyActor( Spawned(i) );
+			}
+		}
+	}
+	Level->bNoProjectileBatch = OldNoBatch;
+
+	Out->Logf
+	(
+		"PROJECTILEBENCH %s: %i projectiles, %i frames: batched %.3f ms/frame (%i of %i sweeps used, %i alive), unbatched %.3f ms/frame (%i alive)",
+		Class->GetName(),
+		Fired[0],
+		Frames,
+		1000.0 * Seconds[0] / Frames,
+		Used[0],
+		Batched[0],
+		Alive[0],
+		1000.0 * Seconds[1] / Frames,
+		Alive[1]
+	);
+	unguard;
+}
+
+//
+// Time AllActors-style queries over the level, returning microseconds
+// per query and the number of actors each found.
+//
+static DOUBLE ActorQueryTime( ULevel* Level, UClass* Class, FName Tag, INT Queries, INT& Found )
+{
+	guard(ActorQueryTime);
+	DOUBLE StartTime = appSeconds();
+	for( INT i=0; i<Queries; i++ )
+	{
+		FActorQuery Query( Level, Class, Tag );
+		for( Found=0; Query.Next(); Found++ );
+	}
+	return 1000000.0 * (appSeconds() - StartTime) / Queries;
+	unguard;
+}
+
+//
+// Time AllActors queries for a rare class and a rare tag as the level is
+// padded out with filler actors, with and without the actor indices.
+//
+static void ActorIndexBench( ULevel* Level, UClass* Class, UClass* QueryClass, INT Count, INT Queries, FOutputDevice* Out )
+{
+	guard(ActorIndexBench);
+	FName   QueryTag = FName( "ActorIndexBench" );
+	UBOOL   OldNoIndex = Level->bNoActorIndex;
+	FVector Location = Level->GetLevelInfo()->Location;
+	TArray<AActor*> Spawned;
+	for( INT Step=0; Step<=4; Step++ )
+	{
+		// Pad the level out to this step's size.  The first few get the tag.
+		INT Target = Count * Step / 4;
+		while( Spawned.Num()<Target )
+		{
+			AActor* Actor = Level->SpawnActor( Class, NAME_None, NULL, NULL, Location, FRotator(0,0,0), NULL, 0, 1 );
+			if( !Actor )
+				break;
+			if( Spawned.Num()<8 )
+			{
+				Actor->Tag = QueryTag;
+				Level->ActorTagChanged( Actor );
+			}
+			Spawned.AddItem( Actor );
+		}
+
+		// Query with the indices, then without.
+		DOUBLE ClassTime[2], TagTime[2];
+		INT    ClassFound, TagFound;
+		for( INT Pass=0; Pass<2; Pass++ )
+		{
+			Level->bNoActorIndex = (Pass==1);
+			ClassTime[Pass] = ActorQueryTime( Level, QueryClass, NAME_None, Queries, ClassFound );
+			TagTime  [Pass] = ActorQueryTime( Level, AActor::StaticClass, QueryTag, Queries, TagFound );
+		}
+		Out->Logf
+		(
+			"ACTORINDEXBENCH %i actors: %s (%i found) indexed %.2f us, scanned %.2f us; tag (%i found) indexed %.2f us, scanned %.2f us",
+			Level->Num(),
+			QueryClass->GetName(),
+			ClassFound,
+			ClassTime[0],
+			ClassTime[1],
+			TagFound,
+			TagTime[0],
+			TagTime[1]
+		);
+	}
+	Level->bNoActorIndex = OldNoIndex;
+
+	// Clean up.
+	for( INT i=0; i<Spawned.Num(); i++ )
+		if( !Spawned(i)->bDeleteMe )
+			Level->DestroyActor( Spawned(i) );
+	unguard;
+}
+
+//
+// Time a crowd of monsters watching a few players, with the line of sight
+// cache and without.  Every few frames each pawn either stands still or
+// heads off in a new direction, the same way in both passes.  Each monster
+// hunts the first player and looks for all of them every frame.
+//
+static void SightBench( ULevel* Level, UClass* Class, INT Count, INT Players, INT Frames, FLOAT Speed, DWORD InSeed, FOutputDevice* Out )
+{
+	guard(SightBench);
+	FLOAT DeltaSeconds = 0.05f;
+
+	// Pawns start where actors were placed, which is known to be open space.
+	TArray<AActor*> Spots;
+	for( INT i=0; i<Level->Num(); i++ )
+	{
+		AActor* Actor = Level->Actors(i);
+		if( Actor && Actor->IsA(ANavigationPoint::StaticClass) )
+			Spots.AddItem( Actor );
+	}
+	if( !Spots.Num() )
+	{
+		Out->Log( "SIGHTBENCH: no navigation points to start from" );
+		return;
+	}
+	DWORD Seed = InSeed;
+	TArray<APawn*> Pawns;
+	TArray<FVector> Starts;
+	for( INT i=0; i<Count; i++ )
+	{
+		FVector Start = Spots( (INT)(TraceBenchRand(Seed)*Spots.Num()) % Spots.Num() )->Location;
+		APawn* Pawn = (APawn*)Level->SpawnActor( Class, NAME_None, NULL, NULL, Start, FRotator(0,0,0), NULL, i<Players, 1 );
+		if( Pawn )
+		{
+			Pawns.AddItem( Pawn );
+			Starts.AddItem( Start );
+		}
+	}
+	Players = ::Min( Players, Pawns.Num() );
+	if( Players<1 || Pawns.Num()<=Players )
+	{
+		Out->Logf( "SIGHTBENCH: couldn't spawn enough %s", Class->GetName() );
+		for( INT i=0; i<Pawns.Num(); i++ )
+			Level->DestroyActor( Pawns(i) );
+		return;
+	}
+
+	UBOOL  OldNoCache = Level->bNoSightCache;
+	FLOAT  OldTime    = Level->TimeSeconds;
+	DOUBLE Seconds[2];
+	INT    Seen[2], Traces[2], Hits[2], Lookups[2];
+	TArray<FVector> Velocity;
+	Velocity.AddZeroed( Pawns.Num() );
+	for( INT Pass=0; Pass<2; Pass++ )
+	{
+		Level->bNoSightCache = (Pass==1);
+		Level->ActorSights.Empty();
+		Seed = InSeed;
+		for( INT i=0; i<Pawns.Num(); i++ )
+		{
+			Level->FarMoveActor( Pawns(i), Starts(i), 0, 1 );
+			Pawns(i)->Enemy = i>=Players ? Pawns(0) : NULL;
+		}
+		INT OldTraces  = Level->TotalSightTraces;
+		INT OldHits    = Level->TotalSightHits;
+		INT OldLookups = Level->TotalSightLookups;
+		Seen[Pass]     = 0;
+		DOUBLE Time    = 0.0;
+		for( INT Frame=0; Frame<Frames; Frame++ )
+		{
+			// Move.
+			Level->TimeSeconds += DeltaSeconds;
+			for( INT i=0; i<Pawns.Num(); i++ )
+			{
+				if( Frame%20==0 )
+				{
+					FVector Dir = FVector( TraceBenchRand(Seed)*2.f-1.f, TraceBenchRand(Seed)*2.f-1.f, 0 ).SafeNormal();
+					Velocity(i) = TraceBenchRand(Seed)<0.5f ? Dir*Speed : FVector(0,0,0);
+				}
+				if( !Velocity(i).IsZero() )
+					Level->FarMoveActor( Pawns(i), Pawns(i)->Location + Velocity(i)*DeltaSeconds, 0, 1 );
+			}
+
+			// Look.
+			DOUBLE StartTime = appSeconds();
+			for( INT i=Players; i<Pawns.Num(); i++ )
+				for( INT j=0; j<Players; j++ )
+					Seen[Pass] += Pawns(i)->LineOfSightTo( Pawns(j) ) != 0;
+			Time += appSeconds() - StartTime;
+		}
+		Seconds[Pass] = Time;
+		Traces [Pass] = Level->TotalSightTraces  - OldTraces;
+		Hits   [Pass] = Level->TotalSightHits    - OldHits;
+		Lookups[Pass] = Level->TotalSightLookups - OldLookups;
+	}
+	Level->bNoSightCache = OldNoCache;
+	Level->TimeSeconds   = OldTime;
+	Level->ActorSights.Empty();
+	for( INT i=0; i<Pawns.Num(); i++ )
+	{
+		Pawns(i)->Enemy = NULL;
+		if( !Pawns(i)->bDeleteMe )
+			Level->DestroyActor( Pawns(i) );
+	}
+
+	// Report.
+	INT    Checks = (Pawns.Num() - Players) * Players * Frames;
+	DOUBLE Game   = Frames * DeltaSeconds;
+	Out->Logf( "SIGHTBENCH %s: %i monsters watching %i players for %i frames, speed %.0f", Class->GetName(), Pawns.Num()-Players, Players, Frames, Speed );
+	for( INT Pass=0; Pass<2; Pass++ )
+		Out->Logf
+		(
+			"  %-8s %8.2f us/check  %8.0f traces/sec  %.2f traces/check  seen %i/%i  cached %i/%i",
+			Pass==0 ? "cache" : "no cache",
+			1000000.0 * Seconds[Pass] / Checks,
+			Traces[Pass] / Game,
+			(FLOAT)Traces[Pass] / Checks,
+			Seen[Pass],
+			Checks,
+			Hits[Pass],
+			Lookups[Pass]
+		);
+	unguard;
+}
+
+//
+// Time ticking the level with a crowd of monsters scattered over the map,
+// first with the AI scheduler and then with every pawn ticked every frame.
+//
+static void AIBench( ULevel* Level, UClass* Class, INT Count, INT Frames, DWORD InSeed, FOutputDevice* Out )
+{
+	guard(AIBench);
+	FLOAT DeltaSeconds = 0.02f / Level->GetLevelInfo()->TimeDilation;
+
+	// Monsters start where actors were placed, which is known to be open space.
+	TArray<AActor*> Spots;
+	for( INT i=0; i<Level->Num(); i++ )
+	{
+		AActor* Actor = Level->Actors(i);
+		if( Actor && Actor->IsA(ANavigationPoint::StaticClass) )
+			Spots.AddItem( Actor );
+	}
+	if( !Spots.Num() )
+	{
+		Out->Log( "AIBENCH: no navigation points to start from" );
+		return;
+	}
+
+	UBOOL  OldNoSchedule = Level->bNoAISchedule;
+	DOUBLE Seconds[2], AISeconds[2];
+	INT    Spawned[2], Skipped[2], Sensed[2];
+	for( INT Pass=0; Pass<2; Pass++ )
+	{
+		// Scatter the crowd.
+		DWORD Seed = InSeed;
+		TArray<AActor*> Pawns;
+		for( INT i=0; i<Count; i++ )
+		{
+			AActor* Spot  = Spots( (INT)(TraceBenchRand(Seed)*Spots.Num()) % Spots.Num() );
+			AActor* Actor = Level->SpawnActor( Class, NAME_None, NULL, NULL, Spot->Location, FRotator(0,0,0), NULL, 0, 1 );
+			if( Actor )
+				Pawns.AddItem( Actor );
+		}
+
+		// Tick.
+		Level->bNoAISchedule = (Pass==1);
+		AISeconds[Pass] = 0.0;
+		Skipped[Pass] = Sensed[Pass] = 0;
+		DOUBLE StartTime = appSeconds();
+		for( INT i=0; i<Frames; i++ )
+		{
+			Level->Tick( LEVELTICK_All, DeltaSeconds );
+			AISeconds[Pass] += GSecondsPerCycle * Level->AITickCycles;
+			Skipped  [Pass] += Level->NumAISkipped;
+			Sensed   [Pass] += Level->NumAISensed;
+		}
+		Seconds[Pass] = appSeconds() - StartTime;
+
+		// Clean up.
+		Spawned[Pass] = Pawns.Num();
+		for( INT i=0; i<Pawns.Num(); i++ )
+			if( !Pawns(i)->bDeleteMe )
+				Level->DestroyActor( Pawns(i) );
+	}
+	Level->bNoAISchedule = OldNoSchedule;
+
+	Out->Logf
+	(
+		"AIBENCH %s: %i pawns, %i viewers, %i frames: scheduled %.3f ms/frame (AI %.3f ms, %.1f skipped, %.1f sensed), unscheduled %.3f ms/frame (AI %.3f ms)",
+		Class->GetName(),
+		Spawned[0],
+		Level->AIViewers.Num(),
+		Frames,
+		1000.0 * Seconds[0] / Frames,
+		1000.0 * AISeconds[0] / Frames,
+		(FLOAT)Skipped[0] / Frames,
+		(FLOAT)Sensed[0] / Frames,
+		1000.0 * Seconds[1] / Frames,
+		1000.0 * AISeconds[1] / Frames
+	);
+	unguard;
+}
+
+//
+// Time spawning and destroying waves of actors, with the class pooled and
+// without.  Each wave is cleaned up before the next, so that the pool is
+// refilled as it would be in play.
+//
+static void PoolBench( ULevel* Level, UClass* Class, INT Count, INT Rounds, FOutputDevice* Out )
+{
+	guard(PoolBench);
+	FVector Location = Level->GetLevelInfo()->Location;
+
+	// Pool the class for the first pass if it isn't already.
+	UBOOL  OldNoPool = Level->bNoActorPool;
+	FActorPool* Pool = Level->FindActorPool( Class );
+	INT    OldMax    = Pool ? Pool->Max : 0;
+	Level->SetActorPool( Class, ::Max( OldMax, Count ) );
+
+	DOUBLE SpawnSeconds[2], DestroySeconds[2];
+	INT    Spawned[2], Hits[2];
+	for( INT Pass=0; Pass<2; Pass++ )
+	{
+		Level->bNoActorPool = (Pass==1);
+		SpawnSeconds[Pass] = DestroySeconds[Pass] = 0.0;
+		Spawned[Pass] = Hits[Pass] = 0;
+		for( INT Round=0; Round<Rounds; Round++ )
+		{
+			// Spawn a wave.
+			TArray<AActor*> Wave;
+			Level->InitStats();
+			DOUBLE StartTime = appSeconds();
+			for( INT i=0; i<Count; i++ )
+			{
+				AActor* Actor = Level->SpawnActor( Class, NAME_None, NULL, NULL, Location, FRotator(0,0,0), NULL, 0, 1 );
+				if( Actor )
+					Wave.AddItem( Actor );
+			}
+			SpawnSeconds[Pass] += appSeconds() - StartTime;
+			Spawned[Pass] += Wave.Num();
+			Hits[Pass] += Level->NumPoolHits;
+
+			// Destroy it, and clean up after it the way the end of a tick does.
+			StartTime = appSeconds();
+			for( INT i=0; i<Wave.Num(); i++ )
+				if( !Wave(i)->bDeleteMe )
+					Level->DestroyActor( Wave(i) );
+			Level->CleanupDestroyed( 0 );
+			DestroySeconds[Pass] += appSeconds() - StartTime;
+		}
+	}
+	Level->bNoActorPool = OldNoPool;
+	Level->SetActorPool( Class, OldMax );
+
+	Out->Logf
+	(
+		"POOLBENCH %s: %i rounds of %i: pooled %.2f us/spawn %.2f us/destroy (%i of %i reused), unpooled %.2f us/spawn %.2f us/destroy",
+		Class->GetName(),
+		Rounds,
+		Count,
+		Spawned[0] ? 1000000.0 * SpawnSeconds[0] / Spawned[0] : 0.0,
+		Spawned[0] ? 1000000.0 * DestroySeconds[0] / Spawned[0] : 0.0,
+		Hits[0],
+		Spawned[0],
+		Spawned[1] ? 1000000.0 * SpawnSeconds[1] / Spawned[1] : 0.0,
+		Spawned[1] ? 1000000.0 * DestroySeconds[1] / Spawned[1] : 0.0
+	);
+	unguard;
+}
+
+//
+// Time churning a crowd of actors, destroying a random handful and spawning
+// as many again each round, with the actor list bookkeeping and without.
+// Every eighth actor is owned by the one spawned before it.  After each
+// round, the dynamic actors are scanned once, from the live actor list
+// with the bookkeeping and from the actor list without it.
+//
+static void ChurnBench( ULevel* Level, UClass* Class, INT Count, INT Churn, INT Rounds, DWORD InSeed, FOutputDevice* Out )
+{
+	guard(ChurnBench);
+	FVector Location = Level->GetLevelInfo()->Location;
+	UBOOL   OldNoSlots = Level->bNoActorSlots;
+	DOUBLE  SpawnSeconds[2], DestroySeconds[2], CleanupSeconds[2], ScanSeconds[2];
+	INT     Spawned[2], Destroyed[2], Listed[2], Scanned[2];
+	for( INT Pass=0; Pass<2; Pass++ )
+	{
+		// Spawn the crowd.
+		Level->FlushLiveActors();
+		Level->bNoActorSlots = (Pass==1);
+		DWORD Seed = InSeed;
+		TArray<AActor*> Crowd;
+		for( INT i=0; i<Count; i++ )
+		{
+			AActor* Owner = (i%8==7 && Crowd.Num()) ? Crowd(Crowd.Num()-1) : NULL;
+			AActor* Actor = Level->SpawnActor( Class, NAME_None, Owner, NULL, Location, FRotator(0,0,0), NULL, 0, 1 );
+			if( Actor )
+				Crowd.AddItem( Actor );
+		}
+		Level->CleanupDestroyed( 0 );
+
+		// Churn it.
+		SpawnSeconds[Pass] = DestroySeconds[Pass] = CleanupSeconds[Pass] = ScanSeconds[Pass] = 0.0;
+		Spawned[Pass] = Destroyed[Pass] = Scanned[Pass] = 0;
+		for( INT Round=0; Round<Rounds && Crowd.Num(); Round++ )
+		{
+			DOUBLE StartTime = appSeconds();
+			for( INT i=0; i<Churn; i++ )
+			{
+				AActor* Actor = Crowd( (INT)(TraceBenchRand(Seed)*Crowd.Num()) % Crowd.Num() );
+				if( !Actor->bDeleteMe && Level->DestroyActor( Actor ) )
+					Destroyed[Pass]++;
+			}
+			DestroySeconds[Pass] += appSeconds() - StartTime;
+
+			StartTime = appSeconds();
+			for( INT i=0; i<Crowd.Num(); i++ )
+			{
+				if( Crowd(i)->bDeleteMe )
+				{
+					AActor* Actor = Level->SpawnActor( Class, NAME_None, NULL, NULL, Location, FRotator(0,0,0), NULL, 0, 1 );
+					if( !Actor )
+						break;
+					Crowd(i) = Actor;
+					Spawned[Pass]++;
+				}
+			}
+			SpawnSeconds[Pass] += appSeconds() - StartTime;
+
+			StartTime = appSeconds();
+			Level->CleanupDestroyed( 0 );
+			CleanupSeconds[Pass] += appSeconds() - StartTime;
+
+			StartTime = appSeconds();
+			TArray<AActor*>* Live = Level->GetLiveActors();
+			if( Live )
+			{
+				for( INT i=0; i<Live->Num(); i++ )
+					Scanned[Pass] += ((*Live)(i)->Owner!=NULL);
+			}
+			else
+			{
+				for( INT i=Level->iFirstDynamicActor; i<Level->Num(); i++ )
+					if( Level->Actors(i) )
+						Scanned[Pass] += (Level->Actors(i)->Owner!=NULL);
+			}
+			ScanSeconds[Pass] += appSeconds() - StartTime;
+		}
+		Listed[Pass] = Level->Num();
+
+		// Clean up.
+		for( INT i=0; i<Crowd.Num(); i++ )
+			if( !Crowd(i)->bDeleteMe )
+				Level->DestroyActor( Crowd(i) );
+		Level->CleanupDestroyed( 0 );
+	}
+	Level->FlushLiveActors();
+	Level->bNoActorSlots = OldNoSlots;
+
+	Out->Logf( "CHURNBENCH %s: %i actors, %i rounds of %i", Class->GetName(), Count, Rounds, Churn );
+	for( INT Pass=0; Pass<2; Pass++ )
+		Out->Logf
+		(
+			"   %-12s %8.2f us/destroy  %8.2f us/spawn  %8.3f ms/cleanup  %8.3f ms/scan  %i listed%s",
+			Pass==0 ? "bookkeeping" : "searching",
+			Destroyed[Pass] ? 1000000.0 * DestroySeconds[Pass] / Destroyed[Pass] : 0.0,
+			Spawned[Pass] ? 1000000.0 * SpawnSeconds[Pass] / Spawned[Pass] : 0.0,
+			1000.0 * CleanupSeconds[Pass] / Rounds,
+			1000.0 * ScanSeconds[Pass] / Rounds,
+			Listed[Pass],
+			Scanned[Pass]!=Scanned[0] ? "  MISMATCH" : ""
+		);
+	unguard;
+}
+
+//
+// Time finding the actors relevant to a crowd of network viewers among
+// a crowd of pawns, with the relevancy cache and culling as they are set,
+// and with neither.  Every few frames
+// each viewer and a quarter of the pawns either stand still or head off in
+// a new direction, the same way in both passes.
+//
+static void RelevancyBench( ULevel* Level, UClass* ViewerClass, UClass* Class, INT Viewers, INT Count, INT Frames, FLOAT Speed, DWORD InSeed, FOutputDevice* Out )
+{
+	guard(RelevancyBench);
+	FLOAT DeltaSeconds = 0.05f;
+
+	// Everyone starts where actors were placed, which is known to be open space.
+	TArray<AActor*> Spots;
+	for( INT i=0; i<Level->Num(); i++ )
+	{
+		AActor* Actor = Level->Actors(i);
+		if( Actor && Actor->IsA(ANavigationPoint::StaticClass) )
+			Spots.AddItem( Actor );
+	}
+	if( !Spots.Num() )
+	{
+		Out->Log( "RELEVANCYBENCH: no navigation points to start from" );
+		return;
+	}
+	DWORD Seed = InSeed;
+	TArray<AActor*> Actors;
+	TArray<FVector> Starts;
+	INT NumViewers = 0;
+	for( INT i=0; i<Viewers+Count; i++ )
+	{
+		FVector Start = Spots( (INT)(TraceBenchRand(Seed)*Spots.Num()) % Spots.Num() )->Location;
+		AActor* Actor = Level->SpawnActor( i<Viewers ? ViewerClass : Class, NAME_None, NULL, NULL, Start, FRotator(0,0,0), NULL, i<Viewers, 1 );
+		if( Actor )
+		{
+			// Keep the viewers at the front.
+			Actors.AddItem( Actor );
+			Starts.AddItem( Start );
+			if( i<Viewers )
+				NumViewers++;
+		}
+	}
+	if( NumViewers<1 || Actors.Num()<=NumViewers )
+	{
+		Out->Logf( "RELEVANCYBENCH: couldn't spawn enough %s and %s", ViewerClass->GetName(), Class->GetName() );
+		for( INT i=0; i<Actors.Num(); i++ )
+			Level->DestroyActor( Actors(i) );
+		return;
+	}
+
+	UBOOL   OldNoCache = Level->bNoRelevancyCache;
+	UBOOL   OldCull    = Level->bRelevancyCull;
+	FLOAT   OldTime    = Level->TimeSeconds;
+	DOUBLE  Seconds[2];
+	INT     Relevant[2], Traces[2], Hits[2], Culled[2];
+	AActor* List[256];
+	TArray<FVector> Velocity;
+	Velocity.AddZeroed( Actors.Num() );
+	for( INT Pass=0; Pass<2; Pass++ )
+	{
+		Level->bNoRelevancyCache = Pass==1 ? 1 : OldNoCache;
+		Level->bRelevancyCull    = Pass==1 ? 0 : OldCull;
+		Level->ActorRelevancy.Empty();
+		appMemset( Level->RelevancyViewers, 0, sizeof(Level->RelevancyViewers) );
+		Seed = InSeed;
+		for( INT i=0; i<Actors.Num(); i++ )
+			Level->FarMoveActor( Actors(i), Starts(i), 0, 1 );
+		INT OldTraces = Level->TotalRelevancyTraces;
+		INT OldHits   = Level->TotalRelevancyHits;
+		INT OldCulled = Level->TotalRelevancyCulled;
+		Relevant[Pass] = 0;
+		DOUBLE Time    = 0.0;
+		for( INT Frame=0; Frame<Frames; Frame++ )
+		{
+			// Move.
+			Level->TimeSeconds += DeltaSeconds;
+			for( INT i=0; i<Actors.Num(); i++ )
+			{
+				if( i>=NumViewers && i%4!=0 )
+					continue;
+				if( Frame%20==0 )
+				{
+					FVector Dir = FVector( TraceBenchRand(Seed)*2.f-1.f, TraceBenchRand(Seed)*2.f-1.f, 0 ).SafeNormal();
+					Velocity(i) = TraceBenchRand(Seed)<0.5f ? Dir*Speed : FVector(0,0,0);
+				}
+				if( !Velocity(i).IsZero() )
+					Level->FarMoveActor( Actors(i), Actors(i)->Location + Velocity(i)*DeltaSeconds, 0, 1 );
+			}
+
+			// Find what's relevant to each viewer.
+			DOUBLE StartTime = appSeconds();
+			for( INT i=0; i<NumViewers; i++ )
+				Relevant[Pass] += Level->GetRelevantActors( (APlayerPawn*)Actors(i), List, ARRAY_COUNT(List) );
+			Time += appSeconds() - StartTime;
+		}
+		Seconds[Pass] = Time;
+		Traces [Pass] = Level->TotalRelevancyTraces - OldTraces;
+		Hits   [Pass] = Level->TotalRelevancyHits   - OldHits;
+		Culled [Pass] = Level->TotalRelevancyCulled - OldCulled;
+	}
+	Level->bNoRelevancyCache = OldNoCache;
+	Level->bRelevancyCull    = OldCull;
+	Level->TimeSeconds       = OldTime;
+	Level->ActorRelevancy.Empty();
+	appMemset( Level->RelevancyViewers, 0, sizeof(Level->RelevancyViewers) );
+	for( INT i=0; i<Actors.Num(); i++ )
+		if( !Actors(i)->bDeleteMe )
+			Level->DestroyActor( Actors(i) );
+
+	// Report.
+	INT Calls = NumViewers * Frames;
+	Out->Logf( "RELEVANCYBENCH %s: %i viewers among %i %s for %i frames, speed %.0f", ViewerClass->GetName(), NumViewers, Actors.Num()-NumViewers, Class->GetName(), Frames, Speed );
+	for( INT Pass=0; Pass<2; Pass++ )
+		Out->Logf
+		(
+			"  %-8s %8.3f ms/frame  %8.2f us/viewer  %.1f traces/viewer  %.1f relevant/viewer  cached %i  culled %i",
+			Pass==0 ? "cache" : "baseline",
+			1000.0 * Seconds[Pass] / Frames,
+			1000000.0 * Seconds[Pass] / Calls,
+			(FLOAT)Traces[Pass] / Calls,
+			(FLOAT)Relevant[Pass] / Calls,
+			Hits[Pass],
+			Culled[Pass]
+		);
+	unguard;
+}
+
+UBOOL ULevel::Exec( const char* Cmd, FOutputDevice* Out )
+{
+	guard(ULevel::Exec);
+	const char* Str = Cmd;
+	if( NetDriver && NetDriver->Exec( Cmd, Out ) ) return 1;
+	else if( BrushTracker && BrushTracker->Exec( Cmd, Out ) ) return 1;
+	else if( ParseCommand(&Str,"PARKING") )
+	{
+		if( ParseCommand(&Str,"ON") )
+			bNoParking = 0;
+		else if( ParseCommand(&Str,"OFF") )
+			bNoParking = 1;
+		else
+			bNoParking = !bNoParking;
+		Out->Logf( "Idle actor parking %s (%i parked)", bNoParking ? "disabled" : "enabled", NumParked );
+		return 1;
+	}
+	else if( ParseCommand(&Str,"REGIONCACHE") )
+	{
+		if( ParseCommand(&Str,"ON") )
+			bNoRegionCache = 0;
+		else if( ParseCommand(&Str,"OFF") )
+			bNoRegionCache = 1;
+		else if( !ParseCommand(&Str,"STATS") )
+			bNoRegionCache = !bNoRegionCache;
+		if( bNoRegionCache )
+			ActorRegions.Empty();
+		Out->Logf
+		(
+			"Actor region cache %s: %i of %i lookups hit (%.1f%%)",
+			bNoRegionCache ? "disabled" : "enabled",
+			TotalRegionHits,
+			TotalRegionLookups,
+			TotalRegionLookups ? 100.0 * TotalRegionHits / TotalRegionLookups : 0.0
+		);
+		TotalRegionHits = TotalRegionLookups = 0;
+		return 1;
+	}
+	else if( ParseCommand(&Str,"SIGHTCACHE") )
+	{
+		if( ParseCommand(&Str,"ON") )
+			bNoSightCache = 0;
+		else if( ParseCommand(&Str,"OFF") )
+			bNoSightCache = 1;
+		else if( !ParseCommand(&Str,"STATS") )
+			bNoSightCache = !bNoSightCache;
+		Parse( Str, "TOLERANCE=", SightTolerance );
+		Parse( Str, "LIFETIME=", SightLifetime );
+		if( bNoSightCache )
+			ActorSights.Empty();
+		Out->Logf
+		(
+			"Line of sight cache %s: %i of %i lookups hit (%.1f%%), %i traces",
+			bNoSightCache ? "disabled" : "enabled",
+			TotalSightHits,
+			TotalSightLookups,
+			TotalSightLookups ? 100.0 * TotalSightHits / TotalSightLookups : 0.0,
+			TotalSightTraces
+		);
+		TotalSightHits = TotalSightLookups = TotalSightTraces = 0;
+		return 1;
+	}
+	else if( ParseCommand(&Str,"SIGHTBENCH") )
+	{
+		UClass* Class   = NULL;
+		INT     Count   = 32;
+		INT     Players = 4;
+		INT     Frames  = 200;
+		FLOAT   Speed   = 200.f;
+		DWORD   Seed    = 1;
+		if( !ParseObject<UClass>( Str, "CLASS=", Class, ANY_PACKAGE ) )
+		{
+			// Default to the first pawn class which is loaded and can be spawned.
+			for( TObjectIterator<UClass> It; It && !Class; ++It )
+				if( It->IsChildOf(APawn::StaticClass) && !It->IsChildOf(APlayerPawn::StaticClass) && !(It->ClassFlags & CLASS_Abstract) )
+					Class = *It;
+		}
+		Parse( Str, "COUNT=", Count );
+		Parse( Str, "PLAYERS=", Players );
+		Parse( Str, "FRAMES=", Frames );
+		Parse( Str, "SPEED=", Speed );
+		Parse( Str, "SEED=", Seed );
+		if( InTick )
+			Out->Log( "Can't run SIGHTBENCH while the level is ticking" );
+		else if( GIsEditor )
+			Out->Log( "SIGHTBENCH: the line of sight cache isn't used in the editor" );
+		else if( !Class || !Class->IsChildOf(APawn::StaticClass) || (Class->ClassFlags & CLASS_Abstract) )
+			Out->Logf( "SIGHTBENCH: %s is not a spawnable pawn class", Class ? Class->GetName() : "no pawn class loaded, so CLASS=" );
+		else if( Count>1 && Players>0 && Frames>0 )
+			SightBench( this, Class, Count, ::Min(Players,Count), Frames, Speed, Seed, Out );
+		return 1;
+	}
+	else if( ParseCommand(&Str,"AISCHEDULE") )
+	{
+		if( ParseCommand(&Str,"ON") )
+			bNoAISchedule = 0;
+		else if( ParseCommand(&Str,"OFF") )
+			bNoAISchedule = 1;
+		else if( !ParseCommand(&Str,"STATS") )
+			bNoAISchedule = !bNoAISchedule;
+		Parse( Str, "NEAR=", AINearDist );
+		Parse( Str, "FAR=", AIFarDist );
+		Parse( Str, "MIDINTERVAL=", AIMidInterval );
+		Parse( Str, "FARINTERVAL=", AIFarInterval );
+		Parse( Str, "BUDGET=", AISenseBudget );
+
+		// Count the pawns which were throttled as of the last frame.
+		INT Pawns=0, Throttled=0;
+		FLOAT Rate=0.0;
+		for( APawn* Pawn=GetLevelInfo()->PawnList; Pawn; Pawn=Pawn->nextPawn, Pawns++ )
+		{
+			INT Index = Pawn->GetIndex();
+			if( Index<ActorSchedule.Num() && ActorSchedule(Index).AIInterval>0.0 )
+			{
+				Throttled++;
+				Rate += 1.0 / ActorSchedule(Index).AIInterval;
+			}
+		}
+		Out->Logf
+		(
+			"AI scheduler %s: %i of %i pawns throttled to %.1f ticks/sec on average, %i sight checks waiting",
+			bNoAISchedule ? "disabled" : "enabled",
+			Throttled,
+			Pawns,
+			Throttled ? Rate / Throttled : 0.0,
+			SenseQueue.Num()
+		);
+		return 1;
+	}
+	else if( ParseCommand(&Str,"AIBENCH") )
+	{
+		UClass* Class  = NULL;
+		INT     Count  = 200;
+		INT     Frames = 100;
+		DWORD   Seed   = 1;
+		if( !ParseObject<UClass>( Str, "CLASS=", Class, ANY_PACKAGE ) )
+		{
+			// Default to the first pawn class which is loaded and can be spawned.
+			for( TObjectIterator<UClass> It; It && !Class; ++It )
+				if( It->IsChildOf(APawn::StaticClass) && !It->IsChildOf(APlayerPawn::StaticClass) && !(It->ClassFlags & CLASS_Abstract) )
+					Class = *It;
+		}
+		Parse( Str, "COUNT=", Count );
+		Parse( Str, "FRAMES=", Frames );
+		Parse( Str, "SEED=", Seed );
+		if( InTick )
+			Out->Log( "Can't run AIBENCH while the level is ticking" );
+		else if( GIsEditor )
+			Out->Log( "AIBENCH: the AI scheduler isn't used in the editor" );
+		else if( !Class || !Class->IsChildOf(APawn::StaticClass) || (Class->ClassFlags & CLASS_Abstract) )
+			Out->Logf( "AIBENCH: %s is not a spawnable pawn class", Class ? Class->GetName() : "no pawn class loaded, so CLASS=" );
+		else if( Count>0 && Frames>0 )
+			AIBench( this, Class, Count, Frames, Seed, Out );
+		return 1;
+	}
+	else if( ParseCommand(&Str,"ACTORPOOL") )
+	{
+		UClass* Class = NULL;
+		INT     Max   = 64;
+		if( ParseCommand(&Str,"ON") )
+			bNoActorPool = 0;
+		else if( ParseCommand(&Str,"OFF") )
+		{
+			bNoActorPool = 1;
+			FlushActorPools();
+		}
+		else if( ParseCommand(&Str,"FLUSH") )
+			FlushActorPools();
+		else if( ParseObject<UClass>( Str, "CLASS=", Class, ANY_PACKAGE ) )
+		{
+			Parse( Str, "MAX=", Max );
+			if( Class->IsChildOf(AActor::StaticClass) )
+				SetActorPool( Class, Max );
+		}
+		ConfigureActorPools();
+		Out->Logf( "Actor pools %s:", bNoActorPool ? "disabled" : "enabled" );
+		for( INT i=0; i<ActorPools.Num(); i++ )
+		{
+			FActorPool& Pool = ActorPools(i);
+			Out->Logf
+			(
+				"   %s: %i/%i pooled, %i of %i spawns reused (%.1f%%), %i recycled, %.2f us/construct reused, %.2f us new",
+				*Pool.ClassName,
+				Pool.Num,
+				Pool.Max,
+				Pool.Hits,
+				Pool.Hits + Pool.Misses,
+				Pool.Hits + Pool.Misses ? 100.0 * Pool.Hits / (Pool.Hits + Pool.Misses) : 0.0,
+				Pool.Recycled,
+				Pool.Hits   ? 1000000.0 * Pool.HitSeconds  / Pool.Hits   : 0.0,
+				Pool.Misses ? 1000000.0 * Pool.MissSeconds / Pool.Misses : 0.0
+			);
+		}
+		return 1;
+	}
+	else if( ParseCommand(&Str,"POOLBENCH") )
+	{
+		UClass* Class  = NULL;
+		INT     Count  = 500;
+		INT     Rounds = 20;
+		if( !ParseObject<UClass>( Str, "CLASS=", Class, ANY_PACKAGE ) )
+		{
+			// Default to the first projectile class which is loaded and can be spawned.
+			for( TObjectIterator<UClass> It; It && !Class; ++It )
+				if( It->IsChildOf(AProjectile::StaticClass) && !(It->ClassFlags & CLASS_Abstract) )
+					Class = *It;
+		}
+		Parse( Str, "COUNT=", Count );
+		Parse( Str, "ROUNDS=", Rounds );
+		if( InTick )
+			Out->Log( "Can't run POOLBENCH while the level is ticking" );
+		else if( GIsEditor )
+			Out->Log( "POOLBENCH: actors aren't pooled in the editor" );
+		else if( !Class || !Class->IsChildOf(AActor::StaticClass) || (Class->ClassFlags & CLASS_Abstract) )
+			Out->Logf( "POOLBENCH: %s is not a spawnable actor class", Class ? Class->GetName() : "no projectile class loaded, so CLASS=" );
+		else if( Count>0 && Rounds>0 )
+			PoolBench( this, Class, Count, Rounds, Out );
+		return 1;
+	}
+	else if( ParseCommand(&Str,"ACTORSLOTS") )
+	{
+		if( ParseCommand(&Str,"ON") )
+			bNoActorSlots = 0;
+		else if( ParseCommand(&Str,"OFF") )
+			bNoActorSlots = 1;
+		else
+			bNoActorSlots = !bNoActorSlots;
+		FlushLiveActors();
+		Out->Logf( "Actor list bookkeeping %s", bNoActorSlots ? "disabled" : "enabled" );
+		return 1;
+	}
+	else if( ParseCommand(&Str,"CHURNBENCH") )
+	{
+		UClass* Class  = ATriggers::StaticClass;
+		INT     Count  = 4000;
+		INT     Churn  = 200;
+		INT     Rounds = 50;
+		DWORD   Seed   = 1;
+		ParseObject<UClass>( Str, "CLASS=", Class, ANY_PACKAGE );
+		Parse( Str, "COUNT=", Count );
+		Parse( Str, "CHURN=", Churn );
+		Parse( Str, "ROUNDS=", Rounds );
+		Parse( Str, "SEED=", Seed );
+		if( InTick )
+			Out->Log( "Can't run CHURNBENCH while the level is ticking" );
+		else if( GIsEditor )
+			Out->Log( "CHURNBENCH: the actor list is managed differently in the editor" );
+		else if( !Class->IsChildOf(AActor::StaticClass) || (Class->ClassFlags & CLASS_Abstract) )
+			Out->Logf( "CHURNBENCH: %s is not a spawnable actor class", Class->GetName() );
+		else if( Count>0 && Churn>0 && Rounds>0 )
+			ChurnBench( this, Class, Count, Churn, Rounds, Seed, Out );
+		return 1;
+	}
+	else if( ParseCommand(&Str,"RELEVANCYCACHE") )
+	{
+		if( ParseCommand(&Str,"ON") )
+			bNoRelevancyCache = 0;
+		else if( ParseCommand(&Str,"OFF") )
+			bNoRelevancyCache = 1;
+		else if( !ParseCommand(&Str,"STATS") )
+			bNoRelevancyCache = !bNoRelevancyCache;
+		Parse( Str, "TOLERANCE=", RelevancyTolerance );
+		Parse( Str, "LIFETIME=", RelevancyLifetime );
+		if( bNoRelevancyCache )
+			ActorRelevancy.Empty();
+		Out->Logf
+		(
+			"Relevancy cache %s: %i of %i lookups hit (%.1f%%), %i culled, %i traces",
+			bNoRelevancyCache ? "disabled" : "enabled",
+			TotalRelevancyHits,
+			TotalRelevancyLookups,
+			TotalRelevancyLookups ? 100.0 * TotalRelevancyHits / TotalRelevancyLookups : 0.0,
+			TotalRelevancyCulled,
+			TotalRelevancyTraces
+		);
+		TotalRelevancyHits = TotalRelevancyLookups = TotalRelevancyCulled = TotalRelevancyTraces = 0;
+		return 1;
+	}
+	else if( ParseCommand(&Str,"RELEVANCYCULL") )
+	{
+		if( ParseCommand(&Str,"ON") )
+			bRelevancyCull = 1;
+		else if( ParseCommand(&Str,"OFF") )
+			bRelevancyCull = 0;
+		else if( !ParseCommand(&Str,"STATS") )
+			bRelevancyCull = !bRelevancyCull;
+		Parse( Str, "DISTANCE=", RelevancyDistance );
+		Out->Logf
+		(
+			"Relevancy culling %s: zone visibility %s, distance %.0f (zero for no limit)",
+			bRelevancyCull ? "enabled" : "disabled",
+			ZoneVisibilityBuilt() ? "built" : "not built",
+			RelevancyDistance
+		);
+		return 1;
+	}
+	else if( ParseCommand(&Str,"REPTRACKING") )
+	{
+		if( ParseCommand(&Str,"ON") )
+			bNoRepTracking = 0;
+		else if( ParseCommand(&Str,"OFF") )
+			bNoRepTracking = 1;
+		else if( !ParseCommand(&Str,"STATS") )
+			bNoRepTracking = !bNoRepTracking;
+		if( bNoRepTracking )
+			FlushRepState( NULL );
+		INT Total = TotalRepSkipped + TotalRepPartial + TotalRepFull;
+		Out->Logf
+		(
+			"Replication change tracking %s: %i of %i actor updates skipped (%.1f%%), %i partial, %i full",
+			bNoRepTracking ? "disabled" : "enabled",
+			TotalRepSkipped,
+			Total,
+			Total ? 100.0 * TotalRepSkipped / Total : 0.0,
+			TotalRepPartial,
+			TotalRepFull
+		);
+		TotalRepSkipped = TotalRepPartial = TotalRepFull = 0;
+		return 1;
+	}
+	else if( ParseCommand(&Str,"RELEVANCYBENCH") )
+	{
+		UClass* ViewerClass = NULL;
+		UClass* Class       = NULL;
+		INT     Viewers     = 16;
+		INT     Count       = 200;
+		INT     Frames      = 100;
+		FLOAT   Speed       = 200.f;
+		DWORD   Seed        = 1;
+		if( !ParseObject<UClass>( Str, "VIEWERCLASS=", ViewerClass, ANY_PACKAGE ) )
+		{
+			// Default to the first player class which is loaded and can be spawned.
+			for( TObjectIterator<UClass> It; It && !ViewerClass; ++It )
+				if( It->IsChildOf(APlayerPawn::StaticClass) && !It->IsChildOf(ACamera::StaticClass) && !(It->ClassFlags & CLASS_Abstract) )
+					ViewerClass = *It;
+		}
+		if( !ParseObject<UClass>( Str, "CLASS=", Class, ANY_PACKAGE ) )
+		{
+			// Default to the first pawn class which is loaded and can be spawned.
+			for( TObjectIterator<UClass> It; It && !Class; ++It )
+				if( It->IsChildOf(APawn::StaticClass) && !It->IsChildOf(APlayerPawn::StaticClass) && !(It->ClassFlags & CLASS_Abstract) )
+					Class = *It;
 		}
+		Parse( Str, "VIEWERS=", Viewers );
+		Parse( Str, "COUNT=", Count );
+		Parse( Str, "FRAMES=", Frames );
+		Parse( Str, "SPEED=", Speed );
+		Parse( Str, "SEED=", Seed );
+		Viewers = ::Min( Viewers, (INT)MAX_RELEVANCY_VIEWERS );
+		if( InTick )
+			Out->Log( "Can't run RELEVANCYBENCH while the level is ticking" );
+		else if( GIsEditor )
+			Out->Log( "RELEVANCYBENCH: the relevancy cache isn't used in the editor" );
+		else if( !ViewerClass || !ViewerClass->IsChildOf(APlayerPawn::StaticClass) || (ViewerClass->ClassFlags & CLASS_Abstract) )
+			Out->Logf( "RELEVANCYBENCH: %s is not a spawnable player class", ViewerClass ? ViewerClass->GetName() : "no player class loaded, so VIEWERCLASS=" );
+		else if( !Class || !Class->IsChildOf(AActor::StaticClass) || (Class->ClassFlags & CLASS_Abstract) )
+			Out->Logf( "RELEVANCYBENCH: %s is not a spawnable actor class", Class ? Class->GetName() : "no pawn class loaded, so CLASS=" );
+		else if( Viewers>0 && Count>0 && Frames>0 )
+			RelevancyBench( this, ViewerClass, Class, Viewers, Count, Frames, Speed, Seed, Out );
+		return 1;
 	}
-	Out.Logf( "%sEnd Map\r\n", appSpc(Indent) );
-
-	unguard;
-}
-void ULevel::ModifyAllItems()
-{
-	guard(ULevel::ModifyAllItems);
-
-	// Modify all actors that exist.
-	for( int i=0; i<Num(); i++ )
+	else if( ParseCommand(&Str,"ACTORINDEX") )
 	{
-		ModifyItem( i );
-		if( Actors(i) )
-			Actors(i)->Modify();
+		if( ParseCommand(&Str,"ON") )
+			bNoActorIndex = 0;
+		else if( ParseCommand(&Str,"OFF") )
+			bNoActorIndex = 1;
+		else
+			bNoActorIndex = !bNoActorIndex;
+		if( bNoActorIndex )
+			FlushActorIndices();
+		Out->Logf( "AllActors indices %s", bNoActorIndex ? "disabled" : "enabled" );
+		return 1;
 	}
-	unguard;
-}
-void ULevel::Destroy()
-{
-	guard(ULevel::Destroy);
-
-	// Free the cached collision info.
-	if( Hash )
+	else if( ParseCommand(&Str,"ACTORINDEXBENCH") )
 	{
-		delete Hash;
-		Hash = NULL; /* Required because actors may try to unhash themselves */
+		UClass* Class      = ATriggers::StaticClass;
+		UClass* QueryClass = AZoneInfo::StaticClass;
+		INT     Count      = 8000;
+		INT     Queries    = 1000;
+		ParseObject<UClass>( Str, "CLASS=", Class, ANY_PACKAGE );
+		ParseObject<UClass>( Str, "QUERY=", QueryClass, ANY_PACKAGE );
+		Parse( Str, "COUNT=", Count );
+		Parse( Str, "QUERIES=", Queries );
+		if( InTick )
+			Out->Log( "Can't run ACTORINDEXBENCH while the level is ticking" );
+		else if( GIsEditor )
+			Out->Log( "ACTORINDEXBENCH: actor indices aren't used in the editor" );
+		else if( !Class->IsChildOf(AActor::StaticClass) || (Class->ClassFlags & CLASS_Abstract) )
+			Out->Logf( "ACTORINDEXBENCH: %s is not a spawnable actor class", Class->GetName() );
+		else if( !QueryClass->IsChildOf(AActor::StaticClass) )
+			Out->Logf( "ACTORINDEXBENCH: %s is not an actor class", QueryClass->GetName() );
+		else if( Count>=0 && Queries>0 )
+			ActorIndexBench( this, Class, QueryClass, Count, Queries, Out );
+		return 1;
 	}
-
-	if( BrushTracker )
+	else if( ParseCommand(&Str,"TIMERBENCH") )
 	{
-		delete BrushTracker;
-		BrushTracker = NULL; /* Required because brushes may clean themselves up */
+		UClass* Class  = ATriggers::StaticClass;
+		INT     Count  = 4000;
+		INT     Frames = 200;
+		ParseObject<UClass>( Str, "CLASS=", Class, ANY_PACKAGE );
+		Parse( Str, "COUNT=", Count );
+		Parse( Str, "FRAMES=", Frames );
+		if( InTick )
+			Out->Log( "Can't run TIMERBENCH while the level is ticking" );
+		else if( !Class->IsChildOf(AActor::StaticClass) || (Class->ClassFlags & CLASS_Abstract) )
+			Out->Logf( "TIMERBENCH: %s is not a spawnable actor class", Class->GetName() );
+		else if( Count>0 && Frames>0 )
+			TimerBench( this, Class, Count, Frames, Out );
+		return 1;
 	}
-
-	ULevelBase::Destroy();
-	unguard;
-}
-IMPLEMENT_DB_CLASS(ULevel);
-
-/*-----------------------------------------------------------------------------
-	Reconcile actors and Viewports after loading or creating a new level.
-
-	These functions provide the basic mechanism by which UnrealEd associates
-	Viewports and actors together, even when new maps are loaded which contain
-	an entirely different set of actors which must be mapped onto the existing 
-	Viewports.
------------------------------------------------------------------------------*/
-
-//
-// Remember actors.
-//
-void ULevel::RememberActors()
-{
-	guard(ULevel::RememberActors);
-
-	if( Engine->Client )
+	else if( ParseCommand(&Str,"PROJECTILEBATCH") )
 	{
-		for( int i=0; i<Engine->Client->Viewports.Num(); i++ )
+		if( ParseCommand(&Str,"ON") )
+			bNoProjectileBatch = 0;
+		else if( ParseCommand(&Str,"OFF") )
+			bNoProjectileBatch = 1;
+		else
+			bNoProjectileBatch = !bNoProjectileBatch;
+		Out->Logf( "Projectile sweep batching %s", bNoProjectileBatch ? "disabled" : "enabled" );
+		return 1;
+	}
+	else if( ParseCommand(&Str,"PROJECTILEBENCH") )
+	{
+		UClass* Class  = NULL;
+		INT     Count  = 2000;
+		INT     Frames = 100;
+		FLOAT   Speed  = 1000.f;
+		DWORD   Seed   = 1;
+		if( !ParseObject<UClass>( Str, "CLASS=", Class, ANY_PACKAGE ) )
 		{
-			UViewport* Viewport			= Engine->Client->Viewports(i);
-			Viewport->SavedOrthoZoom	= Viewport->Actor->OrthoZoom;
-			Viewport->SavedFovAngle		= Viewport->Actor->FovAngle;
-			Viewport->SavedShowFlags	= Viewport->Actor->ShowFlags;
-			Viewport->SavedRendMap		= Viewport->Actor->RendMap;
-			Viewport->SavedMisc1		= Viewport->Actor->Misc1;
-			Viewport->SavedMisc2		= Viewport->Actor->Misc2;
-			Viewport->Actor				= NULL;
+			// Default to the first projectile class which is loaded and can be spawned.
+			for( TObjectIterator<UClass> It; It && !Class; ++It )
+				if( It->IsChildOf(AProjectile::StaticClass) && !(It->ClassFlags & CLASS_Abstract) )
+					Class = *It;
 		}
+		Parse( Str, "COUNT=", Count );
+		Parse( Str, "FRAMES=", Frames );
+		Parse( Str, "SPEED=", Speed );
+		Parse( Str, "SEED=", Seed );
+		if( InTick )
+			Out->Log( "Can't run PROJECTILEBENCH while the level is ticking" );
+		else if( !Class || !Class->IsChildOf(AActor::StaticClass) || (Class->ClassFlags & CLASS_Abstract) )
+			Out->Logf( "PROJECTILEBENCH: %s is not a spawnable actor class", Class ? Class->GetName() : "no projectile class loaded, so CLASS=" );
+		else if( Count>0 && Frames>0 )
+			ProjectileBench( this, Class, Count, Frames, Speed, Seed, Out );
+		return 1;
 	}
-	unguard;
-}
-
-//
-// Reconcile actors.  This is called after loading a level.
-// It attempts to match each existing Viewport to an actor in the newly-loaded
-// level.  If no decent match can be found, creates a new actor for the Viewport.
-//
-void ULevel::ReconcileActors()
-{
-	guard(ULevel::ReconcileActors);
-	check(GIsEditor);
-
-	// Dissociate all actor Viewports and remember their view properties.
-	int i;
-	for( i=0; i<Num(); i++ )
-		if( Actors(i) && Actors(i)->IsA(APlayerPawn::StaticClass) )
-			if( ((APlayerPawn*)Actors(i))->Player )
-				((APlayerPawn*)Actors(i))->Player = NULL;
-
-	// Match Viewports and Viewport-actors with identical names.
-	guard(MatchIdentical);
-	for( i=0; i<Engine->Client->Viewports.Num(); i++ )
+	else if( ParseCommand(&Str,"COLLISIONBENCH") )
 	{
-		UViewport* Viewport = Engine->Client->Viewports(i);
-		check(Viewport->Actor==NULL);
-		for( INT j=0; j<Num(); j++ )
+		UClass* Class   = ATriggers::StaticClass;
+		INT     Count   = 4000;
+		INT     Queries = 20000;
+		FLOAT   Spread  = 4096.f;
+		ParseObject<UClass>( Str, "CLASS=", Class, ANY_PACKAGE );
+		Parse( Str, "COUNT=", Count );
+		Parse( Str, "QUERIES=", Queries );
+		Parse( Str, "SPREAD=", Spread );
+		if( InTick )
+			Out->Log( "Can't run COLLISIONBENCH while the level is ticking" );
+		else if( !Class->IsChildOf(AActor::StaticClass) || (Class->ClassFlags & CLASS_Abstract) )
+			Out->Logf( "COLLISIONBENCH: %s is not a spawnable actor class", Class->GetName() );
+		else if( Count>0 && Queries>0 )
+			CollisionBench( this, Class, Count, Queries, Spread, Out );
+		return 1;
+	}
+	else if( ParseCommand(&Str,"ACTORGRID") )
+	{
+		if( ParseCommand(&Str,"ON") )
+			bNoActorGrid = 0;
+		else if( ParseCommand(&Str,"OFF") )
+			bNoActorGrid = 1;
+		else
+			bNoActorGrid = !bNoActorGrid;
+		if( bNoActorGrid && ActorGrid )
 		{
-			AActor* Actor = Actors(j);
-			if( Actor && Actor->IsA(ACamera::StaticClass) && appStricmp(*Actor->Tag,Viewport->GetName())==0 )
-			{
-				debugf( NAME_Log, "Matched Viewport %s", Viewport->GetName() );
-				Viewport->Actor         = (APlayerPawn *)Actor;
-				Viewport->Actor->Player = Viewport;
-				break;
-			}
+			delete ActorGrid;
+			ActorGrid = NULL;
 		}
+		Out->Logf( "Actor location grid %s", bNoActorGrid ? "disabled" : "enabled" );
+		return 1;
 	}
-	unguard;
-
-	// Match up all remaining Viewports to actors.
-	guard(MatchEditorOther);
-	for( i=0; i<Engine->Client->Viewports.Num(); i++ )
+	else if( ParseCommand(&Str,"RADIUSBENCH") )
 	{
-		// Hook Viewport up to an existing actor or createa a new one.
-		UViewport* Viewport = Engine->Client->Viewports(i);
-		if( !Viewport->Actor )
-			SpawnViewActor( Viewport );
+		UClass* Class   = ATriggers::StaticClass;
+		INT     Count   = 4000;
+		INT     Queries = 2000;
+		FLOAT   Radius  = 512.f;
+		FLOAT   Spread  = 4096.f;
+		ParseObject<UClass>( Str, "CLASS=", Class, ANY_PACKAGE );
+		Parse( Str, "COUNT=", Count );
+		Parse( Str, "QUERIES=", Queries );
+		Parse( Str, "RADIUS=", Radius );
+		Parse( Str, "SPREAD=", Spread );
+		if( InTick )
+			Out->Log( "Can't run RADIUSBENCH while the level is ticking" );
+		else if( GIsEditor )
+			Out->Log( "RADIUSBENCH: the actor location grid isn't used in the editor" );
+		else if( !Class->IsChildOf(AActor::StaticClass) || (Class->ClassFlags & CLASS_Abstract) )
+			Out->Logf( "RADIUSBENCH: %s is not a spawnable actor class", Class->GetName() );
+		else if( Count>=0 && Queries>0 && Radius>0.0 )
+			RadiusBench( this, Class, Count, Queries, Radius, Spread, Out );
+		return 1;
 	}
-	unguard;
-
-	// Handle remaining unassociated view actors.
-	guard(KillViews);
-	for( i=0; i<Num(); i++ )
+	else if( ParseCommand(&Str,"ROUTEPLANNER") )
 	{
-		ACamera* View = Cast<ACamera>(Actors(i));
-		if( View )
+		if( ParseCommand(&Str,"ON") )
+			bNoRoutePlanner = 0;
+		else if( ParseCommand(&Str,"OFF") )
+			bNoRoutePlanner = 1;
+		else if( !ParseCommand(&Str,"STATS") )
+			bNoRoutePlanner = !bNoRoutePlanner;
+		if( RoutePlanner )
 		{
-			UViewport* Viewport = Cast<UViewport>(View->Player);
-			if( Viewport )
-			{
-				UViewport* Viewport	= (UViewport*)View->Player;
-				View->ClearFlags( RF_Transactional );
-				View->OrthoZoom		= Viewport->SavedOrthoZoom;	
-				View->FovAngle		= Viewport->SavedFovAngle;
-				View->ShowFlags		= Viewport->SavedShowFlags;
-				View->RendMap		= Viewport->SavedRendMap;
-				View->Misc1			= Viewport->SavedMisc1;
-				View->Misc2			= Viewport->SavedMisc2;
-			}
-			else DestroyActor( View );
+			Out->Logf
+			(
+				"Route planner: %i searches, %i nodes expanded, %i of %i anchored routes cached",
+				RoutePlanner->NumSearches,
+				RoutePlanner->NumExpanded,
+				RoutePlanner->NumCacheHits,
+				RoutePlanner->NumCacheHits + RoutePlanner->NumCacheMisses
+			);
+			RoutePlanner->NumSearches = RoutePlanner->NumExpanded = RoutePlanner->NumCacheHits = RoutePlanner->NumCacheMisses = 0;
 		}
+		if( bNoRoutePlanner && RoutePlanner )
+		{
+			delete RoutePlanner;
+			RoutePlanner = NULL;
+		}
+		Out->Logf( "Route planner %s", bNoRoutePlanner ? "disabled" : "enabled" );
+		return 1;
+	}
+	else if( ParseCommand(&Str,"ROUTETABLE") )
+	{
+		if( ParseCommand(&Str,"ON") )
+			bNoRouteTable = 0;
+		else if( ParseCommand(&Str,"OFF") )
+			bNoRouteTable = 1;
+		else if( !ParseCommand(&Str,"STATS") )
+			bNoRouteTable = !bNoRouteTable;
+		if( RoutePlanner )
+		{
+			Out->Logf
+			(
+				"Route tables: %i tables, %iK, built in %.1f msec; %i routes looked up, %i blocked by movers",
+				RoutePlanner->NumRouteTables(),
+				RoutePlanner->RouteTableBytes() / 1024,
+				RoutePlanner->TableBuildSeconds * 1000.0,
+				RoutePlanner->NumTableRoutes,
+				RoutePlanner->NumTableMisses
+			);
+			RoutePlanner->NumTableRoutes = RoutePlanner->NumTableMisses = 0;
+		}
+		Out->Logf( "Route tables %s", bNoRouteTable ? "disabled" : "enabled" );
+		return 1;
+	}
+	else if( ParseCommand(&Str,"PATHBENCH") )
+	{
+		UClass* Class  = NULL;
+		INT     Bots   = 32;
+		INT     Frames = 50;
+		INT     Goals  = 4;
+		DWORD   Seed   = 1;
+		if( !ParseObject<UClass>( Str, "CLASS=", Class, ANY_PACKAGE ) )
+		{
+			// Default to the first pawn class which is loaded and can be spawned.
+			for( TObjectIterator<UClass> It; It && !Class; ++It )
+				if( It->IsChildOf(APawn::StaticClass) && !It->IsChildOf(APlayerPawn::StaticClass) && !(It->ClassFlags & CLASS_Abstract) )
+					Class = *It;
+		}
+		Parse( Str, "BOTS=", Bots );
+		Parse( Str, "FRAMES=", Frames );
+		Parse( Str, "GOALS=", Goals );
+		Parse( Str, "SEED=", Seed );
+		if( InTick )
+			Out->Log( "Can't run PATHBENCH while the level is ticking" );
+		else if( GIsEditor )
+			Out->Log( "PATHBENCH: the route planner isn't used in the editor" );
+		else if( !Class || !Class->IsChildOf(APawn::StaticClass) || (Class->ClassFlags & CLASS_Abstract) )
+			Out->Logf( "PATHBENCH: %s is not a spawnable pawn class", Class ? Class->GetName() : "no pawn class loaded, so CLASS=" );
+		else if( Bots>0 && Frames>0 )
+			RoutePlannerBench( this, Class, Bots, Frames, Goals, Seed, Out );
+		return 1;
+	}
+	else if( ParseCommand(&Str,"CHECKBENCH") )
+	{
+		INT   Count  = 20000;
+		FLOAT Length = 2048.f;
+		DWORD Seed   = 1;
+		char  File[256]="";
+		Parse( Str, "COUNT=", Count );
+		Parse( Str, "LENGTH=", Length );
+		Parse( Str, "SEED=", Seed );
+		Parse( Str, "FILE=", File, ARRAY_COUNT(File) );
+		if( Count>0 )
+			CheckBench( this, Count, Length, Seed, File, Out );
+		return 1;
+	}
+	else if( ParseCommand(&Str,"TRACEBENCH") )
+	{
+		INT   Count  = 50000;
+		FLOAT Length = 2048.f;
+		DWORD Seed   = 1;
+		Parse( Str, "COUNT=", Count );
+		Parse( Str, "LENGTH=", Length );
+		Parse( Str, "SEED=", Seed );
+		if( Count>0 )
+			TraceBench( this, Count, Length, Seed, Out );
+		return 1;
 	}
-	unguard;
-
-	unguard;
-}
-
-/*-----------------------------------------------------------------------------
-	ULevel command-line.
------------------------------------------------------------------------------*/
-
-UBOOL ULevel::Exec( const char* Cmd, FOutputDevice* Out )
-{
-	guard(ULevel::Exec);
-	const char* Str = Cmd;
-	if( NetDriver && NetDriver->Exec( Cmd, Out ) ) return 1;
 	else return 0;
 	unguard;
 }
@@ -401,6 +2331,7 @@ UBOOL ULevel::Listen( char* Error256 )
 					debugf( "Spawning: %s", GameEngine->ServerActors[i] );
 					UClass* HelperClass = GObj.LoadClass( AActor::StaticClass, NULL, GameEngine->ServerActors[i], NULL, LOAD_NoFail | LOAD_KeepImports, NULL );
 					SpawnActor( HelperClass );
+					ServerActorClasses.AddUniqueItem( HelperClass );
 				}
 			}
 
@@ -684,8 +2615,13 @@ void ULevel::InitStats()
 	guard(ULevel::InitStats);
 	NetTickCycles = ActorTickCycles = AudioTickCycles = FindPathCycles
 	= MoveCycles = NumMoves = NumReps = NumPV = GetRelevantCycles = NumRPC = SeePlayer
-	= Spawning = Unused = 0;
+	= Spawning = Unused = NumWoken = NumTicked = NumRegionHits = NumRegionLookups
+	= NumSweepsBatched = NumSweepsUsed = NumSightHits = NumSightLookups = NumSightTraces
+	= NumAISkipped = NumAISensed = AITickCycles = NumPoolHits = NumPoolSpawns
+	= NumRelevancyHits = NumRelevancyCulled = NumRelevancyTraces = 0;
 	GScriptEntryTag = GScriptCycles = 0;
+	if( BrushTracker )
+		BrushTracker->InitStats();
 	unguard;
 }
 void ULevel::GetStats( char* Result )
@@ -694,7 +2630,7 @@ void ULevel::GetStats( char* Result )
 	appSprintf
 	(
 		Result,
-		"Script=%05.1f Actor=%04.1f Path=%04.1f See=%04.1f Spawn=%04.1f Audio=%04.1f Un=%04.1f Move=%04.1f (%i) Net=%04.1f",
+		"Script=%05.1f Actor=%04.1f Path=%04.1f See=%04.1f Spawn=%04.1f Audio=%04.1f Un=%04.1f Move=%04.1f (%i) Net=%04.1f Tick=%i/%i Park=%i Wake=%i Region=%i/%i Sweep=%i/%i Sight=%i/%i (%i) AI=%04.1f Skip=%i Sense=%i (%i) Pool=%i/%i Rel=%i Cull=%i (%i)",
 		GSecondsPerCycle*1000 * GScriptCycles,
 		GSecondsPerCycle*1000 * ActorTickCycles,
 		GSecondsPerCycle*1000 * FindPathCycles,
@@ -704,8 +2640,33 @@ void ULevel::GetStats( char* Result )
 		GSecondsPerCycle*1000 * Unused,
 		GSecondsPerCycle*1000 * MoveCycles,
 		NumMoves,
-		GSecondsPerCycle*1000 * NetTickCycles
+		GSecondsPerCycle*1000 * NetTickCycles,
+		NumTicked,
+		NumLiveActors,
+		NumParked,
+		NumWoken,
+		NumRegionHits,
+		NumRegionLookups,
+		NumSweepsUsed,
+		NumSweepsBatched,
+		NumSightHits,
+		NumSightLookups,
+		NumSightTraces,
+		GSecondsPerCycle*1000 * AITickCycles,
+		NumAISkipped,
+		NumAISensed,
+		SenseQueue.Num(),
+		NumPoolHits,
+		NumPoolSpawns,
+		NumRelevancyHits,
+		NumRelevancyCulled,
+		NumRelevancyTraces
 	);
+	if( BrushTracker )
+	{
+		appStrcat( Result, " " );
+		BrushTracker->GetStats( Result + appStrlen(Result) );
+	}
 	unguard;
 }
 
@@ -714,62 +2675,123 @@ void ULevel::GetStats( char* Result )
 -----------------------------------------------------------------------------*/
 
 //
-// Check visibility.
+// Check visibility without tracing, where possible.  Returns 1 if visible,
+// 0 if not, or INDEX_NONE if it takes traces to tell, in which case Target
+// is set to the actor which should be traced to.
 //
-static UBOOL CanSee
-(
-	AActor*		Viewer,
-	FVector		Location,
-	AActor*		Target,
-	FVector		Ahead
-)
+static INT TrivialCanSee( AActor* Viewer, AActor*& Target )
 {
-	guardSlow(CanSee);
+	guardSlow(TrivialCanSee);
 	if( Target->IsOwnedBy( Viewer ) )
 		return 1;
 	if( Target->Owner && Target->Owner->IsA(APawn::StaticClass) && ((APawn*)Target->Owner)->Weapon==Target )
-		return CanSee( Viewer, Location, Target->Owner, Ahead );
+	{
+		Target = Target->Owner;
+		return TrivialCanSee( Viewer, Target );
+	}
 	if( Target->IsA(AZoneInfo::StaticClass) )
 		return 1;
 	if( Target->bHidden && !Target->bBlockPlayers && !Target->AmbientSound )
 		return 0;
-	FCheckResult Hit(1.0);
 
 	// Moving brushes would need volume visibility checking which is impractical here.
 	if( Target->Brush )
 		return 1;
 
-	// Trace from current location.
-	if( Viewer->XLevel->Model->LineCheck(Hit,NULL,Location,Target->Location,FVector(0,0,0),NF_NotVisBlocking) )
-		return 1;
+	return INDEX_NONE;
+	unguardSlow;
+}
 
-	// Trace from predicted future location.
-	if( Viewer->XLevel->Model->LineCheck(Hit,NULL,Ahead,Target->Location,FVector(0,0,0),NF_NotVisBlocking) )
-		return 1;
+//
+// Find the relevancy cache bit of a network viewer viewing from Location,
+// claiming one if it hasn't got one, or INDEX_NONE if the cache is off.
+// Sets bReset if the viewer's old results can't be reused, in which case
+// the caller must clear its bit from every actor's record.
+//
+INT ULevel::FindRelevancyViewer( AActor* Viewer, FVector Location, UBOOL& bReset )
+{
+	guard(ULevel::FindRelevancyViewer);
+	bReset = 0;
+	if( bNoRelevancyCache || GIsEditor )
+		return INDEX_NONE;
+
+	// Find the viewer's bit, or the free or least recently reset one.
+	INT iViewer=INDEX_NONE, iOldest=0;
+	for( INT i=0; i<MAX_RELEVANCY_VIEWERS && iViewer==INDEX_NONE; i++ )
+	{
+		if( RelevancyViewers[i].Viewer==Viewer )
+			iViewer = i;
+		else if( RelevancyViewers[iOldest].Viewer && (!RelevancyViewers[i].Viewer || RelevancyViewers[i].Time<RelevancyViewers[iOldest].Time) )
+			iOldest = i;
+	}
+	if( iViewer==INDEX_NONE )
+	{
+		iViewer = iOldest;
+		RelevancyViewers[iViewer].Viewer = Viewer;
+		bReset = 1;
+	}
 
-	// If near, pick random location in bounding box, which will average out with relevence timer.
-	if( (Target->Location-Location).SizeSquared() < Square(64*Target->CollisionHeight) )
+	// Start over if it has moved too far or the results are too old.
+	FLOAT Tolerance = RelevancyTolerance>0.f ? RelevancyTolerance : 32.f;
+	FLOAT Lifetime  = RelevancyLifetime >0.f ? RelevancyLifetime  : 0.25f;
+	FRelevancyViewer& Slot = RelevancyViewers[iViewer];
+	if
+	(	bReset
+	||	TimeSeconds-Slot.Time<0.f
+	||	TimeSeconds-Slot.Time>Lifetime
+	||	(Location-Slot.Location).SizeSquared()>Square(Tolerance) )
 	{
-		// Near, so trace from current location to box vertices.
-		FBox Box = Target->GetPrimitive()->GetRenderBoundingBox( Target, 0 );
-		FVector V
-		(
-			Box.Min.X + appFrand()*(Box.Max.X-Box.Min.X),
-			Box.Min.Y + appFrand()*(Box.Max.Y-Box.Min.Y),
-			Box.Min.Z + appFrand()*(Box.Max.Z-Box.Min.Z)
-		);
-		if( Viewer->XLevel->Model->LineCheck(Hit,NULL,V,Location,FVector(0,0,0),NF_NotVisBlocking) )
-			return 1;
+		Slot.Location = Location;
+		Slot.Time     = TimeSeconds;
+		bReset        = 1;
 	}
+	return iViewer;
+	unguard;
+}
 
+//
+// Whether the zone visibility masks have been built.  Unbuilt zones
+// default to seeing every zone.
+//
+UBOOL ULevel::ZoneVisibilityBuilt()
+{
+	guard(ULevel::ZoneVisibilityBuilt);
+	if( Model->Nodes )
+		for( INT i=1; i<Model->Nodes->NumZones; i++ )
+			if( Model->Nodes->Zones[i].Visibility != ~(QWORD)0 )
+				return 1;
 	return 0;
-	unguardSlow;
+	unguard;
+}
+
+//
+// Forget an actor's relevancy results, and give up its viewer bit.
+//
+void ULevel::FlushRelevancyCache( AActor* Actor )
+{
+	guard(ULevel::FlushRelevancyCache);
+	INT Index = Actor->GetIndex();
+	if( Index<ActorRelevancy.Num() )
+		appMemset( &ActorRelevancy(Index), 0, sizeof(FActorRelevancy) );
+	for( INT i=0; i<MAX_RELEVANCY_VIEWERS; i++ )
+		if( RelevancyViewers[i].Viewer==Actor )
+			RelevancyViewers[i].Viewer = NULL;
+	unguard;
 }
 
 //
 // Get a list of actors that are relevant to a given network player pawn.
 // These actors are replicated over the net.
 //
+// If bRelevancyCull is set, actors which need traces are first culled by
+// the zones visible from the viewer's current and predicted locations, if
+// the zone visibility has been built, and by RelevancyDistance if set.
+// The traces for the rest are batched, in three rounds, each only for the
+// actors not yet seen: from the viewer's current location, from its
+// predicted location, then to random points within nearby actors.
+// What the traces found is kept in ActorRelevancy and reused while neither
+// the viewer nor the actor moves far.
+//
 INT ULevel::GetRelevantActors( APlayerPawn* InViewer, AActor** List, INT Max )
 {
 	guard(ULevel::GetRelevantActors);
@@ -802,21 +2824,175 @@ INT ULevel::GetRelevantActors( APlayerPawn* InViewer, AActor** List, INT Max )
 	Hit.Location = Location + Ahead;
 	Viewer->XLevel->Model->LineCheck(Hit,NULL,Hit.Location,Location,FVector(0,0,0),NF_NotVisBlocking);
 
-	// Slow version which doesn't use any precomputed visibility.
+	// Zones which can be seen from either location.  Zone zero is outside
+	// any zone, so neither it nor actors in it are culled.
+	QWORD VisibleZones = ~(QWORD)0;
+	if( bRelevancyCull && ZoneVisibilityBuilt() )
+	{
+		INT iZone = Model->PointRegion( GetLevelInfo(), Location ).ZoneNumber;
+		INT iAhead = Model->PointRegion( GetLevelInfo(), Hit.Location ).ZoneNumber;
+		if( iZone>0 && iAhead>0 && iZone<Model->Nodes->NumZones && iAhead<Model->Nodes->NumZones )
+			VisibleZones = Model->Nodes->Zones[iZone].Visibility | Model->Nodes->Zones[iAhead].Visibility;
+	}
+
+	// The dynamic actors, from the live actor list if it is kept.
+	TArray<AActor*>* Live          = GetLiveActors();
+	INT              NumCandidates = Live ? Live->Num() : Num() - iFirstDynamicActor;
+	AActor**         Candidates    = Live ? &(*Live)(0) : &Actors(iFirstDynamicActor);
+
+	// Find the viewer's bit in the relevancy cache.
+	UBOOL bReset;
+	INT   iViewer   = FindRelevancyViewer( InViewer, Location, bReset );
+	QWORD Bit       = iViewer!=INDEX_NONE ? ((QWORD)1)<<iViewer : 0;
+	FLOAT Tolerance = RelevancyTolerance>0.f ? RelevancyTolerance : 32.f;
+	if( bReset )
+		for( INT j=0; j<NumCandidates; j++ )
+			if( Candidates[j] && Candidates[j]->GetIndex()<ActorRelevancy.Num() )
+				ActorRelevancy(Candidates[j]->GetIndex()).Checked &= ~Bit;
+
+	// Sort out the actors which don't need traces, and queue a trace from
+	// the viewer's location to each of the others.
+	FMemMark Mark(GMem);
+	INT             MaxCandidates = ::Max( NumCandidates, 1 );
+	BYTE*           Visible       = new(GMem,MaxCandidates)BYTE;
+	AActor**        Targets       = new(GMem,MaxCandidates)AActor*;
+	INT*            Pending       = new(GMem,MaxCandidates)INT;
+	FTraceRequest*  Requests      = new(GMem,2*MaxCandidates)FTraceRequest;
+	INT*            RequestOwners = new(GMem,2*MaxCandidates)INT;
+	FCheckResult*   Hits          = new(GMem,2*MaxCandidates)FCheckResult;
+	INT             NumPending    = 0;
+	for( INT j=0; j<NumCandidates; j++ )
+	{
+		Visible[j] = 0;
+		if( Candidates[j] && Candidates[j]->RemoteRole!=ROLE_None )
+		{
+			AActor* Target = Candidates[j];
+			INT Result = Target==InViewer ? 1 : TrivialCanSee( Viewer, Target );
+			if( Result!=INDEX_NONE )
+			{
+				Visible[j] = Result;
+				continue;
+			}
+
+			// Cull without tracing.
+			INT iTargetZone = Target->Region.ZoneNumber;
+			if
+			(	(iTargetZone>0 && !(VisibleZones & (((QWORD)1)<<iTargetZone)))
+			||	(bRelevancyCull
+			&&	 RelevancyDistance>0.f
+			&&	 (Target->Location-Location    ).SizeSquared()>Square(RelevancyDistance)
+			&&	 (Target->Location-Hit.Location).SizeSquared()>Square(RelevancyDistance)) )
+			{
+				NumRelevancyCulled++;
+				TotalRelevancyCulled++;
+				continue;
+			}
+
+			// Reuse what the last traces found.
+			Targets[j] = Target;
+			if( Bit )
+			{
+				INT Index = Target->GetIndex();
+				if( Index>=ActorRelevancy.Num() )
+					ActorRelevancy.AddZeroed( Index+1-ActorRelevancy.Num() );
+				TotalRelevancyLookups++;
+				FActorRelevancy& Rel = ActorRelevancy(Index);
+				if( (Target->Location-Rel.Location).SizeSquared()>Square(Tolerance) )
+				{
+					Rel.Location = Target->Location;
+					Rel.Checked  = 0;
+				}
+				else if( Rel.Checked & Bit )
+				{
+					NumRelevancyHits++;
+					TotalRelevancyHits++;
+					Visible[j] = (Rel.Visible & Bit)!=0;
+					continue;
+				}
+			}
+			Requests[NumPending] = FTraceRequest( Location, Target->Location, TRACE_Level, NULL, FVector(0,0,0), NF_NotVisBlocking, 0 );
+			Pending[NumPending++] = j;
+		}
+	}
+	BatchLineCheck( Hits, Requests, NumPending );
+	INT NumRequests = 0;
+	for( INT k=0; k<NumPending; k++ )
+	{
+		INT j = Pending[k];
+		if( Hits[k].Actor==NULL )
+		{
+			Visible[j] = 1;
+			continue;
+		}
+
+		// Not seen from the current location, so trace from the predicted
+		// future location.
+		AActor* Target = Targets[j];
+		RequestOwners[NumRequests] = j;
+		Requests[NumRequests++] = FTraceRequest( Hit.Location, Target->Location, TRACE_Level, NULL, FVector(0,0,0), NF_NotVisBlocking, 0 );
+	}
+	BatchLineCheck( Hits, Requests, NumRequests );
+	INT NumAhead = NumRequests;
+	NumRequests  = 0;
+	for( INT k=0; k<NumAhead; k++ )
+	{
+		INT j = RequestOwners[k];
+		if( Hits[k].Actor==NULL )
+		{
+			Visible[j] = 1;
+			continue;
+		}
+
+		// Not seen from there either, so if near, trace from the current
+		// location to a random point in the bounding box, which will average
+		// out with the relevance timer.
+		AActor* Target = Targets[j];
+		if( (Target->Location-Location).SizeSquared() < Square(64*Target->CollisionHeight) )
+		{
+			FBox Box = Target->GetPrimitive()->GetRenderBoundingBox( Target, 0 );
+			FVector V
+			(
+				Box.Min.X + appFrand()*(Box.Max.X-Box.Min.X),
+				Box.Min.Y + appFrand()*(Box.Max.Y-Box.Min.Y),
+				Box.Min.Z + appFrand()*(Box.Max.Z-Box.Min.Z)
+			);
+			RequestOwners[NumRequests] = j;
+			Requests[NumRequests++] = FTraceRequest( V, Location, TRACE_Level, NULL, FVector(0,0,0), NF_NotVisBlocking, 0 );
+		}
+	}
+	BatchLineCheck( Hits, Requests, NumRequests );
+	for( INT k=0; k<NumRequests; k++ )
+		if( Hits[k].Actor==NULL )
+			Visible[RequestOwners[k]] = 1;
+	NumRelevancyTraces   += NumPending + NumAhead + NumRequests;
+	TotalRelevancyTraces += NumPending + NumAhead + NumRequests;
+
+	// Remember what the traces found.
+	if( Bit )
+	{
+		for( INT k=0; k<NumPending; k++ )
+		{
+			INT j = Pending[k];
+			FActorRelevancy& Rel = ActorRelevancy(Targets[j]->GetIndex());
+			Rel.Checked |= Bit;
+			if( Visible[j] )
+				Rel.Visible |= Bit;
+			else
+				Rel.Visible &= ~Bit;
+		}
+	}
+
+	// Build the list.
 	INT Count=0;
-	for( INT i=iFirstDynamicActor; i<Num(); i++ )
+	for( INT j=0; j<NumCandidates && Count<Max; j++ )
 	{
-		if
-		(	Actors(i)
-		&&	Actors(i)->RemoteRole!=ROLE_None
-		&&	(Actors(i)==InViewer || CanSee(Viewer,Location,Actors(i),Hit.Location)) )
+		if( Visible[j] )
 		{
-			Actors(i)->NetTag = NetTag;
-			List[Count++] = Actors(i);
-			if( Count == Max )
-				break;
+			Candidates[j]->NetTag = NetTag;
+			List[Count++] = Candidates[j];
 		}
 	}
+	Mark.Pop();
 	NumPV += Count;
 	uunclock(GetRelevantCycles);
 	return Count;
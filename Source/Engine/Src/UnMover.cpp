@@ -108,6 +108,7 @@ void AMover::SetWorldRaytraceKey()
 		Location = BasePos + KeyPos[WorldRaytraceKey];
 		Rotation = BaseRot + KeyRot[WorldRaytraceKey];
 		if( bCollideActors && XLevel->Hash ) XLevel->Hash->AddActor( this );
+		if( XLevel->ActorGrid ) XLevel->ActorGrid->RefileActor( this );
 		if( XLevel->BrushTracker )
 			XLevel->BrushTracker->Update( this );
 	}
@@ -127,6 +128,7 @@ void AMover::SetBrushRaytraceKey()
 	Location = BasePos + KeyPos[BrushRaytraceKey];
 	Rotation = BaseRot + KeyRot[BrushRaytraceKey];
 	if( bCollideActors && XLevel->Hash ) XLevel->Hash->AddActor( this );
+	if( XLevel->ActorGrid ) XLevel->ActorGrid->RefileActor( this );
 	if( XLevel->BrushTracker )
 		XLevel->BrushTracker->Update( this );
 
@@ -142,6 +144,7 @@ void AMover::PostRaytrace()
 	Location = BasePos + KeyPos[KeyNum];
 	Rotation = BaseRot + KeyRot[KeyNum];
 	if( bCollideActors && XLevel->Hash ) XLevel->Hash->AddActor( this );
+	if( XLevel->ActorGrid ) XLevel->ActorGrid->RefileActor( this );
 	SavedPos = FVector(0,0,0);
 	SavedRot = FRotator(0,0,0);
 	if( XLevel->BrushTracker )
@@ -209,10 +209,11 @@ void ENGINE_API FPathBuilder::undefinePaths (ULevel *ownerLevel)
 	unguard;
 }
 
-void ENGINE_API FPathBuilder::definePaths (ULevel *ownerLevel)
+void ENGINE_API FPathBuilder::definePaths (ULevel *ownerLevel, UBOOL bCheck)
 {
 	guard(FPathBuilder::definePaths);
 	Level = ownerLevel;
+	DOUBLE StartTime = appSeconds();
 	getScout();
 	Level->GetLevelInfo()->NavigationPointList = NULL;
 
@@ -249,8 +250,11 @@ void ENGINE_API FPathBuilder::definePaths (ULevel *ownerLevel)
 		}
 	}
 
-	//calculate and add reachspecs to pathnodes
-	debugf(NAME_DevPath,"Add reachspecs");
+	DOUBLE MarkerTime = appSeconds();
+	debugf(NAME_DevPath,"Added markers in %f sec", MarkerTime - StartTime);
+
+	//test reachability between nearby pathnodes
+	TArray<ANavigationPoint*> Navs;
 	for (i=0; i<Level->Num(); i++)
 	{
 		AActor *Actor = Level->Actors(i); 
@@ -258,12 +262,24 @@ void ENGINE_API FPathBuilder::definePaths (ULevel *ownerLevel)
 		{
 			((ANavigationPoint *)Actor)->nextNavigationPoint = Level->GetLevelInfo()->NavigationPointList;
 			Level->GetLevelInfo()->NavigationPointList = (ANavigationPoint *)Actor;
-			addReachSpecs(Actor);
-			debugf( NAME_DevPath, "Added reachspecs to %s",Actor->GetName() );
+			Navs.AddItem((ANavigationPoint *)Actor);
 		}
 	}
+	TArray<INT> First;
+	TArray<FPathCandidate> Candidates;
+	testReachability(Navs, First, Candidates, bCheck);
+
+	//calculate and add reachspecs to pathnodes, in level order
+	DOUBLE ReachTime = appSeconds();
+	debugf(NAME_DevPath,"Add reachspecs");
+	for (i=0; i<Navs.Num(); i++)
+	{
+		addReachSpecs(Navs(i), &Candidates(0) + First(i), First(i+1) - First(i));
+		debugf( NAME_DevPath, "Added reachspecs to %s",Navs(i)->GetName() );
+	}
 
-	debugf(NAME_DevPath,"Added %d reachspecs", Level->ReachSpecs.Num()); 
+	DOUBLE AddTime = appSeconds();
+	debugf(NAME_DevPath,"Added %d reachspecs in %f sec", Level->ReachSpecs.Num(), AddTime - ReachTime); 
 	//remove extra reachspecs from teleporters
 
 	//prune excess reachspecs
@@ -275,7 +291,7 @@ void ENGINE_API FPathBuilder::definePaths (ULevel *ownerLevel)
 		numPruned += Prune(Nav);
 		Nav = Nav->nextNavigationPoint;
 	}
-	debugf(NAME_DevPath,"Pruned %d reachspecs", numPruned);
+	debugf(NAME_DevPath,"Pruned %d reachspecs in %f sec", numPruned, appSeconds() - AddTime);
 
 	// check for doors, and update reachspecs
 	/*
@@ -290,7 +306,7 @@ void ENGINE_API FPathBuilder::definePaths (ULevel *ownerLevel)
 	debugf("Check for doors");
 	*/
 	Level->DestroyActor(Scout);
-	debugf(NAME_DevPath,"All done");
+	debugf(NAME_DevPath,"All done in %f sec", appSeconds() - StartTime);
 	unguard;
 }
 
@@ -481,10 +497,178 @@ int FPathBuilder::insertReachSpec(INT *SpecArray, FReachSpec &Spec)
 	unguard;
 }
 
+/*-----------------------------------------------------------------------------
+	Reachability tests.
+-----------------------------------------------------------------------------*/
+
+//
+// Pairs definePaths tests, gathered on the job workers: every other path
+// node within 1000 units of each node, in level order, except to and from
+// lift centers, which get their specs from their lift exits.  Run once to
+// count each node's pairs and again to fill them in.
+//
+struct FPathGather
+{
+	ANavigationPoint**	Navs;
+	INT					NumNavs;
+	INT*				Count;
+	INT*				First;
+	FPathCandidate*		Candidates;		// NULL when counting.
+};
+static void PathGatherRange( void* Arg, INT Start, INT End )
+{
+	guard(PathGatherRange);
+	FPathGather& Gather = *(FPathGather*)Arg;
+	for( INT i=Start; i<End; i++ )
+	{
+		ANavigationPoint* Node = Gather.Navs[i];
+		INT Num = 0;
+		if( !Node->IsA(ALiftCenter::StaticClass) )
+		{
+			for( INT j=0; j<Gather.NumNavs; j++ )
+			{
+				ANavigationPoint* Other = Gather.Navs[j];
+				if( Other!=Node && !Other->IsA(ALiftCenter::StaticClass) && (Node->Location - Other->Location).SizeSquared() < 1000000 )
+				{
+					if( Gather.Candidates )
+					{
+						FPathCandidate& Candidate = Gather.Candidates[Gather.First[i] + Num];
+						Candidate.iNode      = i;
+						Candidate.End        = Other;
+						Candidate.bReachable = 0;
+					}
+					Num++;
+				}
+			}
+		}
+		if( !Gather.Candidates )
+			Gather.Count[i] = Num;
+	}
+	unguard;
+}
+
+/* testReachability()
+define a reachspec for every pair of nearby pathnodes the scout can walk between.
+Each pair's test is independent, but walks the scout through the level, so the tests
+can't share the collision hash between threads.  Instead the tests which can only fail
+are weeded out first:  FReachSpec::defineFor first tries the scout at 18x39 at the start
+node, and gives up if it doesn't fit there, or can't see the end node from there. 
+So the scout is placed once per node, and every pair's line of sight is traced in one
+batch, whose world traces run on the job workers.  Only the visible pairs are walked.
+With bCheck, every pair is then walked as the serial build did, and the results compared.
+*/
+void FPathBuilder::testReachability(TArray<ANavigationPoint*> &Navs, TArray<INT> &First, TArray<FPathCandidate> &Candidates, UBOOL bCheck)
+{
+	guard(FPathBuilder::testReachability);
+
+	// Gather the pairs.
+	DOUBLE StartTime = appSeconds();
+	INT i;
+	First.Add(Navs.Num() + 1);
+	First(0) = 0;
+	if ( !Navs.Num() )
+		return;
+	TArray<INT> Count;
+	Count.Add(Navs.Num());
+	FPathGather Gather;
+	Gather.Navs = &Navs(0);
+	Gather.NumNavs = Navs.Num();
+	Gather.Count = &Count(0);
+	Gather.First = &First(0);
+	Gather.Candidates = NULL;
+	GJobs.ParallelFor(Navs.Num(), PathGatherRange, &Gather, 4);
+	for (i=0; i<Navs.Num(); i++)
+		First(i+1) = First(i) + Count(i);
+	Candidates.Add(First(Navs.Num()) + 1); //one spare, so the list is never empty
+	Gather.Candidates = &Candidates(0);
+	GJobs.ParallelFor(Navs.Num(), PathGatherRange, &Gather, 4);
+	INT NumCandidates = First(Navs.Num());
+
+	// Place the scout at each node as defineFor first does, and note its eyes.
+	DOUBLE GatherTime = appSeconds();
+	FMemMark Mark(GMem);
+	FTraceRequest* Requests = new(GMem,NumCandidates + 1)FTraceRequest;
+	FCheckResult* Hits = new(GMem,NumCandidates + 1)FCheckResult;
+	INT* RequestFor = new(GMem,NumCandidates + 1)INT;
+	INT NumRequests = 0;
+	for (i=0; i<Navs.Num(); i++)
+	{
+		INT bFits = 0;
+		FVector ViewPoint;
+		if ( First(i+1) > First(i) )
+		{
+			Scout->SetCollisionSize(18.0, 39.0); //see FReachSpec::findBestReachable()
+			bFits = Level->FarMoveActor(Scout, Navs(i)->Location);
+			ViewPoint = Scout->Location;
+			ViewPoint.Z += Scout->BaseEyeHeight;
+		}
+		for (INT j=First(i); j<First(i+1); j++)
+		{
+			RequestFor[j] = bFits ? NumRequests : -1;
+			if ( bFits )
+				Requests[NumRequests++] = FTraceRequest(Candidates(j).End->Location, ViewPoint, TRACE_VisBlocking, Scout);
+		}
+	}
+
+	// Trace every line of sight at once.
+	DOUBLE PlaceTime = appSeconds();
+	Level->BatchLineCheck(Hits, Requests, NumRequests);
+
+	// Walk the visible pairs.
+	DOUBLE VisibleTime = appSeconds();
+	INT NumVisible = 0;
+	INT NumReachable = 0;
+	for (i=0; i<NumCandidates; i++)
+	{
+		FPathCandidate &Candidate = Candidates(i);
+		if ( (RequestFor[i] != -1) && (Hits[RequestFor[i]].Time == 1.0) )
+		{
+			NumVisible++;
+			Candidate.Spec.Init();
+			Candidate.bReachable = Candidate.Spec.defineFor(Navs(Candidate.iNode), Candidate.End, Scout);
+			NumReachable += Candidate.bReachable;
+		}
+	}
+	DOUBLE ReachTime = appSeconds();
+	debugf
+	(
+		NAME_DevPath,
+		"Tested %d pairs: gather %f sec, place scout %f sec, %d visible in %f sec, %d reachable in %f sec",
+		NumCandidates,
+		GatherTime - StartTime,
+		PlaceTime - GatherTime,
+		NumVisible,
+		VisibleTime - PlaceTime,
+		NumReachable,
+		ReachTime - VisibleTime
+	);
+
+	// Compare with walking every pair.
+	if ( bCheck )
+	{
+		INT NumMismatched = 0;
+		for (i=0; i<NumCandidates; i++)
+		{
+			FPathCandidate &Candidate = Candidates(i);
+			FReachSpec Spec;
+			Spec.Init();
+			INT bReachable = Spec.defineFor(Navs(Candidate.iNode), Candidate.End, Scout);
+			if ( (bReachable != Candidate.bReachable) || (bReachable && !(Spec == Candidate.Spec)) )
+			{
+				debugf(NAME_DevPath, "Reachspec from %s to %s differs from the serial build", Navs(Candidate.iNode)->GetName(), Candidate.End->GetName());
+				NumMismatched++;
+			}
+		}
+		debugf(NAME_Log, "Serial reachability check: %d pairs walked in %f sec, %d differ", NumCandidates, appSeconds() - ReachTime, NumMismatched);
+	}
+	Mark.Pop();
+	unguard;
+}
+
 /* add reachspecs to path for every path reachable from it. Also add the reachspec to that
 paths upstreamPath list
 */
-void FPathBuilder::addReachSpecs(AActor *start)
+void FPathBuilder::addReachSpecs(AActor *start, FPathCandidate *Candidates, INT NumCandidates)
 {
 	guard(FPathBuilder::addReachspecs);
 
@@ -575,26 +759,22 @@ void FPathBuilder::addReachSpecs(AActor *start)
 		}
 	}
 
-	for (INT i=0; i<Level->Num(); i++)
+	for (INT i=0; i<NumCandidates; i++)
 	{
-		AActor *Actor = Level->Actors(i); 
-		if (Actor && Actor->IsA(ANavigationPoint::StaticClass) && !Actor->IsA(ALiftCenter::StaticClass) 
-				&& (Actor != node) && ((node->Location - Actor->Location).SizeSquared() < 1000000) )
+		AActor *Actor = Candidates[i].End; 
+		if (Candidates[i].bReachable)
 		{
-			newSpec.Init();
-			if (newSpec.defineFor(node, Actor, Scout))
+			newSpec = Candidates[i].Spec;
+			int pos = insertReachSpec(node->Paths, newSpec);
+			if (pos != -1)
 			{
-				int pos = insertReachSpec(node->Paths, newSpec);
+				int iSpec = Level->ReachSpecs.AddItem(newSpec);
+				//debugf("     Add reachspec %d to node at (%f, %f, %f)", iSpec, Actor->Location.X,Actor->Location.Y,Actor->Location.Z);
+				node->Paths[pos] = iSpec;
+				pos = insertReachSpec(((ANavigationPoint *)Actor)->upstreamPaths, newSpec);
 				if (pos != -1)
-				{
-					int iSpec = Level->ReachSpecs.AddItem(newSpec);
-					//debugf("     Add reachspec %d to node at (%f, %f, %f)", iSpec, Actor->Location.X,Actor->Location.Y,Actor->Location.Z);
-					node->Paths[pos] = iSpec;
-					pos = insertReachSpec(((ANavigationPoint *)Actor)->upstreamPaths, newSpec);
-					if (pos != -1)
-						((ANavigationPoint *)Actor)->upstreamPaths[pos] = iSpec;
-				} 
-			}
+					((ANavigationPoint *)Actor)->upstreamPaths[pos] = iSpec;
+			} 
 		}
 	}
 	unguard;
@@ -92,6 +92,17 @@ private:
 
 };
 
+//
+// A pair of navigation points definePaths tests for a reach spec.
+//
+struct FPathCandidate
+{
+	INT			iNode;			// Start node, in definePaths' node list.
+	AActor*		End;			// End node.
+	INT			bReachable;		// Whether Spec was defined.
+	FReachSpec	Spec;
+};
+
 class ENGINE_API FPathBuilder
 {
 public:
@@ -100,7 +111,7 @@ public:
 	int removePaths (ULevel *ownerLevel);
 	int showPaths (ULevel *ownerLevel);
 	int hidePaths (ULevel *ownerLevel);
-	void definePaths (ULevel *ownerLevel);
+	void definePaths (ULevel *ownerLevel, UBOOL bCheck=0);
 	void undefinePaths (ULevel *ownerLevel);
 
 private:
@@ -142,6 +153,122 @@ private:
 	int findPathTo(const FVector &Destination);
 	int angleNearThirty(FVector dir);
 	void nearestThirtyAngle (FVector &currentDirection);
-	void addReachSpecs(AActor * start);
+	void addReachSpecs(AActor * start, FPathCandidate *Candidates, INT NumCandidates);
+	void testReachability(TArray<ANavigationPoint*> &Navs, TArray<INT> &First, TArray<FPathCandidate> &Candidates, UBOOL bCheck);
 	int insertReachSpec(INT *SpecArray, FReachSpec &Spec);
 };
+
+//
+// A* route planner used by APawn::findPathToward and findPathTo in place
+// of breadthPathFrom.  Searches back from the destination anchor over a
+// compact copy of the level's upstream reach specs, toward the pawn, and
+// keeps the results of searches made from a path node anchor for the
+// rest of the frame, so pawns at the same anchor going to the same place
+// share one search.
+//
+struct FRouteEdge
+{
+	INT iStart;				// Node the spec starts from.
+	INT Distance;			// Spec distance.
+	INT CollisionRadius;	// Largest radius the spec supports.
+	INT CollisionHeight;	// Largest height the spec supports.
+	INT ReachFlags;			// Movement the spec needs.
+};
+struct FRouteKey
+{
+	AActor*	Anchor;			// Path node the pawn is at.
+	AActor*	Dest;			// Destination anchor.
+	INT		DestWeight;		// Distance from the destination anchor to the goal.
+	INT		MoveFlags;		// The pawn's movement flags.
+	INT		iRadius;		// The pawn's collision size.
+	INT		iHeight;
+	INT		bSinglePath;	// Whether the search was limited.
+};
+struct FRouteCacheEntry
+{
+	FRouteKey	Key;
+	AActor*		Result;		// Best path found, if any.
+	INT			bFound;		// Whether a path was found.
+};
+struct FRouteTable
+{
+	INT				MoveFlags;	// Pawns the table is for.
+	INT				iRadius;
+	INT				iHeight;
+	TArray<_WORD>	Next;		// First node after the start plus one, zero if no route.
+	TArray<INT>		Dist;		// Route distance.
+};
+enum {MAX_ROUTE_TABLE_NODES=512};	// Largest network given route tables.
+enum {MAX_ROUTE_TABLES=4};			// Most kinds of pawn given route tables.
+class ENGINE_API FRoutePlanner
+{
+public:
+	// Constructor.
+	FRoutePlanner( ULevel* InLevel );
+	~FRoutePlanner();
+
+	// FRoutePlanner interface.
+	UBOOL IsCurrent();
+	int FindPath( APawn* Pawn, ANavigationPoint* Start, FVector Target, AActor*& bestPath, int bSinglePath, int moveFlags );
+	UBOOL FindCachedRoute( const FRouteKey& Key, AActor*& bestPath, INT& bFound );
+	void CacheRoute( const FRouteKey& Key, AActor* bestPath, INT bFound );
+	FRouteTable* GetRouteTable( INT MoveFlags, INT iRadius, INT iHeight );
+	UBOOL FindTableRoute( FRouteTable* Table, AActor* Anchor, AActor* Dest, AActor*& Next );
+	INT NumRouteTables() {return NumTables;}
+	INT RouteTableBytes();
+
+	// Statistics since the last reset.
+	INT NumSearches, NumExpanded, NumCacheHits, NumCacheMisses;
+	INT NumTableRoutes, NumTableMisses;
+	DOUBLE TableBuildSeconds;
+
+private:
+	// An entry in the open list.
+	struct FRouteOpen
+	{
+		INT F;				// Weight so far plus the estimate to go.
+		INT iNode;			// The node.
+	};
+
+	// Graph, built once from the reach specs.
+	ULevel*						Level;
+	INT							NumSpecs;
+	ANavigationPoint*			FirstNav;
+	TArray<ANavigationPoint*>	Nodes;
+	TArray<INT>					FirstEdge;		// Nodes.Num()+1 offsets into Edges.
+	TArray<FRouteEdge>			Edges;			// Upstream specs, grouped by end node.
+	TArray<INT>					NodeOfObject;	// Node index plus one, by object index.
+	FLOAT						EstimateScale;	// Fraction of straight line distance no spec undercuts.
+
+	// Search state.
+	TArray<FRouteOpen>			Open;
+	INT							NumOpen;
+	TArray<DWORD>				Closed;
+	DWORD						SearchStamp;
+
+	// Routes found this frame.
+	TArray<FRouteCacheEntry>	Cache;
+	FLOAT						CacheTime;
+
+	// All-pairs routes, by kind of pawn.
+	FRouteTable*				Tables[MAX_ROUTE_TABLES];
+	INT							NumTables;
+
+	// Implementation.
+	INT GetNode( AActor* Actor )
+	{
+		DWORD Index = Actor->GetIndex();
+		return Index<(DWORD)NodeOfObject.Num() ? NodeOfObject(Index)-1 : INDEX_NONE;
+	}
+	INT Estimate( ANavigationPoint* Node, FVector Target )
+	{
+		// Scaled down and rounded down so that it never overestimates.
+		return ::Max( (INT)(EstimateScale * (Node->Location - Target).Size()) - 1, 0 );
+	}
+	void PushOpen( INT F, INT iNode );
+	FRouteOpen PopOpen();
+	void BuildRouteTable( FRouteTable* Table );
+};
+
+// Route planner benchmark.
+ENGINE_API void RoutePlannerBench( ULevel* Level, UClass* Class, INT Bots, INT Frames, INT Goals, DWORD Seed, FOutputDevice* Out );
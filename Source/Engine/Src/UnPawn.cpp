@@ -1326,37 +1326,64 @@ DWORD APawn::LineOfSightTo(AActor *Other, int bShowSelf)
 			return 0;
 	}
 
+	if ( (Other != Enemy) && (distSq > 1000000.f) ) 
+	{
+		if ( !bLOSflag && (distSq > 0.5 * maxdistSq) )
+			return 0;
+		if ( !bIsPlayer && (appFrand() < 0.5) )
+			return 0;
+	}
+
+	// Reuse the traces made lately from about here to about there, if they were the same ones
+	ULevel *MyLevel = GetLevel();
+	INT Variant = (Other == Enemy) + 2 * (distSq > 1000000.f) + 4 * (distSq > 250000.f) + 8 * (bShowSelf && bLOSflag);
+	INT Result = MyLevel->FindCachedSight(this, Other, Variant);
+	if ( Result == INDEX_NONE )
+	{
+		Result = traceSightTo(Other, distSq, bShowSelf);
+		MyLevel->CacheSight(this, Other, Variant, Result);
+	}
+	if ( Result == SIGHT_Enemy )
+	{
+		LastSeeingPos = Location;
+		LastSeenPos = Enemy->Location;
+	}
+	return ( Result != SIGHT_Hidden );
+	unguard;
+}
+
+/* traceSightTo()
+make the traces LineOfSightTo() has chosen, returning an ESightResult
+*/
+int APawn::traceSightTo(AActor *Other, FLOAT distSq, int bShowSelf)
+{
+	guard(APawn::traceSightTo);
+	ULevel *MyLevel = GetLevel();
 	FCheckResult Hit(1.0);
 	FVector ViewPoint = Location;
 	ViewPoint.Z += BaseEyeHeight; //look from eyes
 
 	if (Other == Enemy)
 	{
-		GetLevel()->SingleLineCheck(Hit, this, Other->Location, ViewPoint, TRACE_VisBlocking);  
+		MyLevel->NumSightTraces++;
+		MyLevel->TotalSightTraces++;
+		MyLevel->SingleLineCheck(Hit, this, Other->Location, ViewPoint, TRACE_VisBlocking);  
 		if ( Hit.Time == 1.0)
-		{
-			LastSeeingPos = Location;
-			LastSeenPos = Enemy->Location;
-			return 1;
-		}
-		GetLevel()->SingleLineCheck(Hit, this, Other->Location, Location, TRACE_VisBlocking);  
+			return SIGHT_Enemy;
+		MyLevel->NumSightTraces++;
+		MyLevel->TotalSightTraces++;
+		MyLevel->SingleLineCheck(Hit, this, Other->Location, Location, TRACE_VisBlocking);  
 		if ( Hit.Time == 1.0)
-		{
-			LastSeeingPos = Location;
-			LastSeenPos = Enemy->Location;
-			return 1;
-		}
+			return SIGHT_Enemy;
 		if ( distSq > 1000000.f)
-			return 0;
+			return SIGHT_Hidden;
 	}
 	else if ( distSq > 1000000.f ) 
 	{
-		if ( !bLOSflag && (distSq > 0.5 * maxdistSq) )
-			return 0;
-		if ( !bIsPlayer && (appFrand() < 0.5) )
-			return 0;
-		GetLevel()->SingleLineCheck(Hit, this, Other->Location, ViewPoint, TRACE_VisBlocking);  
-		return ( Hit.Time == 1.0);
+		MyLevel->NumSightTraces++;
+		MyLevel->TotalSightTraces++;
+		MyLevel->SingleLineCheck(Hit, this, Other->Location, ViewPoint, TRACE_VisBlocking);  
+		return ( Hit.Time == 1.0) ? SIGHT_Seen : SIGHT_Hidden;
 	}		
 	
 	//try viewpoint to head
@@ -1364,13 +1391,15 @@ DWORD APawn::LineOfSightTo(AActor *Other, int bShowSelf)
 	if ( !bShowSelf || !bLOSflag )
 	{
 		OtherBody.Z += Other->CollisionHeight * 0.8;
-		GetLevel()->SingleLineCheck(Hit, this, OtherBody, ViewPoint, TRACE_VisBlocking);  
+		MyLevel->NumSightTraces++;
+		MyLevel->TotalSightTraces++;
+		MyLevel->SingleLineCheck(Hit, this, OtherBody, ViewPoint, TRACE_VisBlocking);  
 		if ( Hit.Time == 1.0)
-			return 1;
+			return SIGHT_Seen;
 	}
 
 	if (distSq > 250000)
-		return 0;
+		return SIGHT_Hidden;
 
 	//try checking sides - look at dist to four side points, and cull furthest and closest
 	FVector Points[4];
@@ -1407,13 +1436,15 @@ DWORD APawn::LineOfSightTo(AActor *Other, int bShowSelf)
 			else
 			{
 				bSkip = 1;
-				GetLevel()->SingleLineCheck(Hit, this, Points[i], ViewPoint, TRACE_VisBlocking); 
+				MyLevel->NumSightTraces++;
+				MyLevel->TotalSightTraces++;
+				MyLevel->SingleLineCheck(Hit, this, Points[i], ViewPoint, TRACE_VisBlocking); 
 				if (Hit.Time == 1.0)
-					return 1;
+					return SIGHT_Seen;
 			}
 		}
 
-	return 0;
+	return SIGHT_Hidden;
 	unguard;
 }
 
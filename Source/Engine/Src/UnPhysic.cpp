@@ -8,6 +8,7 @@
 =============================================================================*/
 
 #include "EnginePrivate.h"
+#include "UnSIMD.h"
 
 void AActor::execMoveSmooth( FFrame& Stack, BYTE*& Result )
 {
@@ -98,6 +99,7 @@ void AActor::setPhysics(BYTE NewPhysics, AActor *NewFloor)
 
 	if (Physics == NewPhysics)
 		return;
+	Unpark();
 	Physics = NewPhysics;
 
 	if ((Physics == PHYS_Walking) || (Physics == PHYS_None) || (Physics == PHYS_Rolling) 
@@ -1541,6 +1543,184 @@ void AActor::physProjectile(FLOAT deltaTime, INT Iterations)
 	unguard;
 }
 
+/*-----------------------------------------------------------------------------
+	Batched projectile sweeps.
+-----------------------------------------------------------------------------*/
+
+//
+// Fewest projectiles worth batching.
+//
+#define MIN_PROJECTILE_BATCH 16
+
+//
+// Whether an actor in the tick list is going to run physProjectile this
+// tick and trace through the world.  Anything it misses, or gets wrong,
+// simply makes its own trace in MoveActor as before.
+//
+static inline UBOOL IsBatchedProjectile( AActor* Actor )
+{
+	return
+	(	Actor->Physics==PHYS_Projectile
+	&&	Actor->bCollideWorld
+	&&	!Actor->bDeleteMe
+	&&	!Actor->bIsPawn
+	&&	Actor->Role>=ROLE_SimulatedProxy
+	&&	Actor->RemoteRole!=ROLE_AutonomousProxy
+	&&	Actor->Region.ZoneNumber!=0
+	&&	!Actor->IsMovingBrush() );
+}
+
+//
+// Apply the first step of physProjectile's integration to Count projectiles,
+// four at a time: V = V*Friction + A*DeltaSeconds.  The operations are the
+// same, in the same order, as the scalar code, so the results match it.
+// The arrays are 16-byte aligned and padded to a multiple of four.
+//
+static void IntegrateProjectiles( INT Count, FLOAT DeltaSeconds, FLOAT** V, FLOAT** A, const FLOAT* Friction )
+{
+	guard(IntegrateProjectiles);
+	for( INT c=0; c<3; c++ )
+	{
+		FLOAT* Vel=V[c];
+		const FLOAT* Acc=A[c];
+#if ENGINE_SSE
+		__m128 T = _mm_set1_ps( DeltaSeconds );
+		for( INT i=0; i<Count; i+=4 )
+			_mm_store_ps( Vel+i, _mm_add_ps( _mm_mul_ps(_mm_load_ps(Vel+i),_mm_load_ps(Friction+i)), _mm_mul_ps(_mm_load_ps(Acc+i),T) ) );
+#elif ENGINE_NEON
+		float32x4_t T = vdupq_n_f32( DeltaSeconds );
+		for( INT i=0; i<Count; i+=4 )
+			vst1q_f32( Vel+i, vaddq_f32( vmulq_f32(vld1q_f32(Vel+i),vld1q_f32(Friction+i)), vmulq_f32(vld1q_f32(Acc+i),T) ) );
+#else
+		for( INT i=0; i<Count; i++ )
+			Vel[i] = Vel[i]*Friction[i] + Acc[i]*DeltaSeconds;
+#endif
+	}
+	unguard;
+}
+
+//
+// World traces of a batch, run on the job workers.
+//
+struct FProjectileSweepBatch
+{
+	UModel*				Model;
+	ALevelInfo*			LevelInfo;
+	FProjectileSweep*	Sweeps;
+};
+static void ProjectileSweepRange( void* Arg, INT Start, INT End )
+{
+	guard(ProjectileSweepRange);
+	FProjectileSweepBatch& Batch = *(FProjectileSweepBatch*)Arg;
+	for( INT i=Start; i<End; i++ )
+	{
+		FProjectileSweep& Sweep = Batch.Sweeps[i];
+		Sweep.WorldHit  = FCheckResult(1.0);
+		Sweep.bHitWorld = Batch.Model->LineCheck( Sweep.WorldHit, NULL, Sweep.End, Sweep.Start, Sweep.Extent, 0 )==0;
+		if( Sweep.bHitWorld )
+			Sweep.WorldHit.Actor = Batch.LevelInfo;
+	}
+	unguard;
+}
+
+//
+// Sort sweeps by actor, so MoveActor can binary search them.
+//
+static int CDECL CompareProjectileSweeps( const void* A, const void* B )
+{
+	AActor* ActorA = ((FProjectileSweep*)A)->Actor;
+	AActor* ActorB = ((FProjectileSweep*)B)->Actor;
+	return ActorA<ActorB ? -1 : ActorA>ActorB ? 1 : 0;
+}
+
+//
+// Before the actors are ticked, predict the first move each projectile's
+// physics will make this tick and trace them all through the world at
+// once, on the job workers.  The sweeps are allocated on GMem and are
+// dropped by ULevel::Tick once the actors have been ticked.
+//
+// MoveActor only uses a sweep if its trace is exactly the one predicted,
+// so a projectile whose script changes its velocity or location first, or
+// which bounces, just traces for itself.  Actor collision, and everything
+// which follows a hit, is still handled one projectile at a time.
+//
+void ULevel::BatchProjectileSweeps( FLOAT DeltaSeconds )
+{
+	guard(ULevel::BatchProjectileSweeps);
+	profileZone("ULevel::BatchProjectileSweeps");
+	ProjectileSweeps    = NULL;
+	NumProjectileSweeps = 0;
+	if( bNoProjectileBatch || GIsEditor )
+		return;
+
+	// Gather the projectiles.
+	if( TickList.Num()<MIN_PROJECTILE_BATCH )
+		return;
+	AActor** Projectiles = new(GMem,TickList.Num())AActor*;
+	INT Count = 0;
+	for( INT i=0; i<TickList.Num(); i++ )
+		if( TickList(i) && IsBatchedProjectile(TickList(i)) )
+			Projectiles[Count++] = TickList(i);
+	if( Count<MIN_PROJECTILE_BATCH )
+		return;
+
+	// Lay their motion out as arrays and integrate it.
+	INT    Padded   = (Count+3) & ~3;
+	FLOAT* Friction = new(GMem,MEM_Zeroed,Padded,16)FLOAT;
+	FLOAT* V[3];
+	FLOAT* A[3];
+	for( INT c=0; c<3; c++ )
+	{
+		V[c] = new(GMem,MEM_Zeroed,Padded,16)FLOAT;
+		A[c] = new(GMem,MEM_Zeroed,Padded,16)FLOAT;
+	}
+	for( INT i=0; i<Count; i++ )
+	{
+		AActor* Actor = Projectiles[i];
+		V[0][i]     = Actor->Velocity.X;
+		V[1][i]     = Actor->Velocity.Y;
+		V[2][i]     = Actor->Velocity.Z;
+		A[0][i]     = Actor->Acceleration.X;
+		A[1][i]     = Actor->Acceleration.Y;
+		A[2][i]     = Actor->Acceleration.Z;
+		Friction[i] = Actor->Region.Zone->bWaterZone ? (FLOAT)(1 - 0.2 * Actor->Region.Zone->ZoneFluidFriction * DeltaSeconds) : 1.f;
+	}
+	IntegrateProjectiles( Padded, DeltaSeconds, V, A, Friction );
+
+	// Finish each move as physProjectile and MoveActor would, to get the trace.
+	ProjectileSweeps = new(GMem,Count)FProjectileSweep;
+	for( INT i=0; i<Count; i++ )
+	{
+		AActor* Actor = Projectiles[i];
+		FVector Velocity( V[0][i], V[1][i], V[2][i] );
+		if( Actor->IsA(AProjectile::StaticClass) && (Velocity.SizeSquared() > ((AProjectile*)Actor)->MaxSpeed * ((AProjectile*)Actor)->MaxSpeed) )
+		{
+			Velocity = Velocity.SafeNormal();
+			Velocity *= ((AProjectile*)Actor)->MaxSpeed;
+		}
+		FVector Delta = Velocity * DeltaSeconds;
+		if( Delta==FVector(0,0,0) )
+			continue;
+		FVector DeltaDir   = Delta.IsNearlyZero() ? Delta : Delta/Delta.Size();
+		FLOAT   TestAdjust = 2.0;
+		FProjectileSweep& Sweep = ProjectileSweeps[NumProjectileSweeps++];
+		Sweep.Actor  = Actor;
+		Sweep.Start  = Actor->Location;
+		Sweep.End    = Actor->Location + (Delta + TestAdjust * DeltaDir);
+		Sweep.Extent = Actor->GetCylinderExtent();
+	}
+
+	// Trace them all through the world, and sort them for lookup.
+	FProjectileSweepBatch Batch;
+	Batch.Model     = Model;
+	Batch.LevelInfo = GetLevelInfo();
+	Batch.Sweeps    = ProjectileSweeps;
+	GJobs.ParallelFor( NumProjectileSweeps, ProjectileSweepRange, &Batch, 16 );
+	appQsort( ProjectileSweeps, NumProjectileSweeps, sizeof(FProjectileSweep), CompareProjectileSweeps );
+	NumSweepsBatched += NumProjectileSweeps;
+	unguard;
+}
+
 /*
 physRolling() - intended for non-pawns which are rolling or sliding along a floor
 
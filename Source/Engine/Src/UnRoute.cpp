@@ -158,6 +158,19 @@ int FSortedPathList::checkAnchorPath(APawn *Searcher, FVector Dest)
 	unguard;
 }
 
+/* anchorPathBlocked()
+whether a mover the searcher can't open stands between its anchor Start and End
+*/
+static int anchorPathBlocked(APawn *Searcher, AActor *Start, AActor *End)
+{
+	guard(anchorPathBlocked);
+	FCheckResult Hit;
+	Searcher->GetLevel()->SingleLineCheck(Hit, Searcher, End->Location, Start->Location, TRACE_VisBlocking);
+	return ( Hit.Actor && Hit.Actor->IsA(AMover::StaticClass) 
+		&& !(Searcher->bCanOpenDoors && (Searcher->bIsPlayer || !((AMover *)Hit.Actor)->bPlayerOnly)) );
+	unguard;
+}
+
 void FSortedPathList::expandAnchor(APawn *Searcher) 
 {
 	guard(FSortedPathList::expandAnchor);
@@ -167,7 +180,6 @@ void FSortedPathList::expandAnchor(APawn *Searcher)
 	anchor->cost = 1000000.f; //paths shouldn't go through anchor
 	INT j = 0;
 	FReachSpec *spec;
-	FCheckResult Hit;
 	INT moveFlags = Searcher->calcMoveFlags(); 
 	INT iRadius = (int)(Searcher->CollisionRadius);
 	INT iHeight = (int)(Searcher->CollisionHeight);
@@ -181,9 +193,7 @@ void FSortedPathList::expandAnchor(APawn *Searcher)
 			//debugf("Expand to %s",spec->End->GetName()); 
 			if ( spec->supports(iRadius, iHeight, moveFlags) )
 			{
-				MyLevel->SingleLineCheck(Hit, Searcher, spec->End->Location, spec->Start->Location, TRACE_VisBlocking);
-				if ( !Hit.Actor || !Hit.Actor->IsA(AMover::StaticClass) 
-					|| (Searcher->bCanOpenDoors && (Searcher->bIsPlayer || !((AMover *)Hit.Actor)->bPlayerOnly)) )
+				if ( !anchorPathBlocked(Searcher, spec->Start, spec->End) )
 				{
 					//debugf("Expansion to %s successful",spec->End->GetName()); 
 					((ANavigationPoint *)spec->End)->bEndPoint = 1;
@@ -289,6 +299,61 @@ void FSortedPathList::findAltEndPoint(APawn *Searcher, AActor *&bestPath)
 	unguard;
 }
 
+/* findRoute()
+Search back from the destination anchor DestPoints.Path[0] for the best
+endpoint to head for, with the level's route planner if it has one.
+Origin is where the endpoint weights were measured from: the pawn's anchor
+if it has one, otherwise its real location.
+If bCacheRoute, the pawn is at the path node EndPoints.Path[0] with fresh
+path state and its anchor hasn't been expanded yet; pawns in that position
+going to the same place in the same frame share one search.
+*/
+static int findRoute(APawn *Searcher, FSortedPathList &EndPoints, FSortedPathList &DestPoints, AActor *&bestPath, int bSinglePath, FVector Origin, int bCacheRoute)
+{
+	guard(findRoute);
+	FRoutePlanner *Planner = Searcher->GetLevel()->GetRoutePlanner();
+	int moveFlags = Searcher->calcMoveFlags();
+	FRouteKey Key;
+	if ( bCacheRoute )
+	{
+		Key.Anchor      = EndPoints.Path[0];
+		Key.Dest        = DestPoints.Path[0];
+		Key.DestWeight  = DestPoints.Dist[0];
+		Key.MoveFlags   = moveFlags;
+		Key.iRadius     = (int)Searcher->CollisionRadius;
+		Key.iHeight     = (int)Searcher->CollisionHeight;
+		Key.bSinglePath = bSinglePath;
+		INT bFound;
+		if ( Planner->FindCachedRoute(Key, bestPath, bFound) )
+			return bFound;
+
+		// On small networks, look the first step up in a route table.
+		FRouteTable *Table = bSinglePath ? NULL : Planner->GetRouteTable(moveFlags, Key.iRadius, Key.iHeight);
+		AActor *Next;
+		if ( Table && Planner->FindTableRoute(Table, Key.Anchor, Key.Dest, Next) )
+		{
+			if ( !Next || !anchorPathBlocked(Searcher, Key.Anchor, Next) )
+			{
+				Planner->NumTableRoutes++;
+				Planner->CacheRoute(Key, Next, Next != NULL);
+				bestPath = Next;
+				return ( Next != NULL );
+			}
+			Planner->NumTableMisses++; //a mover is in the way, so search without it
+		}
+		EndPoints.expandAnchor(Searcher);
+	}
+
+	((ANavigationPoint *)DestPoints.Path[0])->visitedWeight = DestPoints.Dist[0];
+	int result = Planner
+		? Planner->FindPath(Searcher, (ANavigationPoint *)DestPoints.Path[0], Origin, bestPath, bSinglePath, moveFlags)
+		: Searcher->breadthPathFrom(DestPoints.Path[0], bestPath, bSinglePath, moveFlags);
+	if ( bCacheRoute )
+		Planner->CacheRoute(Key, result ? bestPath : NULL, result);
+	return result;
+	unguard;
+}
+
 int APawn::findPathToward(AActor *goal, INT bSinglePath, AActor *&bestPath, INT bClearPaths)
 {
 	guard(APawn::findPathToward);
@@ -324,6 +389,7 @@ int APawn::findPathToward(AActor *goal, INT bSinglePath, AActor *&bestPath, INT
 	DestPoints.numPoints = 0; 
 	INT startanchor = 0;
 	INT endanchor = 0;
+	INT bCacheRoute = 0;
 
 	if ( goal->IsA(ANavigationPoint::StaticClass) )
 	{
@@ -359,6 +425,8 @@ int APawn::findPathToward(AActor *goal, INT bSinglePath, AActor *&bestPath, INT
 			//debugf("anchor works");
 			return 1;
 		}
+		else if ( bClearPaths && GetLevel()->GetRoutePlanner() )
+			bCacheRoute = 1; //findRoute expands the anchor unless the route is cached
 		else
 			EndPoints.expandAnchor(this);
 	}
@@ -396,9 +464,7 @@ int APawn::findPathToward(AActor *goal, INT bSinglePath, AActor *&bestPath, INT
 	if ( endanchor )
 	{
 		AActor *newPath = NULL;
-		int moveFlags = calcMoveFlags();
-		((ANavigationPoint *)DestPoints.Path[0])->visitedWeight = DestPoints.Dist[0];
-		if (breadthPathFrom(DestPoints.Path[0], newPath, bSinglePath, moveFlags))
+		if (findRoute(this, EndPoints, DestPoints, newPath, bSinglePath, startanchor ? EndPoints.Path[0]->Location : RealLocation, bCacheRoute))
 		{
 			bestPath = newPath;
 			GetLevel()->FarMoveActor(this, RealLocation, 1, 1);
@@ -507,6 +573,7 @@ int APawn::findPathTo(FVector Dest, INT bSinglePath, AActor *&bestPath, INT bCle
 	DestPoints.numPoints = 0; //FIXME - this should be done by FSortedPathList when constructed
 	INT startanchor = 0;
 	INT endanchor = 0;
+	INT bCacheRoute = 0;
 
 	EndPoints.FindVisiblePaths(this, Dest, &DestPoints, bClearPaths, startanchor, endanchor);
 	//debugf("Visible endpoints = %d", EndPoints.numPoints);
@@ -527,6 +594,8 @@ int APawn::findPathTo(FVector Dest, INT bSinglePath, AActor *&bestPath, INT bCle
 			GetLevel()->FarMoveActor(this, RealLocation, 1, 1);
 			return 1;
 		}
+		else if ( bClearPaths && GetLevel()->GetRoutePlanner() )
+			bCacheRoute = 1; //findRoute expands the anchor unless the route is cached
 		else
 			EndPoints.expandAnchor(this);
 	}
@@ -561,9 +630,7 @@ int APawn::findPathTo(FVector Dest, INT bSinglePath, AActor *&bestPath, INT bCle
 	if (endanchor)
 	{
 		AActor *newPath = NULL;
-		int moveFlags = calcMoveFlags(); 
-		((ANavigationPoint *)DestPoints.Path[0])->visitedWeight = DestPoints.Dist[0];
-		if (breadthPathFrom(DestPoints.Path[0], newPath, bSinglePath, moveFlags))
+		if (findRoute(this, EndPoints, DestPoints, newPath, bSinglePath, startanchor ? EndPoints.Path[0]->Location : RealLocation, bCacheRoute))
 		{
 			//uunclock(XLevel->FindPathCycles);
 			//debugf("BFS time was %f", XLevel->FindPathCycles * GSystem->MSecPerCycle);
@@ -1010,3 +1077,516 @@ FLOAT APawn::breadthPathToInventory(AActor *start, AActor *&bestPath, int moveFl
 	
 	unguard;
 }
+
+/*-----------------------------------------------------------------------------
+	FRoutePlanner.
+-----------------------------------------------------------------------------*/
+
+//
+// Build the planner's graph from the level's navigation points and the
+// upstream reach specs of each.
+//
+FRoutePlanner::FRoutePlanner( ULevel* InLevel )
+:	NumSearches		( 0 )
+,	NumExpanded		( 0 )
+,	NumCacheHits	( 0 )
+,	NumCacheMisses	( 0 )
+,	NumTableRoutes	( 0 )
+,	NumTableMisses	( 0 )
+,	TableBuildSeconds( 0.0 )
+,	Level			( InLevel )
+,	NumSpecs		( InLevel->ReachSpecs.Num() )
+,	FirstNav		( InLevel->GetLevelInfo()->NavigationPointList )
+,	NumOpen			( 0 )
+,	SearchStamp		( 0 )
+,	CacheTime		( -1.0 )
+,	NumTables		( 0 )
+{
+	guard(FRoutePlanner::FRoutePlanner);
+
+	// Number the nodes.
+	for( ANavigationPoint* Nav=FirstNav; Nav; Nav=Nav->nextNavigationPoint )
+	{
+		DWORD Index = Nav->GetIndex();
+		if( Index>=(DWORD)NodeOfObject.Num() )
+			NodeOfObject.AddZeroed( Index+1-NodeOfObject.Num() );
+		NodeOfObject(Index) = Nodes.AddItem( Nav ) + 1;
+	}
+
+	// Gather each node's upstream specs, and find how far below the straight
+	// line distance between their ends their weights go.  Spec distances
+	// are truncated, and teleporters and lifts have short fixed ones.
+	EstimateScale = 1.f;
+	for( INT i=0; i<Nodes.Num(); i++ )
+	{
+		FirstEdge.AddItem( Edges.Num() );
+		for( INT j=0; j<16 && Nodes(i)->upstreamPaths[j]!=-1; j++ )
+		{
+			FReachSpec& Spec = Level->ReachSpecs(Nodes(i)->upstreamPaths[j]);
+			INT iStart = Spec.Start ? GetNode( Spec.Start ) : INDEX_NONE;
+			if( iStart!=INDEX_NONE )
+			{
+				FRouteEdge* Edge      = new(Edges)FRouteEdge;
+				Edge->iStart          = iStart;
+				Edge->Distance        = Spec.distance;
+				Edge->CollisionRadius = Spec.CollisionRadius;
+				Edge->CollisionHeight = Spec.CollisionHeight;
+				Edge->ReachFlags      = Spec.reachFlags;
+				FLOAT Length = (Nodes(i)->Location - Spec.Start->Location).Size();
+				if( Length>1.f )
+					EstimateScale = ::Min( EstimateScale, ::Max( (FLOAT)Spec.distance, 0.f ) / Length );
+			}
+		}
+	}
+	FirstEdge.AddItem( Edges.Num() );
+	Closed.AddZeroed( Nodes.Num() );
+	debugf( NAME_DevPath, "Route planner: %i nodes, %i specs, estimate scale %f", Nodes.Num(), Edges.Num(), EstimateScale );
+
+	unguard;
+}
+
+//
+// Free the route tables.
+//
+FRoutePlanner::~FRoutePlanner()
+{
+	guard(FRoutePlanner::~FRoutePlanner);
+	for( INT i=0; i<NumTables; i++ )
+		delete Tables[i];
+	unguard;
+}
+
+//
+// Whether the graph still matches the level's paths.
+//
+UBOOL FRoutePlanner::IsCurrent()
+{
+	return NumSpecs==Level->ReachSpecs.Num() && FirstNav==Level->GetLevelInfo()->NavigationPointList;
+}
+
+//
+// Open list, a binary heap on F.
+//
+void FRoutePlanner::PushOpen( INT F, INT iNode )
+{
+	if( NumOpen==Open.Num() )
+		Open.Add();
+	INT i = NumOpen++;
+	while( i>0 && Open((i-1)/2).F > F )
+	{
+		Open(i) = Open((i-1)/2);
+		i       = (i-1)/2;
+	}
+	Open(i).F     = F;
+	Open(i).iNode = iNode;
+}
+FRoutePlanner::FRouteOpen FRoutePlanner::PopOpen()
+{
+	FRouteOpen Top  = Open(0);
+	FRouteOpen Last = Open(--NumOpen);
+	INT        Num  = NumOpen;
+	if( Num>0 )
+	{
+		INT i = 0;
+		for( ;; )
+		{
+			INT Child = 2*i+1;
+			if( Child>=Num )
+				break;
+			if( Child+1<Num && Open(Child+1).F < Open(Child).F )
+				Child++;
+			if( Open(Child).F >= Last.F )
+				break;
+			Open(i) = Open(Child);
+			i       = Child;
+		}
+		Open(i) = Last;
+	}
+	return Top;
+}
+
+//
+// Search back from Start, the destination anchor, for the endpoint the pawn
+// should head for, as breadthPathFrom does.  Nodes are weighted the same
+// way, in the same visitedWeight, bEndPoint, bestPathWeight and cost
+// variables, but are expanded best first by their weight plus an estimate
+// of the distance to Target, the point the endpoints' weights were measured
+// from: the pawn's anchor if it has one, otherwise its real location.  The
+// estimate is the straight line distance, scaled and rounded down so that
+// no spec or endpoint leg can beat it.  Endpoints already carry their last
+// leg, so they estimate zero.
+//
+int FRoutePlanner::FindPath( APawn* Pawn, ANavigationPoint* Start, FVector Target, AActor*& bestPath, int bSinglePath, int moveFlags )
+{
+	guard(FRoutePlanner::FindPath);
+	INT iFirst = GetNode( Start );
+	if( iFirst==INDEX_NONE )
+		return 0;
+
+	NumSearches++;
+	if( ++SearchStamp==0 )
+	{
+		for( INT i=0; i<Closed.Num(); i++ )
+			Closed(i) = 0;
+		SearchStamp = 1;
+	}
+	INT iRadius = (int)Pawn->CollisionRadius;
+	INT iHeight = (int)Pawn->CollisionHeight;
+	INT n = 0;
+	NumOpen = 0;
+	PushOpen( Start->visitedWeight + (Start->bEndPoint ? 0 : Estimate( Start, Target )), iFirst );
+	while( NumOpen )
+	{
+		FRouteOpen Best = PopOpen();
+		if( Closed(Best.iNode)==SearchStamp )
+			continue;
+		Closed(Best.iNode) = SearchStamp;
+		ANavigationPoint* currentnode = Nodes(Best.iNode);
+		if ( currentnode->bEndPoint )
+		{
+			bestPath = currentnode;
+			return 1;
+		}
+		if ( (!currentnode->bPlayerOnly || Pawn->bIsPlayer) || (currentnode == Start) )
+		{
+			for( INT i=FirstEdge(Best.iNode); i<FirstEdge(Best.iNode+1); i++ )
+			{
+				FRouteEdge& Edge = Edges(i);
+				if
+				(	Edge.CollisionRadius >= iRadius
+				&&	Edge.CollisionHeight >= iHeight
+				&&	(Edge.ReachFlags & moveFlags) == Edge.ReachFlags
+				&&	Closed(Edge.iStart) != SearchStamp )
+				{
+					ANavigationPoint* startnode = Nodes(Edge.iStart);
+					int newVisit = Edge.Distance + startnode->cost + currentnode->visitedWeight + startnode->bEndPoint * startnode->bestPathWeight;
+					if ( startnode->visitedWeight > newVisit )
+					{
+						startnode->visitedWeight = newVisit;
+						PushOpen( newVisit + (startnode->bEndPoint ? 0 : Estimate( startnode, Target )), Edge.iStart );
+					}
+				}
+			}
+		}
+		NumExpanded++;
+		n++;
+		if ( bSinglePath && ( n > 4) )
+			return 0;
+		if ( n > 1000 )
+			return 0;
+	}
+	return 0;
+	unguard;
+}
+
+//
+// Look up a route found earlier this frame.
+//
+UBOOL FRoutePlanner::FindCachedRoute( const FRouteKey& Key, AActor*& bestPath, INT& bFound )
+{
+	guard(FRoutePlanner::FindCachedRoute);
+	if( CacheTime!=Level->TimeSeconds )
+	{
+		Cache.Empty();
+		CacheTime = Level->TimeSeconds;
+	}
+	for( INT i=0; i<Cache.Num(); i++ )
+	{
+		FRouteKey& Test = Cache(i).Key;
+		if
+		(	Test.Anchor==Key.Anchor
+		&&	Test.Dest==Key.Dest
+		&&	Test.DestWeight==Key.DestWeight
+		&&	Test.MoveFlags==Key.MoveFlags
+		&&	Test.iRadius==Key.iRadius
+		&&	Test.iHeight==Key.iHeight
+		&&	Test.bSinglePath==Key.bSinglePath )
+		{
+			bestPath = Cache(i).Result;
+			bFound   = Cache(i).bFound;
+			NumCacheHits++;
+			return 1;
+		}
+	}
+	NumCacheMisses++;
+	return 0;
+	unguard;
+}
+
+//
+// Remember a route for the rest of the frame.
+//
+void FRoutePlanner::CacheRoute( const FRouteKey& Key, AActor* bestPath, INT bFound )
+{
+	guard(FRoutePlanner::CacheRoute);
+	FRouteCacheEntry* Entry = new(Cache)FRouteCacheEntry;
+	Entry->Key    = Key;
+	Entry->Result = bestPath;
+	Entry->bFound = bFound;
+	unguard;
+}
+
+//
+// Return the route table for pawns with the given movement flags and
+// collision size, building it the first time it's asked for, or NULL if
+// the network is too big to tabulate or too many kinds of pawn have asked.
+//
+FRouteTable* FRoutePlanner::GetRouteTable( INT MoveFlags, INT iRadius, INT iHeight )
+{
+	guard(FRoutePlanner::GetRouteTable);
+	if( Level->bNoRouteTable || Nodes.Num()>MAX_ROUTE_TABLE_NODES )
+		return NULL;
+	for( INT i=0; i<NumTables; i++ )
+		if( Tables[i]->MoveFlags==MoveFlags && Tables[i]->iRadius==iRadius && Tables[i]->iHeight==iHeight )
+			return Tables[i];
+	if( NumTables==MAX_ROUTE_TABLES )
+		return NULL;
+	FRouteTable* Table = Tables[NumTables++] = new FRouteTable;
+	Table->MoveFlags   = MoveFlags;
+	Table->iRadius     = iRadius;
+	Table->iHeight     = iHeight;
+	BuildRouteTable( Table );
+	return Table;
+	unguard;
+}
+
+//
+// Fill in a route table with one search back from each destination,
+// weighing nodes as breadthPathFrom does for a pawn with fresh path state.
+// A route may end at a player-only node but only players' routes pass
+// through one.  The first step from each node is the one which, added to
+// the distance on from where it leads, is shortest; that's the endpoint
+// breadthPathFrom finds for a pawn at the node once its anchor is expanded.
+//
+void FRoutePlanner::BuildRouteTable( FRouteTable* Table )
+{
+	guard(FRoutePlanner::BuildRouteTable);
+	DOUBLE StartTime = appSeconds();
+	INT    Num       = Nodes.Num();
+	Table->Next.AddZeroed( Num*Num );
+	Table->Dist.Add( Num*Num );
+
+	TArray<INT> Weight;
+	Weight.Add( Num );
+	for( INT iDest=0; iDest<Num; iDest++ )
+	{
+		_WORD* Next = &Table->Next(iDest*Num);
+		INT*   Dist = &Table->Dist(iDest*Num);
+		for( INT i=0; i<Num; i++ )
+			Weight(i) = Dist[i] = MAXINT;
+		Weight(iDest) = Dist[iDest] = 0;
+
+		if( ++SearchStamp==0 )
+		{
+			for( INT i=0; i<Closed.Num(); i++ )
+				Closed(i) = 0;
+			SearchStamp = 1;
+		}
+		NumOpen = 0;
+		PushOpen( 0, iDest );
+		while( NumOpen )
+		{
+			FRouteOpen Best = PopOpen();
+			if( Closed(Best.iNode)==SearchStamp )
+				continue;
+			Closed(Best.iNode) = SearchStamp;
+			UBOOL bPassable = !Nodes(Best.iNode)->bPlayerOnly || (Table->MoveFlags & R_PLAYERONLY) || Best.iNode==iDest;
+			for( INT i=FirstEdge(Best.iNode); i<FirstEdge(Best.iNode+1); i++ )
+			{
+				FRouteEdge& Edge = Edges(i);
+				if
+				(	Edge.CollisionRadius >= Table->iRadius
+				&&	Edge.CollisionHeight >= Table->iHeight
+				&&	(Edge.ReachFlags & Table->MoveFlags) == Edge.ReachFlags )
+				{
+					INT Via = Edge.Distance + Weight(Best.iNode);
+					if( Via < Dist[Edge.iStart] )
+					{
+						Dist[Edge.iStart] = Via;
+						Next[Edge.iStart] = Best.iNode + 1;
+					}
+					if( bPassable && Via < Weight(Edge.iStart) && Closed(Edge.iStart)!=SearchStamp )
+					{
+						Weight(Edge.iStart) = Via;
+						PushOpen( Via, Edge.iStart );
+					}
+				}
+			}
+		}
+	}
+	DOUBLE Seconds = appSeconds() - StartTime;
+	TableBuildSeconds += Seconds;
+	debugf( NAME_DevPath, "Route table for flags %i, size %i x %i: %i nodes, %iK, %.1f msec", Table->MoveFlags, Table->iRadius, Table->iHeight, Num, Num*Num*(sizeof(_WORD)+sizeof(INT))/1024, Seconds*1000.0 );
+	unguard;
+}
+
+//
+// Look up the first step from Anchor toward Dest.  Returns whether the
+// table knows, with Next set to the step or NULL if there's no route.
+//
+UBOOL FRoutePlanner::FindTableRoute( FRouteTable* Table, AActor* Anchor, AActor* Dest, AActor*& Next )
+{
+	guard(FRoutePlanner::FindTableRoute);
+	INT iAnchor = GetNode( Anchor );
+	INT iDest   = GetNode( Dest );
+	if( iAnchor==INDEX_NONE || iDest==INDEX_NONE || iAnchor==iDest )
+		return 0;
+	INT iNext = Table->Next(iDest*Nodes.Num()+iAnchor);
+	Next = iNext ? Nodes(iNext-1) : NULL;
+	return 1;
+	unguard;
+}
+
+//
+// Memory used by the route tables.
+//
+INT FRoutePlanner::RouteTableBytes()
+{
+	return NumTables * Nodes.Num() * Nodes.Num() * (sizeof(_WORD)+sizeof(INT));
+}
+
+//
+// Return the level's route planner, building it the first time it's needed
+// and again whenever the paths change, or NULL if breadthPathFrom should be
+// used.
+//
+FRoutePlanner* ULevel::GetRoutePlanner()
+{
+	guard(ULevel::GetRoutePlanner);
+	if( bNoRoutePlanner || GIsEditor || !GetLevelInfo()->NavigationPointList )
+		return NULL;
+	if( RoutePlanner && !RoutePlanner->IsCurrent() )
+	{
+		delete RoutePlanner;
+		RoutePlanner = NULL;
+	}
+	if( !RoutePlanner )
+		RoutePlanner = new FRoutePlanner( this );
+	return RoutePlanner;
+	unguard;
+}
+
+/*-----------------------------------------------------------------------------
+	Route planner benchmark.
+-----------------------------------------------------------------------------*/
+
+//
+// Time findPathToward for a crowd of bots standing at path nodes, heading
+// for a few shared goals: with breadthPathFrom, with the route planner,
+// and with the route planner and its per-frame cache.  One pawn stands in
+// for every bot, moving to each bot's node before it asks for a path, so
+// every search is made from an anchor.  The first step each bot is given
+// in the first frame is checked against the one breadthPathFrom gives.
+//
+void RoutePlannerBench( ULevel* Level, UClass* Class, INT Bots, INT Frames, INT Goals, DWORD Seed, FOutputDevice* Out )
+{
+	guard(RoutePlannerBench);
+
+	// Gather the path nodes.
+	TArray<ANavigationPoint*> Navs;
+	for( ANavigationPoint* Nav=Level->GetLevelInfo()->NavigationPointList; Nav; Nav=Nav->nextNavigationPoint )
+		Navs.AddItem( Nav );
+	if( Navs.Num()<2 || !Level->ReachSpecs.Num() )
+	{
+		Out->Log( "PATHBENCH: level has no paths" );
+		return;
+	}
+	APawn* Pawn = (APawn*)Level->SpawnActor( Class, NAME_None, NULL, NULL, Navs(0)->Location, FRotator(0,0,0), NULL, 1, 1 );
+	if( !Pawn )
+	{
+		Out->Logf( "PATHBENCH: couldn't spawn a %s", Class->GetName() );
+		return;
+	}
+
+	// Place the bots, two to a node, and give each a goal.
+	TArray<ANavigationPoint*> Starts, Ends;
+	for( INT i=0; i<Bots; i++ )
+	{
+		Seed = Seed * 196314165 + 907633515;
+		Starts.AddItem( (i&1) ? Starts(i-1) : Navs( (Seed>>8) % Navs.Num() ) );
+		Seed = Seed * 196314165 + 907633515;
+		Ends.AddItem( Navs( ((Seed>>8) % ::Max(Goals,1) * 7919) % Navs.Num() ) );
+	}
+
+	// Run each pass.
+	static const char* PassNames[4] = {"breadth","A*","A* cached","table"};
+	UBOOL  OldNoPlanner = Level->bNoRoutePlanner;
+	UBOOL  OldNoTable   = Level->bNoRouteTable;
+	FLOAT  OldTime      = Level->TimeSeconds;
+	DOUBLE Seconds[4], BuildSeconds=0.0;
+	INT    Found[4], Expanded[4], Hits[4], Tabled[4], Mismatched[4];
+	TArray<AActor*> FirstSteps;
+	for( INT Pass=0; Pass<4; Pass++ )
+	{
+		Level->bNoRoutePlanner = (Pass==0);
+		Level->bNoRouteTable   = (Pass!=3);
+		FRoutePlanner* Planner = Level->GetRoutePlanner();
+
+		// Build anything the pass needs before timing it.
+		AActor* Path = NULL;
+		Level->FarMoveActor( Pawn, Starts(0)->Location, 0, 1 );
+		Pawn->MoveTarget = Starts(0);
+		Pawn->findPathToward( Ends(0), 0, Path, 1 );
+		if( Planner )
+		{
+			BuildSeconds = Planner->TableBuildSeconds;
+			Planner->NumExpanded = Planner->NumCacheHits = Planner->NumTableRoutes = 0;
+		}
+
+		Found[Pass] = Mismatched[Pass] = 0;
+		DOUBLE StartTime = appSeconds();
+		for( INT Frame=0; Frame<Frames; Frame++ )
+		{
+			Level->TimeSeconds += 0.02f;
+			for( INT i=0; i<Bots; i++ )
+			{
+				// Without the cache, every search is in a frame of its own.
+				if( Pass!=2 )
+					Level->TimeSeconds += 0.0001f;
+				Level->FarMoveActor( Pawn, Starts(i)->Location, 0, 1 );
+				Pawn->MoveTarget = Starts(i);
+				Path = NULL;
+				if( Pawn->findPathToward( Ends(i), 0, Path, 1 ) )
+					Found[Pass]++;
+				if( Frame==0 && Pass==0 )
+					FirstSteps.AddItem( Path );
+				else if( Frame==0 && Path!=FirstSteps(i) )
+					Mismatched[Pass]++;
+			}
+		}
+		Seconds [Pass] = appSeconds() - StartTime;
+		Expanded[Pass] = Planner ? Planner->NumExpanded    : 0;
+		Hits    [Pass] = Planner ? Planner->NumCacheHits   : 0;
+		Tabled  [Pass] = Planner ? Planner->NumTableRoutes : 0;
+	}
+	FRoutePlanner* Planner = Level->GetRoutePlanner();
+	INT TableBytes = Planner ? Planner->RouteTableBytes() : 0;
+	Level->bNoRoutePlanner = OldNoPlanner;
+	Level->bNoRouteTable   = OldNoTable;
+	Level->TimeSeconds     = OldTime;
+	Level->DestroyActor( Pawn );
+
+	// Report.
+	INT Searches = Bots * Frames;
+	Out->Logf( "PATHBENCH %s: %i nodes, %i bots, %i goals, %i frames", Class->GetName(), Navs.Num(), Bots, Goals, Frames );
+	for( INT Pass=0; Pass<4; Pass++ )
+		Out->Logf
+		(
+			"  %-9s %8.2f us/path  found %i/%i  expanded %i  cached %i  tabled %i  first steps differ %i/%i%s",
+			PassNames[Pass],
+			1000000.0 * Seconds[Pass] / ::Max(Searches,1),
+			Found[Pass],
+			Searches,
+			Expanded[Pass],
+			Hits[Pass],
+			Tabled[Pass],
+			Mismatched[Pass],
+			Bots,
+			Mismatched[Pass] ? "  MISMATCH" : ""
+		);
+	if( TableBytes )
+		Out->Logf( "  route tables: %iK, built in %.1f msec", TableBytes/1024, BuildSeconds*1000.0 );
+	else
+		Out->Logf( "  no route tables: the network has over %i nodes", MAX_ROUTE_TABLE_NODES );
+	unguard;
+}
@@ -0,0 +1,20 @@
+/*=============================================================================
+	UnSIMD.h: Vector instruction set detection for the engine's batch loops
+	Copyright 1997 Epic MegaGames, Inc. This software is a trade secret.
+
+	Defines ENGINE_SSE or ENGINE_NEON, and includes the intrinsics for it,
+	when the compiler targets one of them.  Code using either must keep a
+	plain C++ version for when neither is defined.
+=============================================================================*/
+
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP>=1)
+	#include <xmmintrin.h>
+	#define ENGINE_SSE 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+	#include <arm_neon.h>
+	#define ENGINE_NEON 1
+#endif
+
+/*-----------------------------------------------------------------------------
+	The End.
+-----------------------------------------------------------------------------*/
@@ -1036,6 +1036,8 @@ void AActor::execPlayAnim( FFrame& Stack, BYTE*& Result )
 	P_GET_FLOAT_OPT(TweenTime,-1.0);
 	P_FINISH;
 
+	Unpark();
+
 	// Set one-shot animation.
 	if( Mesh )
 	{
@@ -1116,6 +1118,8 @@ void AActor::execLoopAnim( FFrame& Stack, BYTE*& Result )
 	P_GET_FLOAT_OPT(MinRate,0.0);
 	P_FINISH;
 
+	Unpark();
+
 	// Set looping animation.
 	if( Mesh )
 	{
@@ -1197,6 +1201,8 @@ void AActor::execTweenAnim( FFrame& Stack, BYTE*& Result )
 	P_GET_FLOAT(TweenTime);
 	P_FINISH;
 
+	Unpark();
+
 	// Tweening an animation from wherever it is, to the start of a specified sequence.
 	if( Mesh )
 	{
@@ -1522,7 +1528,10 @@ void AActor::execSpawn( FFrame& Stack, BYTE*& Result )
 		SpawnRotation
 	) : NULL;
 	if( Spawned )
+	{
 		Spawned->Tag = SpawnName;
+		GetLevel()->ActorTagChanged( Spawned );
+	}
 	*(AActor**)Result = Spawned;
 
 	unguardexecSlow;
@@ -1553,6 +1562,7 @@ void AActor::execSetTimer( FFrame& Stack, BYTE*& Result )
 	P_GET_UBOOL(bLoop);
 	P_FINISH;
 
+	Unpark();
 	TimerCounter = 0.0;
 	TimerRate    = NewTimerRate;
 	bTimerLoop   = bLoop;
@@ -1615,18 +1625,11 @@ void AActor::execAllActors( FFrame& Stack, BYTE*& Result )
 	P_GET_NAME_OPT(TagName,NAME_None);
 	P_FINISH;
 
-	BaseClass = BaseClass ? BaseClass : AActor::StaticClass;
-	INT iActor=0;
+	FActorQuery Query( XLevel, BaseClass, TagName );
 
 	PRE_ITERATOR;
 		// Fetch next actor in the iteration.
-		*OutActor = NULL;
-		while( iActor<XLevel->Num() && *OutActor==NULL )
-		{
-			AActor* TestActor = XLevel->Actors(iActor++);
-			if(	TestActor && TestActor->IsA(BaseClass) && (TagName==NAME_None || TestActor->Tag==TagName) )
-				*OutActor = TestActor;
-		}
+		*OutActor = Query.Next();
 		if( *OutActor == NULL )
 		{
 			Stack.Code = &Stack.Node->Script(wEndOffset + 1);
@@ -1648,16 +1651,15 @@ void AActor::execChildActors( FFrame& Stack, BYTE*& Result )
 
 	BaseClass = BaseClass ? BaseClass : AActor::StaticClass;
 	INT iActor=0;
+	DWORD LastSeq=0;
 
 	PRE_ITERATOR;
 		// Fetch next actor in the iteration.
 		*OutActor = NULL;
-		while( iActor<XLevel->Num() && *OutActor==NULL )
-		{
-			AActor* TestActor = XLevel->Actors(iActor++);
-			if(	TestActor && TestActor->IsA(BaseClass) && TestActor->IsOwnedBy( this ) )
+		AActor* TestActor;
+		while( *OutActor==NULL && (TestActor=XLevel->NextListedActor( iActor, LastSeq ))!=NULL )
+			if(	TestActor->IsA(BaseClass) && TestActor->IsOwnedBy( this ) )
 				*OutActor = TestActor;
-		}
 		if( *OutActor == NULL )
 		{
 			Stack.Code = &Stack.Node->Script(wEndOffset + 1);
@@ -1679,16 +1681,15 @@ void AActor::execBasedActors( FFrame& Stack, BYTE*& Result )
 
 	BaseClass = BaseClass ? BaseClass : AActor::StaticClass;
 	INT iActor=0;
+	DWORD LastSeq=0;
 
 	PRE_ITERATOR;
 		// Fetch next actor in the iteration.
 		*OutActor = NULL;
-		while( iActor<XLevel->Num() && *OutActor==NULL )
-		{
-			AActor* TestActor = XLevel->Actors(iActor++);
-			if(	TestActor && TestActor->IsA(BaseClass) && TestActor->Base==this )
+		AActor* TestActor;
+		while( *OutActor==NULL && (TestActor=XLevel->NextListedActor( iActor, LastSeq ))!=NULL )
+			if(	TestActor->IsA(BaseClass) && TestActor->Base==this )
 				*OutActor = TestActor;
-		}
 		if( *OutActor == NULL )
 		{
 			Stack.Code = &Stack.Node->Script(wEndOffset + 1);
@@ -1779,21 +1780,12 @@ void AActor::execRadiusActors( FFrame& Stack, BYTE*& Result )
 	P_GET_VECTOR_OPT(TraceLocation,Location);
 	P_FINISH;
 
-	BaseClass = BaseClass ? BaseClass : AActor::StaticClass;
-	INT iActor=0;
+	FMemMark Mark(GMem);
+	FRadiusActorQuery Query( GMem, XLevel, BaseClass, TraceLocation, Radius, 1 );
 
 	PRE_ITERATOR;
 		// Fetch next actor in the iteration.
-		*OutActor = NULL;
-		while( iActor<XLevel->Num() && *OutActor==NULL )
-		{
-			AActor* TestActor = XLevel->Actors(iActor++);
-			if
-			(	TestActor
-			&&	TestActor->IsA(BaseClass) 
-			&&	(TestActor->Location - TraceLocation).SizeSquared() < Square(Radius + TestActor->CollisionRadius) )
-				*OutActor = TestActor;
-		}
+		*OutActor = Query.Next();
 		if( *OutActor == NULL )
 		{
 			Stack.Code = &Stack.Node->Script(wEndOffset + 1);
@@ -1801,6 +1793,7 @@ void AActor::execRadiusActors( FFrame& Stack, BYTE*& Result )
 		}
 	POST_ITERATOR;
 
+	Mark.Pop();
 	unguardexecSlow;
 }
 AUTOREGISTER_INTRINSIC( AActor, 310, execRadiusActors );
@@ -1815,24 +1808,15 @@ void AActor::execVisibleActors( FFrame& Stack, BYTE*& Result )
 	P_GET_VECTOR_OPT(TraceLocation,Location);
 	P_FINISH;
 
-	BaseClass = BaseClass ? BaseClass : AActor::StaticClass;
-	INT iActor=0;
+	FMemMark Mark(GMem);
+	FRadiusActorQuery Query( GMem, XLevel, BaseClass, TraceLocation, Radius, 0 );
 
 	PRE_ITERATOR;
 		// Fetch next actor in the iteration.
-		*OutActor = NULL;
 		FCheckResult Hit;
-		while( iActor<XLevel->Num() && *OutActor==NULL )
-		{
-			AActor* TestActor = XLevel->Actors(iActor++);
-			if
-			(	TestActor
-			&& !TestActor->bHidden
-			&&	TestActor->IsA(BaseClass)
-			&&	(Radius==0.0 || (TestActor->Location-TraceLocation).SizeSquared() < Square(Radius))
-			&&	TestActor->GetLevel()->SingleLineCheck( Hit, this, TestActor->Location, TraceLocation, TRACE_VisBlocking ) )
-				*OutActor = TestActor;
-		}
+		while
+		(	(*OutActor=Query.Next())!=NULL
+		&&	((*OutActor)->bHidden || !(*OutActor)->GetLevel()->SingleLineCheck( Hit, this, (*OutActor)->Location, TraceLocation, TRACE_VisBlocking )) );
 		if( *OutActor == NULL )
 		{
 			Stack.Code = &Stack.Node->Script(wEndOffset + 1);
@@ -1840,6 +1824,7 @@ void AActor::execVisibleActors( FFrame& Stack, BYTE*& Result )
 		}
 	POST_ITERATOR;
 
+	Mark.Pop();
 	unguardexecSlow;
 }
 AUTOREGISTER_INTRINSIC( AActor, 311, execVisibleActors );
@@ -0,0 +1,212 @@
+/*=============================================================================
+	UnTimer.cpp: Hierarchical timer wheel used by the level's actor scheduler.
+	Copyright 1997 Epic MegaGames, Inc. This software is a trade secret.
+
+	Actors whose script is idle (no physics, no animation, no Tick, and state
+	code that is either finished or inside a Sleep) are parked by ULevel::Tick
+	and skipped until the earlier of their timer or their sleep expires, or
+	until something happens to them.  The wheel is how the level finds the
+	parked actors that are due each frame without looking at the rest.
+=============================================================================*/
+
+#include "EnginePrivate.h"
+
+/*-----------------------------------------------------------------------------
+	FTimerWheel implementation.
+-----------------------------------------------------------------------------*/
+
+//
+// Constructor.
+//
+FTimerWheel::FTimerWheel()
+{
+	guard(FTimerWheel::FTimerWheel);
+	Empty();
+	unguard;
+}
+
+//
+// Cancel all timers and reset the wheel.
+//
+void FTimerWheel::Empty()
+{
+	guard(FTimerWheel::Empty);
+	Nodes.Empty();
+	Nodes.AddZeroed();
+	Nodes(0).Slot = INDEX_NONE;
+	for( INT i=0; i<NUM_SLOTS; i++ )
+		Slots[i] = 0;
+	FirstFree    = 0;
+	Current      = INDEX_NONE;
+	NumScheduled = 0;
+	unguard;
+}
+
+//
+// Link a node into the slot appropriate to its distance from the current jiffy.
+//
+void FTimerWheel::Link( INT iNode )
+{
+	guardSlow(FTimerWheel::Link);
+	FNode& Node  = Nodes(iNode);
+	INT    Delta = Node.Expire - Current;
+	INT    iSlot;
+	if( Delta < WHEEL0_SIZE )
+		iSlot = Node.Expire & (WHEEL0_SIZE-1);
+	else if( Delta < (1<<(WHEEL0_BITS+WHEEL_BITS)) )
+		iSlot = WHEEL0_SIZE + ((Node.Expire>>WHEEL0_BITS) & (WHEEL_SIZE-1));
+	else if( Delta < (1<<(WHEEL0_BITS+2*WHEEL_BITS)) )
+		iSlot = WHEEL0_SIZE + WHEEL_SIZE + ((Node.Expire>>(WHEEL0_BITS+WHEEL_BITS)) & (WHEEL_SIZE-1));
+	else
+		iSlot = NUM_SLOTS-1;
+	Node.Slot = iSlot;
+	Node.Prev = 0;
+	Node.Next = Slots[iSlot];
+	if( Node.Next )
+		Nodes(Node.Next).Prev = iNode;
+	Slots[iSlot] = iNode;
+	unguardSlow;
+}
+
+//
+// Unlink a node from its slot.
+//
+void FTimerWheel::Unlink( INT iNode )
+{
+	guardSlow(FTimerWheel::Unlink);
+	FNode& Node = Nodes(iNode);
+	if( Node.Prev )
+		Nodes(Node.Prev).Next = Node.Next;
+	else
+		Slots[Node.Slot] = Node.Next;
+	if( Node.Next )
+		Nodes(Node.Next).Prev = Node.Prev;
+	Node.Slot = INDEX_NONE;
+	unguardSlow;
+}
+
+//
+// Redistribute all nodes of a higher level slot into the lower levels.
+//
+void FTimerWheel::Cascade( INT iSlot )
+{
+	guardSlow(FTimerWheel::Cascade);
+	INT iNode = Slots[iSlot];
+	Slots[iSlot] = 0;
+	while( iNode )
+	{
+		INT iNext = Nodes(iNode).Next;
+		Link( iNode );
+		iNode = iNext;
+	}
+	unguardSlow;
+}
+
+//
+// Schedule an actor to be woken at Time.  Returns the node handle.
+//
+INT FTimerWheel::Schedule( AActor* Actor, FLOAT Time )
+{
+	guardSlow(FTimerWheel::Schedule);
+	check(Actor);
+
+	// Start the wheel at the first time it is used.
+	INT Expire = ToJiffies( Time );
+	if( Current==INDEX_NONE )
+		Current = Expire - 1;
+
+	// Timers due now fire on the next advance.
+	if( Expire <= Current )
+		Expire = Current + 1;
+
+	// Allocate a node.
+	INT iNode = FirstFree;
+	if( iNode )
+		FirstFree = Nodes(iNode).Next;
+	else
+		iNode = Nodes.Add();
+	FNode& Node = Nodes(iNode);
+	Node.Actor  = Actor;
+	Node.Expire = Expire;
+	Link( iNode );
+	NumScheduled++;
+	return iNode;
+	unguardSlow;
+}
+
+//
+// Cancel a scheduled timer.
+//
+void FTimerWheel::Cancel( INT iNode )
+{
+	guardSlow(FTimerWheel::Cancel);
+	if( iNode>0 && iNode<Nodes.Num() && Nodes(iNode).Actor )
+	{
+		Unlink( iNode );
+		Nodes(iNode).Actor = NULL;
+		Nodes(iNode).Next  = FirstFree;
+		FirstFree          = iNode;
+		NumScheduled--;
+	}
+	unguardSlow;
+}
+
+//
+// Advance the wheel to Time, appending the actors of all expired timers
+// to Expired.  Expired nodes are freed, so their handles become invalid.
+//
+void FTimerWheel::Advance( FLOAT Time, TArray<AActor*>& Expired )
+{
+	guard(FTimerWheel::Advance);
+	INT Target = ToJiffies( Time );
+	if( Current==INDEX_NONE || (NumScheduled==0 && Target>Current) )
+	{
+		// Nothing can expire, so just move the wheel.
+		Current = Target;
+		return;
+	}
+	while( Current < Target )
+	{
+		Current++;
+
+		// Cascade higher levels when the lower level wraps.
+		INT Index = Current & (WHEEL0_SIZE-1);
+		if( Index==0 )
+		{
+			INT Index1 = (Current>>WHEEL0_BITS) & (WHEEL_SIZE-1);
+			if( Index1==0 )
+			{
+				INT Index2 = (Current>>(WHEEL0_BITS+WHEEL_BITS)) & (WHEEL_SIZE-1);
+				if( Index2==0 )
+					Cascade( NUM_SLOTS-1 );
+				Cascade( WHEEL0_SIZE + WHEEL_SIZE + Index2 );
+			}
+			Cascade( WHEEL0_SIZE + Index1 );
+		}
+
+		// Expire everything in the current slot.
+		INT iNode = Slots[Index];
+		Slots[Index] = 0;
+		while( iNode )
+		{
+			FNode& Node = Nodes(iNode);
+			INT iNext   = Node.Next;
+			Expired.AddItem( Node.Actor );
+			Node.Actor  = NULL;
+			Node.Slot   = INDEX_NONE;
+			Node.Next   = FirstFree;
+			FirstFree   = iNode;
+			NumScheduled--;
+			iNode       = iNext;
+		}
+
+		// Skip idle stretches quickly.
+		if( NumScheduled==0 )
+			Current = Target;
+	}
+	unguard;
+}
+
+/*-----------------------------------------------------------------------------
+	The End.
+-----------------------------------------------------------------------------*/
@@ -7,6 +7,7 @@
 =============================================================================*/
 
 #include "EnginePrivate.h"
+#include "UnSIMD.h"
 
 /*---------------------------------------------------------------------------------------
    Primitive bounding boxes.
@@ -329,11 +330,75 @@ UBOOL UModel::PointCheck
    LineCheck support.
 ---------------------------------------------------------------------------------------*/
 
+// Use the original recursive traces.
+ENGINE_API UBOOL GRecursiveTrace = 0;
+
+//
+// The start, end and extent of a trace laid out by component, so that
+// their distances from a plane can be found in one go.  Lane 0 is the
+// start, lane 1 the end, and lane 2 the box extent.
+//
+struct FTraceLanes
+{
+	FLOAT X[4], Y[4], Z[4];
+	void Set( const FVector& Start, const FVector& End, const FVector& Extent )
+	{
+		X[0] = Start.X; X[1] = End.X; X[2] = Extent.X; X[3] = 0.0;
+		Y[0] = Start.Y; Y[1] = End.Y; Y[2] = Extent.Y; Y[3] = 0.0;
+		Z[0] = Start.Z; Z[1] = End.Z; Z[2] = Extent.Z; Z[3] = 0.0;
+	}
+	void SetStart( const FVector& Start )
+	{
+		X[0] = Start.X; Y[0] = Start.Y; Z[0] = Start.Z;
+	}
+	void SetEnd( const FVector& End )
+	{
+		X[1] = End.X; Y[1] = End.Y; Z[1] = End.Z;
+	}
+};
+
+//
+// Set Out[0] to Plane.PlaneDot(Start), Out[1] to Plane.PlaneDot(End) and
+// Out[2] to FBoxPushOut(Plane,Extent).  The terms are summed in the same
+// order as the scalar functions, so the results are identical.
+//
+static inline void TracePlaneDots( const FPlane& Plane, const FTraceLanes& Lanes, FLOAT* Out )
+{
+#if ENGINE_SSE
+	__m128 P    = _mm_loadu_ps( &Plane.X );
+	__m128 Abs  = _mm_set_ps( 0.0f, -0.0f, 0.0f, 0.0f );
+	__m128 A    = _mm_andnot_ps( Abs, _mm_mul_ps( _mm_shuffle_ps(P,P,_MM_SHUFFLE(0,0,0,0)), _mm_loadu_ps(Lanes.X) ) );
+	__m128 B    = _mm_andnot_ps( Abs, _mm_mul_ps( _mm_shuffle_ps(P,P,_MM_SHUFFLE(1,1,1,1)), _mm_loadu_ps(Lanes.Y) ) );
+	__m128 C    = _mm_andnot_ps( Abs, _mm_mul_ps( _mm_shuffle_ps(P,P,_MM_SHUFFLE(2,2,2,2)), _mm_loadu_ps(Lanes.Z) ) );
+	__m128 W    = _mm_mul_ps( _mm_shuffle_ps(P,P,_MM_SHUFFLE(3,3,3,3)), _mm_set_ps(0.0f,0.0f,1.0f,1.0f) );
+	_mm_storeu_ps( Out, _mm_sub_ps( _mm_add_ps( _mm_add_ps(A,B), C ), W ) );
+#elif ENGINE_NEON
+	static const uint32_t AbsLanes[4] = {0,0,0xffffffff,0};
+	static const float    WLanes  [4] = {1.0f,1.0f,0.0f,0.0f};
+	uint32x4_t  Abs = vld1q_u32( AbsLanes );
+	float32x4_t A   = vmulq_n_f32( vld1q_f32(Lanes.X), Plane.X );
+	float32x4_t B   = vmulq_n_f32( vld1q_f32(Lanes.Y), Plane.Y );
+	float32x4_t C   = vmulq_n_f32( vld1q_f32(Lanes.Z), Plane.Z );
+	A = vbslq_f32( Abs, vabsq_f32(A), A );
+	B = vbslq_f32( Abs, vabsq_f32(B), B );
+	C = vbslq_f32( Abs, vabsq_f32(C), C );
+	vst1q_f32( Out, vsubq_f32( vaddq_f32( vaddq_f32(A,B), C ), vmulq_n_f32( vld1q_f32(WLanes), Plane.W ) ) );
+#else
+	Out[0] = Plane.X*Lanes.X[0] + Plane.Y*Lanes.Y[0] + Plane.Z*Lanes.Z[0] - Plane.W;
+	Out[1] = Plane.X*Lanes.X[1] + Plane.Y*Lanes.Y[1] + Plane.Z*Lanes.Z[1] - Plane.W;
+	Out[2] = Abs(Plane.X*Lanes.X[2]) + Abs(Plane.Y*Lanes.Y[2]) + Abs(Plane.Z*Lanes.Z[2]);
+#endif
+}
+
+//
+// Recursive minion of UModel::LineCheck.  GOutOfCorner is per thread so
+// that ULevel::BatchLineCheck can trace on the job workers.
 //
-// Recursive minion of UModel::LineCheck.
+// This is the original traversal, kept for -OLDTRACE and for TRACEBENCH
+// to check LineCheckStackless against.
 //
-UBOOL GOutOfCorner;
-UBOOL LineCheck
+static thread_local UBOOL GOutOfCorner;
+static UBOOL LineCheckRecursive
 (
 	FCheckResult&	Hit,
 	UModel&			Model,
@@ -346,7 +411,7 @@ UBOOL LineCheck
 	DWORD			InNodeFlags
 )
 {
-	guardSlow(LineCheck);
+	guardSlow(LineCheckRecursive);
 	while( iNode != INDEX_NONE )
 	{
 		const FBspNode*	Node = &Model.Nodes->Element(iNode);
@@ -375,7 +440,7 @@ UBOOL LineCheck
 			INT     FrontFirst = Dist1 > 0.0;
 
 			// Recurse with front part.
-			if( !LineCheck( Hit, Model, Coords, iHit, Node->iChild[FrontFirst], Middle, Start, Node->ChildOutside(FrontFirst,Outside,InNodeFlags), InNodeFlags ) )
+			if( !LineCheckRecursive( Hit, Model, Coords, iHit, Node->iChild[FrontFirst], Middle, Start, Node->ChildOutside(FrontFirst,Outside,InNodeFlags), InNodeFlags ) )
 				return 0;
 
 			// Loop with back part.
@@ -402,6 +467,126 @@ UBOOL LineCheck
 	unguardSlow;
 }
 
+//
+// Iterative minion of UModel::LineCheck.  Visits the same leaves in the
+// same order as LineCheckRecursive, but keeps the far parts of split lines
+// on a small stack of its own instead of recursing, transforms each node's
+// plane only once for moving brushes, and finds both distances together.
+// Recurses only if a very deep tree overflows the stack.
+//
+struct FLineCheckFrame
+{
+	FVector	Start, End;
+	INT		iNode, iHit;
+	UBOOL	Outside;
+};
+static UBOOL LineCheckStackless
+(
+	FCheckResult&	Hit,
+	UModel&			Model,
+	const FCoords*	Coords,
+	INT  			iHit,
+	INT				iNode,
+	FVector			End, 
+	FVector			Start,
+	UBOOL			Outside,
+	DWORD			InNodeFlags,
+	UBOOL&			OutOfCorner
+)
+{
+	guardSlow(LineCheckStackless);
+	FLineCheckFrame Stack[64];
+	INT             StackNum = 0;
+	DWORD           CsgFlags = InNodeFlags & ~NF_BrightCorners;
+	FTraceLanes     Lanes;
+	FLOAT           Dist[4];
+	Lanes.Set( Start, End, FVector(0,0,0) );
+	for( ;; )
+	{
+		while( iNode != INDEX_NONE )
+		{
+			const FBspNode* Node = &Model.Nodes->Element(iNode);
+
+			// Check side-of-plane for both points.
+			if( Coords )
+				TracePlaneDots( Node->Plane.TransformPlaneByOrtho(*Coords), Lanes, Dist );
+			else
+				TracePlaneDots( Node->Plane, Lanes, Dist );
+
+			// Classify line based on both distances.
+			if( Dist[0] > -0.001 && Dist[1] > -0.001 )
+			{
+				// Both points are in front.
+				Outside |= Node->IsCsg(CsgFlags);
+				iNode    = Node->iFront;
+			}
+			else if( Dist[0] < 0.001 && Dist[1] < 0.001 )
+			{
+				// Both points are in back.
+				Outside &= !Node->IsCsg(CsgFlags);
+				iNode    = Node->iBack;
+			}
+			else
+			{
+				// Line is split and guranteed to be non-parallel to plane, so TimeDenominator != 0.
+				FVector Middle     = Start + (Start-End) * (Dist[0]/(Dist[1]-Dist[0]));
+				INT     FrontFirst = Dist[0] > 0.0;
+				if( StackNum < ARRAY_COUNT(Stack) )
+				{
+					// Save the back part for later and go on with the front part.
+					FLineCheckFrame& Frame = Stack[StackNum++];
+					Frame.Start   = Middle;
+					Frame.End     = End;
+					Frame.iNode   = Node->iChild[1-FrontFirst];
+					Frame.iHit    = iNode;
+					Frame.Outside = Node->ChildOutside( 1-FrontFirst, Outside, InNodeFlags );
+					Outside       = Node->ChildOutside( FrontFirst, Outside, InNodeFlags );
+					iNode         = Node->iChild[FrontFirst];
+					End           = Middle;
+					Lanes.SetEnd( End );
+				}
+				else
+				{
+					// Out of stack, so recurse with front part and loop with back part.
+					if( !LineCheckStackless( Hit, Model, Coords, iHit, Node->iChild[FrontFirst], Middle, Start, Node->ChildOutside(FrontFirst,Outside,InNodeFlags), InNodeFlags, OutOfCorner ) )
+						return 0;
+					Outside = Node->ChildOutside( 1-FrontFirst, Outside, InNodeFlags );
+					iHit    = iNode;
+					iNode   = Node->iChild[1-FrontFirst];
+					Start   = Middle;
+					Lanes.SetStart( Start );
+				}
+			}
+		}
+		if( !Outside )
+		{
+			// We have encountered the first collision.
+			if( OutOfCorner || !(InNodeFlags&NF_BrightCorners) )
+			{
+				Hit.Location  = Start;
+				Hit.Normal    = Model.Nodes->Element(iHit).Plane;
+				Hit.Primitive = &Model;
+				Hit.Item      = iHit;
+				return 0;
+			}
+		}
+		else OutOfCorner = 1;
+
+		// Go on with the most recently saved part.
+		if( StackNum==0 )
+			return 1;
+		FLineCheckFrame& Frame = Stack[--StackNum];
+		Start   = Frame.Start;
+		End     = Frame.End;
+		iNode   = Frame.iNode;
+		iHit    = Frame.iHit;
+		Outside = Frame.Outside;
+		Lanes.SetStart( Start );
+		Lanes.SetEnd( End );
+	}
+	unguardSlow;
+}
+
 /*---------------------------------------------------------------------------------------
    Primitive LineCheck.
 ---------------------------------------------------------------------------------------*/
@@ -417,6 +602,8 @@ struct FBoxLineCheckInfo : public FBoxCheckInfo
 	FVector				Vector;
 	FLOAT				Dist;
 	UBOOL				DidHit;
+	UBOOL				Recursive;
+	FTraceLanes			NodeLanes, HullLanes;
 
 	// Constructor.
 	FBoxLineCheckInfo
@@ -427,7 +614,8 @@ struct FBoxLineCheckInfo : public FBoxCheckInfo
 		FVector			InEnd,
 		FVector			InStart,
 		FVector			InExtent,
-		DWORD			InExtraFlags
+		DWORD			InExtraFlags,
+		UBOOL			InRecursive
 	)
 	:	FBoxCheckInfo	(Hit, InModel, InOwner, InExtent, InExtraFlags)
 	,	End				(InEnd)
@@ -435,15 +623,31 @@ struct FBoxLineCheckInfo : public FBoxCheckInfo
 	,	Vector			(InEnd-InStart)
 	,	Dist			(Vector.Size())
 	,	DidHit			(0)
-	{}
+	,	Recursive		(InRecursive)
+	{
+		NodeLanes.Set( Start, End, Extent * 1.1 );
+		HullLanes.Set( Start, End, Extent );
+	}
 
 	// Tracer.
 	UBOOL ClipTo( const FPlane& Hull, INT Item )
 	{
 		guardSlow(ClipTo);
-		FLOAT PushOut = FBoxPushOut( Hull, Extent );
-		FLOAT D0      = Hull.PlaneDot(Start);
-		FLOAT D1      = Hull.PlaneDot(End);
+		FLOAT PushOut, D0, D1;
+		if( Recursive )
+		{
+			PushOut = FBoxPushOut( Hull, Extent );
+			D0      = Hull.PlaneDot(Start);
+			D1      = Hull.PlaneDot(End);
+		}
+		else
+		{
+			FLOAT Dots[4];
+			TracePlaneDots( Hull, HullLanes, Dots );
+			D0      = Dots[0];
+			D1      = Dots[1];
+			PushOut = Dots[2];
+		}
 
 		FLOAT AdjD0 = D0-PushOut;
 		if( D0>D1 && AdjD0>=-PushOut && AdjD0<0 )
@@ -458,6 +662,34 @@ struct FBoxLineCheckInfo : public FBoxCheckInfo
 		return T0 < T1;
 		unguardSlow;
 	}
+	void ClipLeaf( INT iParent, UBOOL Outside )
+	{
+		guardSlow(ClipLeaf);
+		const FBspNode& Parent = Model.Nodes->Element(iParent);
+		if( Outside==0 && Parent.iCollisionBound!=INDEX_NONE )
+		{
+			// Init.
+			SetupHulls(Parent);
+			T0       = -1.0; 
+			T1       = Hit.Time;
+			LocalHit = FVector(0,0,0);
+
+			// Perform collision clipping.
+			CLIP_COLLISION_PRIMITIVE;
+
+			// See if we hit.
+			if( T0>-1.0 && T0<T1 && T1>0.0 )
+			{
+				Hit.Time	  = T0;
+				Hit.Normal	  = LocalHit;
+				Hit.Actor     = Owner;
+				Hit.Primitive = &Model;
+				DidHit        = 1;
+			}
+			NoBlock:;
+		}
+		unguardSlow;
+	}
 	void BoxLineCheck( INT iParent, INT iNode, UBOOL IsFront, UBOOL Outside )
 	{
 		guardSlow(BoxLineCheck);
@@ -483,33 +715,73 @@ struct FBoxLineCheckInfo : public FBoxCheckInfo
 			Outside = Node.ChildOutside( 1-FrontFirst, Outside );
 			IsFront = !FrontFirst;
 		}
-		const FBspNode& Parent = Model.Nodes->Element(iParent);
-		if( Outside==0 && Parent.iCollisionBound!=INDEX_NONE )
+		ClipLeaf( iParent, Outside );
+		unguardSlow;
+	}
+	void BoxLineCheckStackless( INT iParent, INT iNode, UBOOL Outside )
+	{
+		guardSlow(BoxLineCheckStackless);
+		struct FFrame {INT iParent, iNode; UBOOL Outside;} Stack[64];
+		INT StackNum = 0;
+		FLOAT Dots[4];
+		for( ;; )
 		{
-			// Init.
-			SetupHulls(Parent);
-			T0       = -1.0; 
-			T1       = Hit.Time;
-			LocalHit = FVector(0,0,0);
-
-			// Perform collision clipping.
-			CLIP_COLLISION_PRIMITIVE;
-
-			// See if we hit.
-			if( T0>-1.0 && T0<T1 && T1>0.0 )
+			while( iNode != INDEX_NONE )
 			{
-				Hit.Time	  = T0;
-				Hit.Normal	  = LocalHit;
-				Hit.Actor     = Owner;
-				Hit.Primitive = &Model;
-				DidHit        = 1;
+				// Compute distance between start and end points and this node's plane.
+				const FBspNode& Node = Model.Nodes->Element(iNode);
+				if( Owner )
+					TracePlaneDots( Node.Plane.TransformPlaneByOrtho(Coords), NodeLanes, Dots );
+				else
+					TracePlaneDots( Node.Plane, NodeLanes, Dots );
+				FLOAT D0         = Dots[0];
+				FLOAT D1         = Dots[1];
+				FLOAT PushOut    = Dots[2];
+				UBOOL Use[2]     = {D0<=PushOut || D1<=PushOut, D0>=-PushOut || D1>=-PushOut};
+				UBOOL FrontFirst = D0 >= D1;
+
+				// Traverse down nearest side then furthest side.
+				UBOOL Side = FrontFirst;
+				if( !Use[FrontFirst] && !Use[1-FrontFirst] )
+				{
+					goto NextFrame;
+				}
+				else if( !Use[FrontFirst] )
+				{
+					Side = 1-FrontFirst;
+				}
+				else if( Use[1-FrontFirst] && StackNum<ARRAY_COUNT(Stack) )
+				{
+					// Save the furthest side for later.
+					FFrame& Frame  = Stack[StackNum++];
+					Frame.iParent  = iNode;
+					Frame.iNode    = Node.iChild[1-FrontFirst];
+					Frame.Outside  = Node.ChildOutside( 1-FrontFirst, Outside );
+				}
+				else if( Use[1-FrontFirst] )
+				{
+					// Out of stack, so recurse with the nearest side and loop with the furthest.
+					BoxLineCheckStackless( iNode, Node.iChild[FrontFirst], Node.ChildOutside(FrontFirst, Outside) );
+					Side = 1-FrontFirst;
+				}
+				iParent = iNode;
+				iNode   = Node.iChild[Side];
+				Outside = Node.ChildOutside( Side, Outside );
 			}
-			NoBlock:;
+			ClipLeaf( iParent, Outside );
+
+			// Go on with the most recently saved side.
+			NextFrame:
+			if( StackNum==0 )
+				return;
+			FFrame& Frame = Stack[--StackNum];
+			iParent = Frame.iParent;
+			iNode   = Frame.iNode;
+			Outside = Frame.Outside;
 		}
 		unguardSlow;
 	}
 };
-
 //
 // Try moving a collision box from Start to End and see what it collides
 // with. Returns 1 if unblocked, 0 if blocked.
@@ -536,17 +808,17 @@ UBOOL UModel::LineCheck
 		if( Extent == FVector(0,0,0) )
 		{
 			// Perform simple line trace.
-			GOutOfCorner = 0;
 			UBOOL Outside;
-			if( Owner )
+			const FCoords CheckCoords = Owner ? Owner->ToWorld() : GMath.UnitCoords;
+			if( GRecursiveTrace )
 			{
-				// shut up compiler
-				const FCoords CheckCoords = Owner->ToWorld();
-				Outside = ::LineCheck( Hit, *this, &CheckCoords, 0, 0, End, Start, RootOutside, ExtraNodeFlags );
+				GOutOfCorner = 0;
+				Outside = LineCheckRecursive( Hit, *this, Owner ? &CheckCoords : NULL, 0, 0, End, Start, RootOutside, ExtraNodeFlags );
 			}
 			else
 			{
-				Outside = ::LineCheck( Hit, *this, NULL, 0, 0, End, Start, RootOutside, ExtraNodeFlags );
+				UBOOL OutOfCorner = 0;
+				Outside = LineCheckStackless( Hit, *this, Owner ? &CheckCoords : NULL, 0, 0, End, Start, RootOutside, ExtraNodeFlags, OutOfCorner );
 			}
 			if( !Outside )
 			{
@@ -564,8 +836,11 @@ UBOOL UModel::LineCheck
 		{
 			// Perform expensive box convolution trace.
 			Hit.Time = 2.0;
-			FBoxLineCheckInfo Trace( Hit, *this, Owner, End, Start, Extent, ExtraNodeFlags );
-			Trace.BoxLineCheck( 0, 0, 0, RootOutside );
+			FBoxLineCheckInfo Trace( Hit, *this, Owner, End, Start, Extent, ExtraNodeFlags, GRecursiveTrace );
+			if( GRecursiveTrace )
+				Trace.BoxLineCheck( 0, 0, 0, RootOutside );
+			else
+				Trace.BoxLineCheckStackless( 0, 0, RootOutside );
 
 			// Truncate by the greater of 10% or 0.1 world units.
 			if( Trace.DidHit )
@@ -590,19 +865,36 @@ UBOOL UModel::LineCheck
 // zero indicates that the point doesn't fall into any zone.
 //
 FPointRegion UModel::PointRegion( AZoneInfo* Zone, FVector Location ) const
+{
+	guard(UModel::PointRegion);
+	FLOAT SafeRadius;
+	return PointRegion( Zone, Location, SafeRadius );
+	unguard;
+}
+
+//
+// Figure out which zone a point is in, and also set SafeRadius to the
+// distance from the point to the nearest plane on the way down to its
+// leaf.  Any point closer than that to Location is in the same leaf.
+//
+FPointRegion UModel::PointRegion( AZoneInfo* Zone, FVector Location, FLOAT& SafeRadius ) const
 {
 	guard(UModel::PointRegion);
 	check(Zone!=NULL);
 
 	FPointRegion Result( Zone, INDEX_NONE, 0 );
+	SafeRadius = 0.0;
 	if( Nodes->Num() ) 
 	{
 		UBOOL Outside=RootOutside, IsFront=0;
 		INT iNode=0, iParent=0;
+		FLOAT MinDist=1.e10;
 		while( iNode != INDEX_NONE )
 		{
 			const FBspNode& Node = Nodes->Element(iNode);
-			IsFront = Node.Plane.PlaneDot(Location) >= 0.0;
+			FLOAT Dist = Node.Plane.PlaneDot(Location);
+			IsFront = Dist >= 0.0;
+			MinDist = ::Min( MinDist, Abs(Dist) );
 			Outside = Node.ChildOutside(IsFront,Outside);
 			iParent = iNode;
 			iNode   = Node.iChild[IsFront];
@@ -610,6 +902,9 @@ FPointRegion UModel::PointRegion( AZoneInfo* Zone, FVector Location ) const
 		Result.iLeaf      = Nodes->Element(iParent).iLeaf[IsFront];
 		Result.ZoneNumber = Nodes->NumZones ? Nodes->Element(iParent).iZone[IsFront] : 0;
 		Result.Zone       = Nodes->Zones[Result.ZoneNumber].ZoneActor ? Nodes->Zones[Result.ZoneNumber].ZoneActor : Zone;
+
+		// Allow for rounding in the plane distances.
+		SafeRadius = ::Max( MinDist - 0.1f, 0.f );
 	}
 	return Result;
 	unguard;
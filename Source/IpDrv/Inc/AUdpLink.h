@@ -7,6 +7,7 @@
 	void Destroy();
 	SOCKET& GetSocket() { return *(SOCKET*)&Socket;}
 	UBOOL Tick( FLOAT DeltaTime, enum ELevelTick TickType );
+	UBOOL IsIdle( FLOAT& WakeDelay ) {return 0;}
 
 /*-----------------------------------------------------------------------------
 	The End.
@@ -662,12 +662,16 @@ void UNOpenALAudioSubsystem::Update( FPointRegion Region, FCoords& Listener )
 	if( UseReverb )
 		UpdateReverb( Region );
 
-	// Start new ambient sounds if needed.
+	// Start new ambient sounds if needed.  The static actors are scanned in
+	// the actor list, and the others in the live actor list if it is kept.
 	if( Viewport->Actor && Viewport->Actor->XLevel )
 	{
-		for( INT i = 0; i < Viewport->Actor->XLevel->Num(); i++ )
+		ULevel* Level = Viewport->Actor->XLevel;
+		TArray<AActor*>* Live = Level->GetLiveActors();
+		INT NumStatic = Live ? Level->iFirstDynamicActor : Level->Num();
+		for( INT i = 0; i < NumStatic + (Live ? Live->Num() : 0); i++ )
 		{
-			AActor* Actor = Viewport->Actor->XLevel->Actors(i);
+			AActor* Actor = i < NumStatic ? Level->Actors(i) : (*Live)(i - NumStatic);
 			if( !Actor || !Actor->IsValid() )
 				continue;
 
@@ -0,0 +1,125 @@
+/*=============================================================================
+	NullDrv.h: Headless client, viewport and render device.
+	Copyright 1997 Epic MegaGames, Inc. This software is a trade secret.
+
+	Used for running the game without a window or GPU, e.g. for timedemos
+	on build machines.  Selected with -HEADLESS on the command line.
+=============================================================================*/
+
+#include "Engine.h"
+#include "UnRender.h"
+
+/*-----------------------------------------------------------------------------
+	Defines.
+-----------------------------------------------------------------------------*/
+
+#ifdef NULLDRV_EXPORTS
+#define NULLDRV_API DLL_EXPORT
+#else
+#define NULLDRV_API DLL_IMPORT
+#endif
+
+/*-----------------------------------------------------------------------------
+	UNullViewport.
+-----------------------------------------------------------------------------*/
+
+//
+// A viewport with no window, rendering into a frame buffer in memory.
+//
+class NULLDRV_API UNullViewport : public UViewport
+{
+	DECLARE_CLASS_WITHOUT_CONSTRUCT( UNullViewport, UViewport, CLASS_Transient )
+	NO_DEFAULT_CONSTRUCTOR( UNullViewport )
+
+	// Variables.
+	BYTE* FrameBuffer;
+
+	// Constructors.
+	UNullViewport( ULevel* InLevel, UClient* InClient );
+
+	// UObject interface.
+	void Destroy();
+
+	// UViewport interface.
+	UBOOL Lock( FPlane FlashScale, FPlane FlashFog, FPlane ScreenClear, DWORD RenderLockFlags, BYTE* HitData=NULL, INT* HitSize=0 );
+	void Unlock( UBOOL Blit );
+	void Repaint();
+	void SetModeCursor();
+	void UpdateWindow();
+	void OpenWindow( void* ParentWindow, UBOOL Temporary, INT NewX, INT NewY, INT OpenX, INT OpenY );
+	void CloseWindow();
+	void UpdateInput( UBOOL Reset );
+	void MakeCurrent();
+	void MakeFullscreen( INT NewX, INT NewY, UBOOL UpdateProfile );
+	void* GetWindow();
+	void SetMouseCapture( UBOOL Capture, UBOOL Clip, UBOOL FocusOnly );
+
+private:
+	// Internal functions.
+	void TryRenderDevice( const char* ClassName );
+};
+
+/*-----------------------------------------------------------------------------
+	UNullClient.
+-----------------------------------------------------------------------------*/
+
+//
+// Viewport manager for headless operation.
+//
+class NULLDRV_API UNullClient : public UClient
+{
+	DECLARE_CLASS_WITHOUT_CONSTRUCT( UNullClient, UClient, CLASS_Transient|CLASS_Config )
+
+	// Constructors.
+	UNullClient();
+
+	// UClient interface.
+	void Init( UEngine* InEngine );
+	void ShowViewportWindows( DWORD ShowFlags, int DoShow );
+	void EnableViewportWindows( DWORD ShowFlags, int DoEnable );
+	void Poll();
+	UViewport* CurrentViewport();
+	void Tick();
+	UBOOL Exec( const char* Cmd, FOutputDevice* Out=GSystem );
+	UViewport* NewViewport( class ULevel* InLevel, const FName Name );
+	void EndFullscreen();
+};
+
+/*-----------------------------------------------------------------------------
+	UNullRenderDevice.
+-----------------------------------------------------------------------------*/
+
+//
+// Render device which accepts and counts everything the renderer sends it
+// but doesn't rasterize anything, so frame times measure the engine's side
+// of rendering: visibility, lighting, mesh and sprite setup.
+//
+class NULLDRV_API UNullRenderDevice : public URenderDevice
+{
+	DECLARE_CLASS( UNullRenderDevice, URenderDevice, CLASS_Config )
+
+	// Stats.
+	INT NumSurfs, NumPolys, NumTiles, NumLines;
+
+	// URenderDevice interface.
+	UBOOL Init( UViewport* InViewport );
+	void Exit();
+	void Flush();
+	UBOOL Exec( const char* Cmd, FOutputDevice* Out );
+	void Lock( FPlane FlashScale, FPlane FlashFog, FPlane ScreenClear, DWORD RenderLockFlags, BYTE* HitData, INT* HitSize );
+	void Unlock( UBOOL Blit );
+	void DrawComplexSurface( FSceneNode* Frame, FSurfaceInfo& Surface, FSurfaceFacet& Facet );
+	void DrawGouraudPolygon( FSceneNode* Frame, FTextureInfo& Info, FTransTexture** Pts, int NumPts, DWORD PolyFlags, FSpanBuffer* Span );
+	void DrawTile( FSceneNode* Frame, FTextureInfo& Info, FLOAT X, FLOAT Y, FLOAT XL, FLOAT YL, FLOAT U, FLOAT V, FLOAT UL, FLOAT VL, class FSpanBuffer* Span, FLOAT Z, FPlane Color, FPlane Fog, DWORD PolyFlags );
+	void Draw2DLine( FSceneNode* Frame, FPlane Color, DWORD LineFlags, FVector P1, FVector P2 );
+	void Draw2DPoint( FSceneNode* Frame, FPlane Color, DWORD LineFlags, FLOAT X1, FLOAT Y1, FLOAT X2, FLOAT Y2 );
+	void ClearZ( FSceneNode* Frame );
+	void PushHit( const BYTE* Data, INT Count );
+	void PopHit( INT Count, UBOOL bForce );
+	void GetStats( char* Result );
+	void ReadPixels( FColor* Pixels );
+};
+
+/*-----------------------------------------------------------------------------
+	The End.
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,308 @@
+/*=============================================================================
+	NullClient.cpp: Headless client and viewport.
+	Copyright 1997 Epic MegaGames, Inc. This software is a trade secret.
+=============================================================================*/
+
+#include "NullDrv.h"
+
+IMPLEMENT_CLASS(UNullClient);
+IMPLEMENT_CLASS(UNullViewport);
+
+/*-----------------------------------------------------------------------------
+	UNullClient implementation.
+-----------------------------------------------------------------------------*/
+
+//
+// Constructor.
+//
+UNullClient::UNullClient()
+{
+	guard(UNullClient::UNullClient);
+	unguard;
+}
+
+//
+// Initialize the viewport manager.
+//
+void UNullClient::Init( UEngine* InEngine )
+{
+	guard(UNullClient::Init);
+	UClient::Init( InEngine );
+	debugf( NAME_Init, "Headless client initialized" );
+	unguard;
+}
+
+//
+// Window management does nothing, as there are no windows.
+//
+void UNullClient::ShowViewportWindows( DWORD ShowFlags, int DoShow )
+{
+	guard(UNullClient::ShowViewportWindows);
+	unguard;
+}
+void UNullClient::EnableViewportWindows( DWORD ShowFlags, int DoEnable )
+{
+	guard(UNullClient::EnableViewportWindows);
+	unguard;
+}
+void UNullClient::Poll()
+{
+	guard(UNullClient::Poll);
+	unguard;
+}
+void UNullClient::EndFullscreen()
+{
+	guard(UNullClient::EndFullscreen);
+	unguard;
+}
+
+//
+// Return the current viewport.
+//
+UViewport* UNullClient::CurrentViewport()
+{
+	guard(UNullClient::CurrentViewport);
+	for( INT i=0; i<Viewports.Num(); i++ )
+		if( Viewports(i)->Current )
+			return Viewports(i);
+	return Viewports.Num() ? Viewports(0) : NULL;
+	unguard;
+}
+
+//
+// Repaint the realtime viewport which was updated least recently.
+//
+void UNullClient::Tick()
+{
+	guard(UNullClient::Tick);
+	UViewport* BestViewport = NULL;
+	for( INT i=0; i<Viewports.Num(); i++ )
+	{
+		UViewport* Viewport = Viewports(i);
+		if
+		(	Viewport->IsRealtime()
+		&&	Viewport->SizeX && Viewport->SizeY && !Viewport->OnHold
+		&&	(!BestViewport || Viewport->LastUpdateTime<BestViewport->LastUpdateTime) )
+			BestViewport = Viewport;
+	}
+	if( BestViewport )
+		BestViewport->Repaint();
+	unguard;
+}
+
+//
+// Command line.
+//
+UBOOL UNullClient::Exec( const char* Cmd, FOutputDevice* Out )
+{
+	guard(UNullClient::Exec);
+	return UClient::Exec( Cmd, Out );
+	unguard;
+}
+
+//
+// Create a new viewport.
+//
+UViewport* UNullClient::NewViewport( class ULevel* InLevel, const FName Name )
+{
+	guard(UNullClient::NewViewport);
+	return new( GObj.GetTransientPackage(), Name )UNullViewport( InLevel, this );
+	unguard;
+}
+
+/*-----------------------------------------------------------------------------
+	UNullViewport implementation.
+-----------------------------------------------------------------------------*/
+
+//
+// Constructor.
+//
+UNullViewport::UNullViewport( ULevel* InLevel, UClient* InClient )
+:	UViewport( InLevel, InClient )
+,	FrameBuffer( NULL )
+{
+	guard(UNullViewport::UNullViewport);
+	ColorBytes = 4;
+	Caps       = 0;
+	unguard;
+}
+
+//
+// Destroy.
+//
+void UNullViewport::Destroy()
+{
+	guard(UNullViewport::Destroy);
+	CloseWindow();
+	if( Client->FullscreenViewport==this )
+		Client->FullscreenViewport = NULL;
+	UViewport::Destroy();
+	unguard;
+}
+
+//
+// Allocate the frame buffer and render device.  Uses the device named by
+// -RENDEV= if given, so that a software rasterizer can be benchmarked into
+// memory where one is available, otherwise the null device.
+//
+void UNullViewport::OpenWindow( void* ParentWindow, UBOOL Temporary, INT NewX, INT NewY, INT OpenX, INT OpenY )
+{
+	guard(UNullViewport::OpenWindow);
+	check(Actor);
+	Parse( appCmdLine(), "RESX=", NewX );
+	Parse( appCmdLine(), "RESY=", NewY );
+	NewX = Align( Max(NewX,4), 4 );
+	NewY = Max( NewY, 4 );
+	if( !FrameBuffer || NewX!=SizeX || NewY!=SizeY )
+	{
+		if( FrameBuffer )
+			appFree( FrameBuffer );
+		FrameBuffer = (BYTE*)appMalloc( NewX * NewY * ColorBytes, "NullViewportFrameBuffer" );
+		appMemset( FrameBuffer, 0, NewX * NewY * ColorBytes );
+	}
+	SizeX = NewX;
+	SizeY = NewY;
+	if( !RenDev )
+	{
+		char ClassName[256];
+		if( Parse( appCmdLine(), "RENDEV=", ClassName, ARRAY_COUNT(ClassName) ) )
+			TryRenderDevice( ClassName );
+		if( !RenDev )
+			TryRenderDevice( "NullDrv.NullRenderDevice" );
+	}
+	check(RenDev);
+	debugf( NAME_Log, "Opened headless viewport %ix%i (%s)", SizeX, SizeY, RenDev->GetClass()->GetName() );
+	unguard;
+}
+
+//
+// Create a render device.
+//
+void UNullViewport::TryRenderDevice( const char* ClassName )
+{
+	guard(UNullViewport::TryRenderDevice);
+	if( RenDev )
+	{
+		RenDev->Exit();
+		delete RenDev;
+		RenDev = NULL;
+	}
+	UClass* RenderClass = GObj.LoadClass( URenderDevice::StaticClass, NULL, ClassName, NULL, LOAD_KeepImports, NULL );
+	if( RenderClass )
+	{
+		RenDev = ConstructClassObject<URenderDevice>( RenderClass );
+		if( RenDev->Init( this ) )
+		{
+			Actor->XLevel->DetailChange( RenDev->HighDetailActors );
+		}
+		else
+		{
+			debugf( NAME_Log, LocalizeError("Failed3D") );
+			delete RenDev;
+			RenDev = NULL;
+		}
+	}
+	unguard;
+}
+
+//
+// Free the frame buffer.
+//
+void UNullViewport::CloseWindow()
+{
+	guard(UNullViewport::CloseWindow);
+	if( FrameBuffer )
+	{
+		appFree( FrameBuffer );
+		FrameBuffer = NULL;
+	}
+	ScreenPointer = NULL;
+	unguard;
+}
+
+//
+// Lock the frame buffer.
+//
+UBOOL UNullViewport::Lock( FPlane FlashScale, FPlane FlashFog, FPlane ScreenClear, DWORD RenderLockFlags, BYTE* HitData, INT* HitSize )
+{
+	guard(UNullViewport::Lock);
+	if( !FrameBuffer || OnHold || !SizeX || !SizeY )
+		return 0;
+	ScreenPointer = FrameBuffer;
+	Stride        = SizeX;
+	return UViewport::Lock( FlashScale, FlashFog, ScreenClear, RenderLockFlags, HitData, HitSize );
+	unguard;
+}
+
+//
+// Unlock the frame buffer.  There's nothing to blit it to.
+//
+void UNullViewport::Unlock( UBOOL Blit )
+{
+	guard(UNullViewport::Unlock);
+	UViewport::Unlock( Blit );
+	unguard;
+}
+
+//
+// Repaint the viewport.
+//
+void UNullViewport::Repaint()
+{
+	guard(UNullViewport::Repaint);
+	if( !OnHold && RenDev && SizeX && SizeY )
+		Client->Engine->Draw( this, 0 );
+	unguard;
+}
+
+//
+// Window and input functions, which have nothing to act on.
+//
+void UNullViewport::SetModeCursor()
+{
+	guard(UNullViewport::SetModeCursor);
+	unguard;
+}
+void UNullViewport::UpdateWindow()
+{
+	guard(UNullViewport::UpdateWindow);
+	unguard;
+}
+void UNullViewport::UpdateInput( UBOOL Reset )
+{
+	guard(UNullViewport::UpdateInput);
+	unguard;
+}
+void UNullViewport::SetMouseCapture( UBOOL Capture, UBOOL Clip, UBOOL FocusOnly )
+{
+	guard(UNullViewport::SetMouseCapture);
+	unguard;
+}
+void UNullViewport::MakeFullscreen( INT NewX, INT NewY, UBOOL UpdateProfile )
+{
+	guard(UNullViewport::MakeFullscreen);
+	OpenWindow( NULL, 0, NewX, NewY, INDEX_NONE, INDEX_NONE );
+	unguard;
+}
+void* UNullViewport::GetWindow()
+{
+	guard(UNullViewport::GetWindow);
+	return NULL;
+	unguard;
+}
+
+//
+// Make this viewport the current one.
+//
+void UNullViewport::MakeCurrent()
+{
+	guard(UNullViewport::MakeCurrent);
+	for( INT i=0; i<Client->Viewports.Num(); i++ )
+		Client->Viewports(i)->Current = 0;
+	Current = 1;
+	unguard;
+}
+
+/*-----------------------------------------------------------------------------
+	The End.
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,16 @@
+/*=============================================================================
+	NullDrv.cpp: Headless driver package.
+	Copyright 1997 Epic MegaGames, Inc. This software is a trade secret.
+=============================================================================*/
+
+#include "NullDrv.h"
+
+/*-----------------------------------------------------------------------------
+	Package implementation.
+-----------------------------------------------------------------------------*/
+
+IMPLEMENT_PACKAGE( NullDrv );
+
+/*-----------------------------------------------------------------------------
+	The End.
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,165 @@
+/*=============================================================================
+	NullRenDev.cpp: Render device which draws nothing.
+	Copyright 1997 Epic MegaGames, Inc. This software is a trade secret.
+=============================================================================*/
+
+#include "NullDrv.h"
+
+IMPLEMENT_CLASS(UNullRenderDevice);
+
+/*-----------------------------------------------------------------------------
+	UNullRenderDevice implementation.
+-----------------------------------------------------------------------------*/
+
+//
+// Initialize.
+//
+UBOOL UNullRenderDevice::Init( UViewport* InViewport )
+{
+	guard(UNullRenderDevice::Init);
+	Viewport           = InViewport;
+	SpanBased          = 0;
+	FrameBuffered      = 0;
+	SupportsFogMaps    = 1;
+	VolumetricLighting = 1;
+	Coronas            = 1;
+	HighDetailActors   = 1;
+	NumSurfs = NumPolys = NumTiles = NumLines = 0;
+	debugf( NAME_Init, "Null render device initialized" );
+	return 1;
+	unguard;
+}
+
+//
+// Shut down.
+//
+void UNullRenderDevice::Exit()
+{
+	guard(UNullRenderDevice::Exit);
+	unguard;
+}
+
+//
+// Flush cached state; there is none.
+//
+void UNullRenderDevice::Flush()
+{
+	guard(UNullRenderDevice::Flush);
+	unguard;
+}
+
+//
+// Command line.
+//
+UBOOL UNullRenderDevice::Exec( const char* Cmd, FOutputDevice* Out )
+{
+	guard(UNullRenderDevice::Exec);
+	return 0;
+	unguard;
+}
+
+//
+// Begin a frame.
+//
+void UNullRenderDevice::Lock( FPlane FlashScale, FPlane FlashFog, FPlane ScreenClear, DWORD RenderLockFlags, BYTE* HitData, INT* HitSize )
+{
+	guard(UNullRenderDevice::Lock);
+	NumSurfs = NumPolys = NumTiles = NumLines = 0;
+	if( (RenderLockFlags & LOCKR_ClearScreen) && Viewport->ScreenPointer )
+		appMemset( Viewport->ScreenPointer, 0, Viewport->Stride * Viewport->SizeY * Viewport->ColorBytes );
+	if( HitSize )
+		*HitSize = 0;
+	unguard;
+}
+
+//
+// End a frame.
+//
+void UNullRenderDevice::Unlock( UBOOL Blit )
+{
+	guard(UNullRenderDevice::Unlock);
+	unguard;
+}
+
+//
+// Drawing functions, which only count what they are given.
+//
+void UNullRenderDevice::DrawComplexSurface( FSceneNode* Frame, FSurfaceInfo& Surface, FSurfaceFacet& Facet )
+{
+	guardSlow(UNullRenderDevice::DrawComplexSurface);
+	NumSurfs++;
+	for( FSavedPoly* Poly=Facet.Polys; Poly; Poly=Poly->Next )
+		NumPolys++;
+	unguardSlow;
+}
+void UNullRenderDevice::DrawGouraudPolygon( FSceneNode* Frame, FTextureInfo& Info, FTransTexture** Pts, int NumPts, DWORD PolyFlags, FSpanBuffer* Span )
+{
+	guardSlow(UNullRenderDevice::DrawGouraudPolygon);
+	NumPolys++;
+	unguardSlow;
+}
+void UNullRenderDevice::DrawTile( FSceneNode* Frame, FTextureInfo& Info, FLOAT X, FLOAT Y, FLOAT XL, FLOAT YL, FLOAT U, FLOAT V, FLOAT UL, FLOAT VL, class FSpanBuffer* Span, FLOAT Z, FPlane Color, FPlane Fog, DWORD PolyFlags )
+{
+	guardSlow(UNullRenderDevice::DrawTile);
+	NumTiles++;
+	unguardSlow;
+}
+void UNullRenderDevice::Draw2DLine( FSceneNode* Frame, FPlane Color, DWORD LineFlags, FVector P1, FVector P2 )
+{
+	guardSlow(UNullRenderDevice::Draw2DLine);
+	NumLines++;
+	unguardSlow;
+}
+void UNullRenderDevice::Draw2DPoint( FSceneNode* Frame, FPlane Color, DWORD LineFlags, FLOAT X1, FLOAT Y1, FLOAT X2, FLOAT Y2 )
+{
+	guardSlow(UNullRenderDevice::Draw2DPoint);
+	NumLines++;
+	unguardSlow;
+}
+void UNullRenderDevice::ClearZ( FSceneNode* Frame )
+{
+	guard(UNullRenderDevice::ClearZ);
+	unguard;
+}
+
+//
+// Hit testing is not supported.
+//
+void UNullRenderDevice::PushHit( const BYTE* Data, INT Count )
+{
+	guard(UNullRenderDevice::PushHit);
+	unguard;
+}
+void UNullRenderDevice::PopHit( INT Count, UBOOL bForce )
+{
+	guard(UNullRenderDevice::PopHit);
+	unguard;
+}
+
+//
+// Return stats for the last frame.
+//
+void UNullRenderDevice::GetStats( char* Result )
+{
+	guard(UNullRenderDevice::GetStats);
+	appSprintf( Result, "surfs=%i polys=%i tiles=%i lines=%i", NumSurfs, NumPolys, NumTiles, NumLines );
+	unguard;
+}
+
+//
+// Read the frame buffer back.
+//
+void UNullRenderDevice::ReadPixels( FColor* Pixels )
+{
+	guard(UNullRenderDevice::ReadPixels);
+	INT Count = Viewport->SizeX * Viewport->SizeY;
+	if( Viewport->ScreenPointer && Viewport->ColorBytes==4 )
+		appMemcpy( Pixels, Viewport->ScreenPointer, Count * sizeof(FColor) );
+	else
+		appMemset( Pixels, 0, Count * sizeof(FColor) );
+	unguard;
+}
+
+/*-----------------------------------------------------------------------------
+	The End.
+-----------------------------------------------------------------------------*/
@@ -152,7 +152,7 @@ void URender::DrawStats( FSceneNode* Frame )
 	ThisEndTime      = appCycles();
 	DWORD FrameTime  = ThisEndTime - LastEndTime;
 	DWORD RenderTime = ThisEndTime - ThisStartTime;
-	char TempStr[256];
+	char TempStr[1024];
 
 	if( FpsStats )
 	{
@@ -2259,6 +2259,7 @@ void URender::DrawFrame( FSceneNode* Frame )
 void URender::DrawWorld( FSceneNode* Frame )
 {
 	guard(URender::DrawWorld);
+	profileZone("URender::DrawWorld");
 	FMemMark SceneMark(GSceneMem);
 	FMemMark MemMark(GMem);
 	FMemMark DynMark(GDynMem);
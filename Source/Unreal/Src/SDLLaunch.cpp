@@ -15,11 +15,99 @@ extern DLL_IMPORT UBOOL GTickDue;
 extern "C" {HINSTANCE hInstance;}
 extern "C" {char GCC_HIDDEN THIS_PACKAGE[64]="Launch";}
 
+static UEngine* GLaunchEngine = NULL;
+
+//
+// Fixed-step server tick statistics for the current report interval.
+// Times are in seconds.
+//
+struct FServerTickStats
+{
+	INT    Ticks;			// Simulation steps run.
+	INT    CatchUpTicks;	// Steps run back to back to catch up.
+	INT    Overruns;		// Steps which took longer than the step time.
+	INT    DroppedTicks;	// Steps skipped because catch-up was exhausted.
+	DOUBLE WorkTime;		// Total time spent in Engine->Tick.
+	DOUBLE MaxWorkTime;		// Longest single step.
+	DOUBLE Jitter;			// Total lateness of batch starts.
+	DOUBLE MaxJitter;		// Worst lateness of a batch start.
+	INT    Batches;			// Wakeups which ran at least one step.
+};
+static FServerTickStats GTickStats;
+static INT GFixedTickRate = 0;
+
+//
+// Log the fixed-step tick statistics.
+//
+static void LogServerTickStats( FOutputDevice* Out, DOUBLE Interval )
+{
+	guard(LogServerTickStats);
+	FServerTickStats& S = GTickStats;
+	Out->Logf
+	(
+		"Server tick: %i Hz, %i ticks in %.1f sec (%i catch-up, %i overruns, %i dropped), work avg %.3f max %.3f ms, jitter avg %.3f max %.3f ms",
+		GFixedTickRate,
+		S.Ticks,
+		Interval,
+		S.CatchUpTicks,
+		S.Overruns,
+		S.DroppedTicks,
+		S.Ticks   ? 1000.0 * S.WorkTime / S.Ticks : 0.0,
+		1000.0 * S.MaxWorkTime,
+		S.Batches ? 1000.0 * S.Jitter / S.Batches : 0.0,
+		1000.0 * S.MaxJitter
+	);
+	unguard;
+}
+
+//
+// Append the current view of the first viewport to a timedemo camera path,
+// one "X Y Z Pitch Yaw Roll" line per key.
+//
+static void AddCameraPathKey( const char* Cmd, FOutputDevice* Out )
+{
+	guard(AddCameraPathKey);
+	if( !GLaunchEngine || !GLaunchEngine->Client || !GLaunchEngine->Client->Viewports.Num() )
+	{
+		Out->Log( "No viewport to record" );
+		return;
+	}
+	char Filename[256]="TimeDemo.path";
+	Parse( Cmd, "FILE=", Filename, ARRAY_COUNT(Filename) );
+	APlayerPawn* Actor = GLaunchEngine->Client->Viewports(0)->Actor;
+	FILE* F = appFopen( Filename, "a" );
+	if( !F )
+	{
+		Out->Logf( "Couldn't open %s", Filename );
+		return;
+	}
+	appFprintf( F, "%f %f %f %i %i %i\n", Actor->Location.X, Actor->Location.Y, Actor->Location.Z, Actor->ViewRotation.Pitch, Actor->ViewRotation.Yaw, Actor->ViewRotation.Roll );
+	appFclose( F );
+	Out->Logf( "Added camera key to %s", Filename );
+	unguard;
+}
+
 // FExecHook.
 class FExecHook : public FExec
 {
 	UBOOL Exec( const char* Cmd, FOutputDevice* Out )
 	{
+		if( ParseCommand(&Cmd,"CAMPATH") )
+		{
+			if( ParseCommand(&Cmd,"ADD") )
+				AddCameraPathKey( Cmd, Out );
+			else
+				Out->Log( "Usage: CAMPATH ADD [FILE=]" );
+			return 1;
+		}
+		else if( ParseCommand(&Cmd,"TICKSTATS") )
+		{
+			if( GFixedTickRate )
+				LogServerTickStats( Out, GTickStats.Ticks / (DOUBLE)GFixedTickRate );
+			else
+				Out->Log( "Fixed-step server tick is not enabled" );
+			return 1;
+		}
 		return 0;
 	}
 };
@@ -225,6 +313,403 @@ void MainLoop( UEngine* Engine )
 	unguard;
 }
 
+//
+// Dedicated server loop which runs the simulation in exact steps of
+// 1/TickRate seconds instead of real elapsed time, so gameplay and the
+// network send rate don't drift with OS scheduling.  Real time is
+// accumulated, and when the server falls behind it runs up to MAXCATCHUP=
+// extra steps back to back before dropping the backlog.  Overruns and
+// wakeup jitter are logged every TICKREPORT= seconds and by TICKSTATS.
+//
+void FixedStepLoop( UEngine* Engine, INT TickRate )
+{
+	guard(FixedStepLoop);
+
+	INT    MaxCatchUp     = 4;
+	FLOAT  ReportInterval = 60.f;
+	Parse( appCmdLine(), "MAXCATCHUP=", MaxCatchUp );
+	Parse( appCmdLine(), "TICKREPORT=", ReportInterval );
+	MaxCatchUp = Max( MaxCatchUp, 0 );
+
+	GFixedTickRate = TickRate;
+	appMemset( &GTickStats, 0, sizeof(GTickStats) );
+	debugf( NAME_Init, "Fixed-step server tick at %i Hz, up to %i catch-up steps", TickRate, MaxCatchUp );
+
+	UGameEngine* GameEngine = Cast<UGameEngine>( Engine );
+	const DOUBLE Step = 1.0 / TickRate;
+	DOUBLE NextTime   = appSeconds();
+	DOUBLE ReportTime = NextTime + ReportInterval;
+	GIsRunning = 1;
+	while( GIsRunning && !GIsRequestingExit )
+	{
+		// While hibernating, tick at the engine's low rate outside the
+		// fixed schedule, and restart the schedule on waking.
+		if( GameEngine && GameEngine->bHibernating )
+		{
+			DOUBLE HibernateStep = 1.0 / GameEngine->GetMaxTickRate();
+			DOUBLE StartTime     = appSeconds();
+			Engine->Tick( HibernateStep );
+			if( GameEngine->bHibernating )
+			{
+				DOUBLE Wait = HibernateStep - (appSeconds() - StartTime);
+				if( Wait > 0.0 )
+					appSleep( Wait );
+			}
+			NextTime = appSeconds();
+			continue;
+		}
+
+		// Wait for the next step; sleep most of the way, then yield so
+		// the wakeup isn't at the mercy of the scheduler's granularity.
+		DOUBLE Now = appSeconds();
+		if( Now < NextTime )
+		{
+			if( NextTime - Now > 0.002 )
+				appSleep( NextTime - Now - 0.001 );
+			else
+				appThreadYield();
+			continue;
+		}
+
+		// Record how late this wakeup was.
+		FServerTickStats& S = GTickStats;
+		DOUBLE Late = Now - NextTime;
+		S.Jitter   += Late;
+		S.MaxJitter = Max( S.MaxJitter, Late );
+		S.Batches++;
+
+		// Run every step which is due, up to the catch-up limit.
+		for( INT Steps=0; Now>=NextTime && Steps<=MaxCatchUp && !GIsRequestingExit; Steps++ )
+		{
+			DOUBLE StartTime = Now;
+			Engine->Tick( Step );
+			Now = appSeconds();
+
+			DOUBLE Work = Now - StartTime;
+			S.Ticks++;
+			S.WorkTime   += Work;
+			S.MaxWorkTime = Max( S.MaxWorkTime, Work );
+			if( Work > Step )
+				S.Overruns++;
+			if( Steps > 0 )
+				S.CatchUpTicks++;
+			NextTime += Step;
+		}
+
+		// Still behind: drop the backlog rather than spiral.
+		if( Now >= NextTime )
+		{
+			INT Dropped = (INT)((Now - NextTime) / Step) + 1;
+			S.DroppedTicks += Dropped;
+			NextTime       += Dropped * Step;
+		}
+
+		// Periodic report.
+		if( ReportInterval>0.f && Now>=ReportTime )
+		{
+			LogServerTickStats( GSystem, Now - ReportTime + ReportInterval );
+			appMemset( &GTickStats, 0, sizeof(GTickStats) );
+			ReportTime = Now + ReportInterval;
+		}
+	}
+	GIsRunning = 0;
+	GFixedTickRate = 0;
+	unguard;
+}
+
+/*-----------------------------------------------------------------------------
+	Timedemo.
+-----------------------------------------------------------------------------*/
+
+//
+// A key on the timedemo camera path.
+//
+struct FDemoCameraKey
+{
+	FVector  Location;
+	FRotator Rotation;
+};
+
+//
+// Timings of one timedemo frame, in milliseconds.
+//
+struct FDemoFrame
+{
+	FLOAT Total, Game, Render, Script;
+};
+
+//
+// Min, average, 99th percentile and max of one timing.
+//
+struct FDemoStat
+{
+	FLOAT Min, Avg, P99, Max;
+};
+
+static int CDECL CompareDemoTimes( const void* A, const void* B )
+{
+	FLOAT Diff = *(FLOAT*)A - *(FLOAT*)B;
+	return Diff<0.f ? -1 : Diff>0.f ? 1 : 0;
+}
+
+//
+// Compute the stats of the timing at Offset within each frame.
+//
+static FDemoStat DemoStat( TArray<FDemoFrame>& Frames, INT Offset )
+{
+	FDemoStat Result = {0.f,0.f,0.f,0.f};
+	if( !Frames.Num() )
+		return Result;
+	TArray<FLOAT> Times( Frames.Num() );
+	DOUBLE Sum = 0.0;
+	for( INT i=0; i<Frames.Num(); i++ )
+	{
+		Times(i) = *(FLOAT*)((BYTE*)&Frames(i) + Offset);
+		Sum     += Times(i);
+	}
+	appQsort( &Times(0), Times.Num(), sizeof(FLOAT), CompareDemoTimes );
+	Result.Min = Times(0);
+	Result.Avg = Sum / Times.Num();
+	Result.P99 = Times( Min( Times.Num()-1, (INT)(Times.Num()*0.99f) ) );
+	Result.Max = Times(Times.Num()-1);
+	return Result;
+}
+
+//
+// Shortest signed difference between two angles.
+//
+static INT DemoAngleDelta( INT A, INT B )
+{
+	INT Delta = (B - A) & 65535;
+	return Delta>32767 ? Delta-65536 : Delta;
+}
+
+//
+// Load a camera path file.
+//
+static void LoadCameraPath( const char* Filename, TArray<FDemoCameraKey>& Keys )
+{
+	guard(LoadCameraPath);
+	FILE* F = appFopen( Filename, "r" );
+	if( !F )
+		appErrorf( "Couldn't open camera path %s", Filename );
+	char Line[256];
+	while( fgets( Line, ARRAY_COUNT(Line), F ) )
+	{
+		FDemoCameraKey Key;
+		if( sscanf( Line, "%f %f %f %i %i %i", &Key.Location.X, &Key.Location.Y, &Key.Location.Z, &Key.Rotation.Pitch, &Key.Rotation.Yaw, &Key.Rotation.Roll )==6 )
+			Keys.AddItem( Key );
+	}
+	appFclose( F );
+	unguard;
+}
+
+//
+// Default flythrough: visit the level's navigation points in list order,
+// looking at the next one.  Levels without paths get a turn on the spot
+// at the player start.
+//
+static void BuildDefaultCameraPath( ULevel* Level, APlayerPawn* Actor, TArray<FDemoCameraKey>& Keys )
+{
+	guard(BuildDefaultCameraPath);
+	for( ANavigationPoint* Nav=Level->GetLevelInfo()->NavigationPointList; Nav && Keys.Num()<256; Nav=Nav->nextNavigationPoint )
+	{
+		FDemoCameraKey Key;
+		Key.Location = Nav->Location;
+		Key.Rotation = FRotator(0,0,0);
+		Keys.AddItem( Key );
+	}
+	for( INT i=0; i<Keys.Num(); i++ )
+	{
+		FVector Dir = Keys((i+1)%Keys.Num()).Location - Keys(i).Location;
+		if( !Dir.IsZero() )
+			Keys(i).Rotation = Dir.Rotation();
+		Keys(i).Rotation.Roll = 0;
+	}
+	if( Keys.Num()<2 )
+	{
+		Keys.Empty();
+		for( INT i=0; i<=4; i++ )
+		{
+			FDemoCameraKey Key;
+			Key.Location = Actor->Location;
+			Key.Rotation = FRotator( 0, Actor->ViewRotation.Yaw + i*16384, 0 );
+			Keys.AddItem( Key );
+		}
+	}
+	unguard;
+}
+
+//
+// Sample the camera path at Alpha, from 0 (first key) to 1 (last key).
+//
+static FDemoCameraKey SampleCameraPath( TArray<FDemoCameraKey>& Keys, FLOAT Alpha )
+{
+	FLOAT Pos = Clamp( Alpha, 0.f, 1.f ) * (Keys.Num()-1);
+	INT   i   = Min( (INT)Pos, Keys.Num()-2 );
+	FLOAT T   = Pos - i;
+	FDemoCameraKey& A = Keys(i);
+	FDemoCameraKey& B = Keys(i+1);
+	FDemoCameraKey Result;
+	Result.Location       = A.Location + (B.Location - A.Location) * T;
+	Result.Rotation.Pitch = A.Rotation.Pitch + appRound( DemoAngleDelta(A.Rotation.Pitch, B.Rotation.Pitch) * T );
+	Result.Rotation.Yaw   = A.Rotation.Yaw   + appRound( DemoAngleDelta(A.Rotation.Yaw,   B.Rotation.Yaw  ) * T );
+	Result.Rotation.Roll  = A.Rotation.Roll  + appRound( DemoAngleDelta(A.Rotation.Roll,  B.Rotation.Roll ) * T );
+	return Result;
+}
+
+//
+// Run a scripted, fixed-step flythrough of the level and report frame
+// timings, instead of the interactive main loop.  Use with -HEADLESS to
+// benchmark without a window or GPU.
+//
+// Options: FRAMES= measured frames, WARMUP= unmeasured frames before them,
+// DELTA= game seconds per frame, DEMOPATH= camera path file written by
+// CAMPATH ADD, DEMOOUT= JSON result file.
+//
+void TimeDemoLoop( UEngine* Engine )
+{
+	guard(TimeDemoLoop);
+
+	INT   NumFrames = 1000;
+	INT   NumWarmup = 10;
+	FLOAT Delta     = 1.f/30.f;
+	char  PathFile[256]="", OutFile[256]="TimeDemo.json";
+	Parse( appCmdLine(), "FRAMES=", NumFrames );
+	Parse( appCmdLine(), "WARMUP=", NumWarmup );
+	Parse( appCmdLine(), "DELTA=",  Delta     );
+	Parse( appCmdLine(), "DEMOPATH=", PathFile, ARRAY_COUNT(PathFile) );
+	Parse( appCmdLine(), "DEMOOUT=",  OutFile,  ARRAY_COUNT(OutFile)  );
+	NumFrames = Max( NumFrames, 1 );
+	NumWarmup = Max( NumWarmup, 0 );
+
+	UGameEngine* GameEngine = Cast<UGameEngine>( Engine );
+	if( !GameEngine || !GameEngine->GLevel || !Engine->Client || !Engine->Client->Viewports.Num() )
+		appErrorf( "Timedemo requires a game engine with a level and a viewport" );
+	UViewport*   Viewport = Engine->Client->Viewports(0);
+	APlayerPawn* Actor    = Viewport->Actor;
+	ULevel*      Level    = GameEngine->GLevel;
+
+	// Same random sequence every run.
+	srand( 0 );
+
+	// Set up the camera path.
+	TArray<FDemoCameraKey> Keys;
+	if( *PathFile )
+		LoadCameraPath( PathFile, Keys );
+	else
+		BuildDefaultCameraPath( Level, Actor, Keys );
+	if( Keys.Num()==1 )
+		Keys.AddItem( Keys(0) );
+	if( Keys.Num()<2 )
+		appErrorf( "Camera path %s has no keys", PathFile );
+	debugf( NAME_Log, "Timedemo: %s, %i keys, %i frames (+%i warmup) at %f sec", *Level->URL.Map, Keys.Num(), NumFrames, NumWarmup, Delta );
+
+	// Run it.
+	TArray<FDemoFrame> Frames;
+	GIsRunning = 1;
+	for( INT i=-NumWarmup; i<NumFrames && GIsRunning && !GIsRequestingExit; i++ )
+	{
+		FDemoCameraKey Key = SampleCameraPath( Keys, i<=0 ? 0.f : (FLOAT)i/Max(NumFrames-1,1) );
+		Actor->Physics      = PHYS_None;
+		Actor->Velocity     = FVector(0,0,0);
+		Actor->Acceleration = FVector(0,0,0);
+		Actor->XLevel->FarMoveActor( Actor, Key.Location, 0, 1 );
+		Actor->ViewRotation = Key.Rotation;
+		Actor->Rotation     = FRotator( 0, Key.Rotation.Yaw, 0 );
+
+		DOUBLE StartTime = appSeconds();
+		Engine->Tick( Delta );
+		DOUBLE EndTime   = appSeconds();
+		if( i>=0 )
+		{
+			FDemoFrame& Frame = Frames( Frames.Add() );
+			Frame.Total  = (EndTime - StartTime) * 1000.0;
+			Frame.Game   = GSecondsPerCycle * 1000.0 * Engine->GameCycles;
+			Frame.Render = GSecondsPerCycle * 1000.0 * Engine->ClientCycles;
+			Frame.Script = GSecondsPerCycle * 1000.0 * GScriptCycles;
+		}
+	}
+	GIsRunning = 0;
+
+	// Report.
+	static const char* StatNames[4] = {"total","game","render","script"};
+	FDemoStat Stats[4];
+	Stats[0] = DemoStat( Frames, STRUCT_OFFSET(FDemoFrame,Total ) );
+	Stats[1] = DemoStat( Frames, STRUCT_OFFSET(FDemoFrame,Game  ) );
+	Stats[2] = DemoStat( Frames, STRUCT_OFFSET(FDemoFrame,Render) );
+	Stats[3] = DemoStat( Frames, STRUCT_OFFSET(FDemoFrame,Script) );
+	debugf( NAME_Log, "Timedemo: %i frames, %.2f fps", Frames.Num(), Stats[0].Avg>0.f ? 1000.f/Stats[0].Avg : 0.f );
+	for( INT i=0; i<4; i++ )
+		debugf( NAME_Log, "  %-6s min %7.3f  avg %7.3f  p99 %7.3f  max %7.3f ms", StatNames[i], Stats[i].Min, Stats[i].Avg, Stats[i].P99, Stats[i].Max );
+	printf( "TIMEDEMO map=%s frames=%i avg=%.3f p99=%.3f max=%.3f game=%.3f render=%.3f script=%.3f\n", *Level->URL.Map, Frames.Num(), Stats[0].Avg, Stats[0].P99, Stats[0].Max, Stats[1].Avg, Stats[2].Avg, Stats[3].Avg );
+	fflush( stdout );
+
+	FILE* F = appFopen( OutFile, "w" );
+	if( F )
+	{
+		appFprintf( F, "{\n\t\"map\": \"%s\",\n\t\"frames\": %i,\n\t\"warmup\": %i,\n\t\"delta\": %f,\n", *Level->URL.Map, Frames.Num(), NumWarmup, Delta );
+		for( INT i=0; i<4; i++ )
+			appFprintf( F, "\t\"%s\": {\"min\": %.4f, \"avg\": %.4f, \"p99\": %.4f, \"max\": %.4f},\n", StatNames[i], Stats[i].Min, Stats[i].Avg, Stats[i].P99, Stats[i].Max );
+		appFprintf( F, "\t\"frametimes\": [" );
+		for( INT i=0; i<Frames.Num(); i++ )
+			appFprintf( F, "%s\n\t\t[%.4f, %.4f, %.4f, %.4f]", i ? "," : "", Frames(i).Total, Frames(i).Game, Frames(i).Render, Frames(i).Script );
+		appFprintf( F, "\n\t]\n}\n" );
+		appFclose( F );
+		debugf( NAME_Log, "Timedemo results written to %s", OutFile );
+	}
+	else debugf( NAME_Warning, "Couldn't write timedemo results to %s", OutFile );
+
+	appRequestExit();
+	unguard;
+}
+
+//
+// Benchmark level collision queries on the loaded map and exit, instead of
+// the interactive main loop.  Runs the level's CHECKBENCH command after
+// letting the level settle for a few ticks.  Use with -HEADLESS, e.g. on
+// build machines.
+//
+// Options: COUNT= queries per case, LENGTH= maximum trace length, SEED=
+// random seed, WARMUP= ticks before measuring, BENCHOUT= JSON result file.
+//
+void CheckBenchLoop( UEngine* Engine )
+{
+	guard(CheckBenchLoop);
+
+	INT   Count     = 20000;
+	INT   NumWarmup = 10;
+	FLOAT Length    = 2048.f;
+	DWORD Seed      = 1;
+	char  OutFile[256]="CheckBench.json";
+	Parse( appCmdLine(), "COUNT=",    Count     );
+	Parse( appCmdLine(), "WARMUP=",   NumWarmup );
+	Parse( appCmdLine(), "LENGTH=",   Length    );
+	Parse( appCmdLine(), "SEED=",     Seed      );
+	Parse( appCmdLine(), "BENCHOUT=", OutFile, ARRAY_COUNT(OutFile) );
+
+	UGameEngine* GameEngine = Cast<UGameEngine>( Engine );
+	if( !GameEngine || !GameEngine->GLevel )
+		appErrorf( "Collision benchmark requires a game engine with a level" );
+	ULevel* Level = GameEngine->GLevel;
+
+	// Let actors settle.
+	GIsRunning = 1;
+	for( INT i=0; i<NumWarmup && !GIsRequestingExit; i++ )
+		Engine->Tick( 1.f/30.f );
+	GIsRunning = 0;
+
+	// Run it.
+	char Cmd[512];
+	appSprintf( Cmd, "CHECKBENCH COUNT=%i LENGTH=%f SEED=%u FILE=%s", Count, Length, Seed, OutFile );
+	Level->Exec( Cmd, GSystem );
+	printf( "CHECKBENCH map=%s count=%i seed=%u results=%s\n", *Level->URL.Map, Count, Seed, OutFile );
+	fflush( stdout );
+
+	appRequestExit();
+	unguard;
+}
+
 //
 // Exit the engine.
 //
@@ -283,8 +768,21 @@ int main( int argc, const char** argv )
 		GIsGuarded=1;
 		GSystem = &GTempPlatform;
 		UEngine* Engine = InitEngine();
+		GLaunchEngine = Engine;
 		if( !GIsRequestingExit )
-			MainLoop( Engine );
+		{
+			INT TickRate = Engine->GetMaxTickRate();
+			Parse( appCmdLine(), "TICKRATE=", TickRate );
+			if( ParseParam(appCmdLine(),"TIMEDEMO") )
+				TimeDemoLoop( Engine );
+			else if( ParseParam(appCmdLine(),"CHECKBENCH") )
+				CheckBenchLoop( Engine );
+			else if( !GIsClient && ParseParam(appCmdLine(),"FIXEDSTEP") )
+				FixedStepLoop( Engine, TickRate>0 ? TickRate : 20 );
+			else
+				MainLoop( Engine );
+		}
+		GLaunchEngine = NULL;
 		ExitEngine( Engine );
 		GIsGuarded=0;
 #ifndef _DEBUG